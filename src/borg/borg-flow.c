@@ -54,6 +54,74 @@ int16_t borg_flow_n = 0;
 uint8_t borg_flow_x[AUTO_FLOW_MAX];
 uint8_t borg_flow_y[AUTO_FLOW_MAX];
 
+/*
+ * Flow field cache
+ *
+ * Most "flows" are rebuilt every borg turn from the same goal grids over a
+ * map which has barely changed, so the results of borg_flow_spread() are
+ * remembered, keyed on the goal set and on everything besides the map that
+ * decides whether a grid may be entered.  The map itself (including the
+ * "know" and "icky" danger flags) is summarised in a signature plane which
+ * is compared before every lookup; a changed grid only discards the cached
+ * fields which actually looked at it, so a monster wandering about on the
+ * far side of the level does not force every flow to be recomputed.
+ */
+#define BORG_FLOW_CACHE_MAX 8
+#define BORG_FLOW_DIRTY_MAX 256
+
+/*
+ * Why a spread stopped
+ */
+enum borg_flow_stop {
+    BORG_FLOW_STOP_EMPTY = 0, /* Ran out of grids */
+    BORG_FLOW_STOP_DEPTH, /* Reached the depth limit */
+    BORG_FLOW_STOP_ORIGIN /* Reached the origin (optimize) */
+};
+
+/*
+ * Everything apart from the map which can change the result of a spread.
+ * Always memset() before filling so that it can be compared with memcmp().
+ */
+struct borg_flow_key {
+    int      depth;
+    bool     optimize;
+    bool     avoid;
+    bool     tunneling;
+    bool     sneak;
+    uint32_t goal_hash;
+    int      goal_num;
+    bool     desperate;
+    bool     twitchy;
+    bool     no_kill; /* desperate, lunal or munchkin */
+    bool     afraid;
+    bool     weak; /* low level and fed */
+    bool     ifire;
+    bool     trap_shy; /* too weak or clumsy for traps */
+    int      shop;
+    struct loc shop_pos;
+};
+
+struct borg_flow_cache_entry {
+    bool                 valid;
+    struct borg_flow_key key;
+    enum borg_flow_stop  stop;
+    uint32_t             stamp; /* For replacement */
+    borg_data           *cost;
+};
+
+static struct borg_flow_cache_entry borg_flow_cache[BORG_FLOW_CACHE_MAX];
+static uint32_t  borg_flow_cache_stamp = 0;
+static uint32_t *borg_flow_sig = NULL;
+static uint32_t  flow_goal_hash = 0;
+static int       flow_goal_num = 0;
+static bool      flow_goal_fresh = false;
+
+/*
+ * Cache statistics
+ */
+int32_t borg_flow_cache_hits = 0;
+int32_t borg_flow_cache_misses = 0;
+
 /*
  * Some variables
  */
@@ -189,6 +257,226 @@ void borg_flow_clear(void)
     /* Start over */
     flow_head = 0;
     flow_tail = 0;
+
+    /* Forget the goals */
+    flow_goal_hash = 0;
+    flow_goal_num = 0;
+    flow_goal_fresh = true;
+}
+
+/*
+ * Summarise everything about a grid that a spread may look at
+ */
+static uint32_t borg_flow_grid_sig(int y, int x)
+{
+    borg_grid *ag = &borg_grids[y][x];
+
+    return (uint32_t)ag->feat | ((uint32_t)ag->store << 8)
+        | (ag->trap ? 0x10000 : 0) | (ag->glyph ? 0x20000 : 0)
+        | (ag->kill ? 0x40000 : 0)
+        | (borg_data_know->data[y][x] ? 0x80000 : 0)
+        | (borg_data_icky->data[y][x] ? 0x100000 : 0);
+}
+
+/*
+ * Check whether a cached spread could have looked at a grid.  Only grids
+ * next to a reached grid are ever examined (two away when sneaking, since
+ * then the monsters next to each candidate grid matter too).
+ */
+static bool borg_flow_cache_touches(
+    const struct borg_flow_cache_entry *entry, int y, int x)
+{
+    int r = entry->key.sneak ? 2 : 1;
+    int yy, xx;
+
+    for (yy = y - r; yy <= y + r; yy++) {
+        if (yy < 0 || yy >= AUTO_MAX_Y)
+            continue;
+        for (xx = x - r; xx <= x + r; xx++) {
+            if (xx < 0 || xx >= AUTO_MAX_X)
+                continue;
+            if (entry->cost->data[yy][xx] != 255)
+                return true;
+        }
+    }
+
+    return false;
+}
+
+/*
+ * Bring the map signature up to date, discarding any cached spread which
+ * depended on a grid that has changed since it was computed.
+ */
+static void borg_flow_cache_sync(void)
+{
+    int      dirty_y[BORG_FLOW_DIRTY_MAX];
+    int      dirty_x[BORG_FLOW_DIRTY_MAX];
+    int      dirty_n = 0;
+    bool     overflow = false;
+    int      i, j, x, y;
+
+    for (y = 0; y < AUTO_MAX_Y; y++) {
+        for (x = 0; x < AUTO_MAX_X; x++) {
+            uint32_t sig = borg_flow_grid_sig(y, x);
+            uint32_t *old = &borg_flow_sig[y * AUTO_MAX_X + x];
+
+            if (*old == sig)
+                continue;
+            *old = sig;
+
+            if (dirty_n < BORG_FLOW_DIRTY_MAX) {
+                dirty_y[dirty_n] = y;
+                dirty_x[dirty_n] = x;
+                dirty_n++;
+            } else {
+                overflow = true;
+            }
+        }
+    }
+
+    if (!dirty_n)
+        return;
+
+    for (i = 0; i < BORG_FLOW_CACHE_MAX; i++) {
+        struct borg_flow_cache_entry *entry = &borg_flow_cache[i];
+
+        if (!entry->valid)
+            continue;
+
+        /* Too much has changed to bother checking */
+        if (overflow) {
+            entry->valid = false;
+            continue;
+        }
+
+        for (j = 0; j < dirty_n; j++) {
+            if (borg_flow_cache_touches(entry, dirty_y[j], dirty_x[j])) {
+                entry->valid = false;
+                break;
+            }
+        }
+    }
+}
+
+/*
+ * Fill in the cache key for the spread about to be done
+ */
+static void borg_flow_cache_key(struct borg_flow_key *key, int depth,
+    bool optimize, bool avoid, bool tunneling, bool sneak, bool twitchy)
+{
+    memset(key, 0, sizeof(*key));
+
+    key->depth     = depth;
+    key->optimize  = optimize;
+    key->avoid     = avoid;
+    key->tunneling = tunneling;
+    key->sneak     = sneak;
+    key->goal_hash = flow_goal_hash;
+    key->goal_num  = flow_goal_num;
+    key->desperate = borg_desperate;
+    key->twitchy   = twitchy;
+    key->no_kill = borg_desperate || borg.lunal_mode || borg.munchkin_mode;
+    key->afraid    = borg.trait[BI_ISAFRAID] ? true : false;
+    key->weak = borg.trait[BI_FOOD] >= 2 && borg.trait[BI_MAXCLEVEL] < 5;
+    key->ifire     = borg.trait[BI_IFIRE] ? true : false;
+    key->trap_shy  = borg.trait[BI_CURHP] < 60
+        || (borg.trait[BI_DISP] < 30 && borg.trait[BI_CLEVEL] < 20)
+        || (borg.trait[BI_DISP] < 45 && borg.trait[BI_CLEVEL] < 10)
+        || (borg.trait[BI_DISM] < 30 && borg.trait[BI_CLEVEL] < 20)
+        || (borg.trait[BI_DISM] < 45 && borg.trait[BI_CLEVEL] < 10);
+    key->shop      = borg.goal.shop;
+    key->shop_pos  = (borg.goal.shop >= 0) ? borg.c : loc(-1, -1);
+}
+
+/*
+ * Try to answer a spread from the cache.
+ *
+ * A spread which was stopped early by "optimize" holds every grid up to the
+ * cost of the old origin, so it also answers for any origin it reached at
+ * no greater cost, once the grids beyond that cost are forgotten.
+ */
+static bool borg_flow_cache_find(
+    const struct borg_flow_key *key, int origin_y, int origin_x)
+{
+    int  i, x, y;
+    int  limit = 255;
+
+    for (i = 0; i < BORG_FLOW_CACHE_MAX; i++) {
+        struct borg_flow_cache_entry *entry = &borg_flow_cache[i];
+
+        if (!entry->valid || memcmp(&entry->key, key, sizeof(*key)))
+            continue;
+
+        if (key->optimize) {
+            int c = entry->cost->data[origin_y][origin_x];
+
+            /* The old spread stopped before it could reach us */
+            if (c == 255 && entry->stop == BORG_FLOW_STOP_ORIGIN)
+                return false;
+
+            if (c != 255)
+                limit = c;
+        }
+
+        /* Use it */
+        memcpy(borg_data_cost, entry->cost, sizeof(borg_data));
+        if (limit < 255) {
+            for (y = 0; y < AUTO_MAX_Y; y++) {
+                for (x = 0; x < AUTO_MAX_X; x++) {
+                    if (borg_data_cost->data[y][x] > limit)
+                        borg_data_cost->data[y][x] = 255;
+                }
+            }
+        }
+        entry->stamp = ++borg_flow_cache_stamp;
+        return true;
+    }
+
+    return false;
+}
+
+/*
+ * Remember the result of a spread
+ */
+static void borg_flow_cache_store(
+    const struct borg_flow_key *key, enum borg_flow_stop stop)
+{
+    struct borg_flow_cache_entry *entry = &borg_flow_cache[0];
+    int                           i;
+
+    /* Replace an invalid or the least recently used entry */
+    for (i = 0; i < BORG_FLOW_CACHE_MAX; i++) {
+        if (!borg_flow_cache[i].valid) {
+            entry = &borg_flow_cache[i];
+            break;
+        }
+        if (borg_flow_cache[i].stamp < entry->stamp)
+            entry = &borg_flow_cache[i];
+    }
+
+    entry->valid = true;
+    entry->key   = *key;
+    entry->stop  = stop;
+    entry->stamp = ++borg_flow_cache_stamp;
+    memcpy(entry->cost, borg_data_cost, sizeof(borg_data));
+}
+
+/*
+ * Forget every cached spread
+ */
+void borg_flow_cache_wipe(void)
+{
+    int i;
+
+    for (i = 0; i < BORG_FLOW_CACHE_MAX; i++)
+        borg_flow_cache[i].valid = false;
+
+    /* Report on the last level */
+    if (borg_flow_cache_hits || borg_flow_cache_misses)
+        borg_note(format("# Flow cache: %d hits, %d misses",
+            borg_flow_cache_hits, borg_flow_cache_misses));
+    borg_flow_cache_hits = 0;
+    borg_flow_cache_misses = 0;
 }
 
 /*
@@ -258,8 +546,9 @@ void borg_flow_clear(void)
  * "Sneak" will have the borg avoid grids which are adjacent to a monster.
  *
  */
-void borg_flow_spread(int depth, bool optimize, bool avoid, bool tunneling,
-    int stair_idx, bool sneak)
+static enum borg_flow_stop borg_flow_spread_aux(int depth, bool optimize,
+    bool avoid, bool tunneling, bool sneak, bool twitchy, int origin_y,
+    int origin_x, bool *overflow)
 {
     int  i;
     int  n, o = 0;
@@ -269,24 +558,7 @@ void borg_flow_spread(int depth, bool optimize, bool avoid, bool tunneling,
     int  ii;
     int  yy, xx;
     bool bad_sneak = false;
-    int  origin_y, origin_x;
-    bool twitchy = false;
-
-    /* Default starting points */
-    origin_y = borg.c.y;
-    origin_x = borg.c.x;
-
-    /* Is the borg moving under boosted bravery? */
-    if (avoidance > borg.trait[BI_CURHP])
-        twitchy = true;
-
-    /* Use the closest stair for calculation distance (cost) from the stair to
-     * the goal */
-    if (stair_idx >= 0 && borg.trait[BI_CLEVEL] < 15) {
-        origin_y = track_less.y[stair_idx];
-        origin_x = track_less.x[stair_idx];
-        optimize = false;
-    }
+    enum borg_flow_stop stop = BORG_FLOW_STOP_EMPTY;
 
     /* Now process the queue */
     while (flow_head != flow_tail) {
@@ -304,12 +576,16 @@ void borg_flow_spread(int depth, bool optimize, bool avoid, bool tunneling,
         /* New depth */
         if (n > o) {
             /* Optimize (if requested) */
-            if (optimize && (n > borg_data_cost->data[origin_y][origin_x]))
+            if (optimize && (n > borg_data_cost->data[origin_y][origin_x])) {
+                stop = BORG_FLOW_STOP_ORIGIN;
                 break;
+            }
 
             /* Limit depth */
-            if (n > depth)
+            if (n > depth) {
+                stop = BORG_FLOW_STOP_DEPTH;
                 break;
+            }
 
             /* Save */
             o = n;
@@ -497,13 +773,78 @@ void borg_flow_spread(int depth, bool optimize, bool avoid, bool tunneling,
                 flow_head = 0;
 
             /* Circular queue -- handle overflow (badly) */
-            if (flow_head == flow_tail)
+            if (flow_head == flow_tail) {
                 flow_head = old_head;
+                *overflow = true;
+            }
         }
     }
 
+    return stop;
+}
+
+/*
+ * Spread a "flow" from the "destination" grids outwards, reusing an earlier
+ * spread from the same goals when nothing it depended on has changed.
+ */
+void borg_flow_spread(int depth, bool optimize, bool avoid, bool tunneling,
+    int stair_idx, bool sneak)
+{
+    int  origin_y, origin_x;
+    bool twitchy = false;
+    bool overflow = false;
+    struct borg_flow_key key;
+    enum borg_flow_stop stop;
+
+    /* Default starting points */
+    origin_y = borg.c.y;
+    origin_x = borg.c.x;
+
+    /* Is the borg moving under boosted bravery? */
+    if (avoidance > borg.trait[BI_CURHP])
+        twitchy = true;
+
+    /* Use the closest stair for calculation distance (cost) from the stair to
+     * the goal */
+    if (stair_idx >= 0 && borg.trait[BI_CLEVEL] < 15) {
+        origin_y = track_less.y[stair_idx];
+        origin_x = track_less.x[stair_idx];
+        optimize = false;
+    }
+
+    /* Only a spread straight from a clear and its goals can be cached */
+    if (!flow_goal_fresh) {
+        borg_flow_spread_aux(depth, optimize, avoid, tunneling, sneak,
+            twitchy, origin_y, origin_x, &overflow);
+        flow_head = flow_tail = 0;
+        return;
+    }
+    flow_goal_fresh = false;
+
+    /* Check the cache */
+    borg_flow_cache_sync();
+    borg_flow_cache_key(&key, depth, optimize, avoid, tunneling, sneak,
+        twitchy);
+    if (borg_flow_cache_find(&key, origin_y, origin_x)) {
+        borg_flow_cache_hits++;
+        flow_head = flow_tail = 0;
+        return;
+    }
+    borg_flow_cache_misses++;
+
+    /* Do it the hard way */
+    stop = borg_flow_spread_aux(depth, optimize, avoid, tunneling, sneak,
+        twitchy, origin_y, origin_x, &overflow);
+
     /* Forget the flow info */
     flow_head = flow_tail = 0;
+
+    /* Note the "know" and "icky" flags the spread set, then remember it.
+     * A spread which lost grids to queue overflow depends on queue order,
+     * so it is not kept. */
+    borg_flow_cache_sync();
+    if (!overflow)
+        borg_flow_cache_store(&key, stop);
 }
 
 /*
@@ -569,6 +910,10 @@ void borg_flow_enqueue_grid(int y, int x)
     /* Save the flow cost (zero) */
     borg_data_cost->data[y][x] = 0;
 
+    /* Note the goal for the flow cache */
+    flow_goal_hash = flow_goal_hash * 31 + (uint32_t)(y * AUTO_MAX_X + x);
+    flow_goal_num++;
+
     /* Enqueue that entry */
     borg_flow_y[flow_head] = y;
     borg_flow_x[flow_head] = x;
@@ -1234,7 +1579,7 @@ void borg_free_track(struct borg_track *track)
 
 void borg_init_flow(void)
 {
-    int x, y;
+    int i, x, y;
 
     /*** Grid data ***/
 
@@ -1261,6 +1606,13 @@ void borg_init_flow(void)
         }
     }
 
+    /* Flow cache */
+    for (i = 0; i < BORG_FLOW_CACHE_MAX; i++) {
+        borg_flow_cache[i].valid = false;
+        borg_flow_cache[i].cost = mem_zalloc(sizeof(borg_data));
+    }
+    borg_flow_sig = mem_zalloc(AUTO_MAX_Y * AUTO_MAX_X * sizeof(uint32_t));
+
     /* Track Steps */
     borg_init_track(&track_step, 100);
 
@@ -1277,6 +1629,8 @@ void borg_init_flow(void)
 
 void borg_free_flow(void)
 {
+    int i;
+
     borg_free_flow_misc();
     borg_free_flow_glyph();
     borg_free_flow_stairs();
@@ -1285,6 +1639,14 @@ void borg_free_flow(void)
     borg_free_track(&track_door);
     borg_free_track(&track_step);
 
+    mem_free(borg_flow_sig);
+    borg_flow_sig = NULL;
+    for (i = 0; i < BORG_FLOW_CACHE_MAX; i++) {
+        borg_flow_cache[i].valid = false;
+        mem_free(borg_flow_cache[i].cost);
+        borg_flow_cache[i].cost = NULL;
+    }
+
     mem_free(borg_data_icky);
     borg_data_icky = NULL;
     mem_free(borg_data_know);
@@ -146,6 +146,17 @@ extern bool borg_can_dig(bool check_fail, uint8_t feat);
  */
 extern void borg_flow_clear(void);
 
+/*
+ * Flow cache statistics
+ */
+extern int32_t borg_flow_cache_hits;
+extern int32_t borg_flow_cache_misses;
+
+/*
+ * Forget every cached "flow"
+ */
+extern void borg_flow_cache_wipe(void);
+
 /*
  * Spread a "flow" from the "destination" grids outwards
  */
@@ -161,6 +161,9 @@ static void borg_forget_map(void)
     /* Clear "borg_data_icky" */
     memset(borg_data_icky, 0, sizeof(borg_data));
 
+    /* Forget any cached flows */
+    borg_flow_cache_wipe();
+
     /* Forget the view */
     borg_forget_view();
 }
@@ -653,6 +653,7 @@ void cave_known(struct player *p)
 			/* Internal walls not known */
 			if (count < 8) {
 				p->cave->squares[y][x].feat = square(cave, grid)->feat;
+				p->cave->caps[y][x] = cave->caps[y][x];
 			}
 		}
 	}
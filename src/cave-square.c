@@ -190,6 +190,26 @@ bool feat_is_smooth(int feat)
 	return tf_has(f_info[feat].flags, TF_SMOOTH);
 }
 
+/**
+ * Work out the FEAT_CAP_ bits of a feature from its terrain flags.
+ *
+ * This is done once, when terrain.txt has been read; after that the bits are
+ * available as f_info[feat].caps, and for every grid of a chunk as c->caps.
+ */
+uint8_t feat_caps(int feat)
+{
+	uint8_t caps = 0;
+
+	if (feat_is_passable(feat)) caps |= FEAT_CAP_PASSABLE;
+	if (feat_is_projectable(feat)) caps |= FEAT_CAP_PROJECT;
+	if (feat_is_los(feat)) caps |= FEAT_CAP_LOS;
+	if (feat_is_no_flow(feat)) caps |= FEAT_CAP_NO_FLOW;
+	if (feat_is_no_scent(feat)) caps |= FEAT_CAP_NO_SCENT;
+	if (feat_is_bright(feat)) caps |= FEAT_CAP_BRIGHT;
+	if (feat_is_fiery(feat)) caps |= FEAT_CAP_FIERY;
+	return caps;
+}
+
 /**
  * SQUARE FEATURE PREDICATES
  *
@@ -206,6 +226,18 @@ bool feat_is_smooth(int feat)
  * Use functions like square_isdiggable, square_allowslos, etc. in these cases.
  */
 
+/**
+ * Test FEAT_CAP_ bits of a square.  The most used predicates are written in
+ * terms of this, so they need only the one load from the chunk's caps plane.
+ */
+static bool square_hascap(struct chunk *c, struct loc grid, uint8_t cap)
+{
+	assert(square_in_bounds(c, grid));
+	assert(c->caps[grid.y][grid.x]
+		== f_info[c->squares[grid.y][grid.x].feat].caps);
+	return (c->caps[grid.y][grid.x] & cap) != 0;
+}
+
 /**
  * True if the square is normal open floor.
  */
@@ -654,16 +686,14 @@ bool square_iswebbable(struct chunk *c, struct loc grid) {
  */
 bool square_is_monster_walkable(struct chunk *c, struct loc grid)
 {
-	assert(square_in_bounds(c, grid));
-	return feat_is_monster_walkable(square(c, grid)->feat);
+	return square_hascap(c, grid, FEAT_CAP_PASSABLE);
 }
 
 /**
  * True if the square is passable by the player.
  */
 bool square_ispassable(struct chunk *c, struct loc grid) {
-	assert(square_in_bounds(c, grid));
-	return feat_is_passable(square(c, grid)->feat);
+	return square_hascap(c, grid, FEAT_CAP_PASSABLE);
 }
 
 /**
@@ -671,7 +701,7 @@ bool square_ispassable(struct chunk *c, struct loc grid) {
  */
 bool square_isprojectable(struct chunk *c, struct loc grid) {
 	if (!square_in_bounds(c, grid)) return false;
-	return feat_is_projectable(square(c, grid)->feat);
+	return square_hascap(c, grid, FEAT_CAP_PROJECT);
 }
 
 /**
@@ -685,8 +715,7 @@ bool square_allowsfeel(struct chunk *c, struct loc grid) {
  * True if the square allows line-of-sight.
  */
 bool square_allowslos(struct chunk *c, struct loc grid) {
-	assert(square_in_bounds(c, grid));
-	return feat_is_los(square(c, grid)->feat);
+	return square_hascap(c, grid, FEAT_CAP_LOS);
 }
 
 /**
@@ -704,16 +733,14 @@ bool square_isstrongwall(struct chunk *c, struct loc grid) {
  * True if the cave square is internally lit.
  */
 bool square_isbright(struct chunk *c, struct loc grid) {
-	assert(square_in_bounds(c, grid));
-	return feat_is_bright(square(c, grid)->feat);
+	return square_hascap(c, grid, FEAT_CAP_BRIGHT);
 }
 
 /**
  * True if the cave square is fire-based.
  */
 bool square_isfiery(struct chunk *c, struct loc grid) {
-	assert(square_in_bounds(c, grid));
-	return feat_is_fiery(square(c, grid)->feat);
+	return square_hascap(c, grid, FEAT_CAP_FIERY);
 }
 
 /**
@@ -728,24 +755,21 @@ bool square_islit(struct chunk *c, struct loc grid) {
  * True if the cave square can damage the inhabitant - only lava so far
  */
 bool square_isdamaging(struct chunk *c, struct loc grid) {
-	assert(square_in_bounds(c, grid));
-	return feat_is_fiery(square(c, grid)->feat);
+	return square_hascap(c, grid, FEAT_CAP_FIERY);
 }
 
 /**
  * True if the cave square doesn't allow monster flow information.
  */
 bool square_isnoflow(struct chunk *c, struct loc grid) {
-	assert(square_in_bounds(c, grid));
-	return feat_is_no_flow(square(c, grid)->feat);
+	return square_hascap(c, grid, FEAT_CAP_NO_FLOW);
 }
 
 /**
  * True if the cave square doesn't carry player scent.
  */
 bool square_isnoscent(struct chunk *c, struct loc grid) {
-	assert(square_in_bounds(c, grid));
-	return feat_is_no_scent(square(c, grid)->feat);
+	return square_hascap(c, grid, FEAT_CAP_NO_SCENT);
 }
 
 bool square_iswarded(struct chunk *c, struct loc grid)
@@ -1246,6 +1270,8 @@ void square_set_feat(struct chunk *c, struct loc grid, int feat)
 
 	/* Make the change */
 	c->squares[grid.y][grid.x].feat = feat;
+	c->caps[grid.y][grid.x] = f_info[feat].caps;
+	cave_note_terrain_change(c);
 
 	/* Light bright terrain */
 	if (feat_is_bright(feat)) {
@@ -1275,6 +1301,7 @@ static void square_set_known_feat(struct chunk *c, struct loc grid, int feat)
 {
 	if (c != cave) return;
 	player->cave->squares[grid.y][grid.x].feat = feat;
+	player->cave->caps[grid.y][grid.x] = f_info[feat].caps;
 }
 
 /**
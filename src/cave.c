@@ -22,6 +22,7 @@
 #include "cmd-core.h"
 #include "game-event.h"
 #include "game-world.h"
+#include "generate.h"
 #include "init.h"
 #include "mon-group.h"
 #include "monster.h"
@@ -338,6 +339,29 @@ const char *get_feat_code_name(int idx)
 	return (idx < 0 || idx >= FEAT_MAX) ? NULL : feat_code_list[idx];
 }
 
+/**
+ * Give a chunk a new terrain stamp.  Stamps come from one sequence for all
+ * chunks, so no two chunks, or two states of the same chunk, share one and
+ * anything remembered about a chunk's terrain can be checked against it.
+ */
+void cave_note_terrain_change(struct chunk *c)
+{
+	static uint32_t terrain_stamps;
+
+	c->terrain_stamp = ++terrain_stamps;
+}
+
+/**
+ * Running total of the grids in chunks made by cave_new(), so level
+ * generation can report what each attempt cost
+ */
+static long grids_allocated;
+
+long cave_grids_allocated(void)
+{
+	return grids_allocated;
+}
+
 /**
  * Allocate a new chunk of the world
  */
@@ -345,11 +369,13 @@ struct chunk *cave_new(int height, int width) {
 	int y, x;
 
 	struct chunk *c = mem_zalloc(sizeof *c);
+	grids_allocated += (long) height * width;
 	c->height = height;
 	c->width = width;
 	c->feat_count = mem_zalloc((FEAT_MAX + 1) * sizeof(int));
 
 	c->squares = mem_zalloc(c->height * sizeof(struct square*));
+	c->caps = mem_zalloc(c->height * sizeof(uint8_t*));
 	c->noise.grids = mem_zalloc(c->height * sizeof(uint16_t*));
 	c->scent.grids = mem_zalloc(c->height * sizeof(uint16_t*));
 	for (y = 0; y < c->height; y++) {
@@ -357,6 +383,8 @@ struct chunk *cave_new(int height, int width) {
 		for (x = 0; x < c->width; x++) {
 			c->squares[y][x].info = mem_zalloc(SQUARE_SIZE * sizeof(bitflag));
 		}
+		c->caps[y] = mem_zalloc(c->width * sizeof(uint8_t));
+		if (f_info) memset(c->caps[y], f_info[FEAT_NONE].caps, c->width);
 		c->noise.grids[y] = mem_zalloc(c->width * sizeof(uint16_t));
 		c->scent.grids[y] = mem_zalloc(c->width * sizeof(uint16_t));
 	}
@@ -372,6 +400,7 @@ struct chunk *cave_new(int height, int width) {
 								   sizeof(struct monster_group*));
 
 	c->turn = turn;
+	cave_note_terrain_change(c);
 	return c;
 }
 
@@ -396,6 +425,10 @@ void cave_free(struct chunk *c) {
 	struct chunk *p_c = (c == cave && player) ? player->cave : NULL;
 	int y, x, i;
 
+	/* Stored chunks may be compressed */
+	chunk_unpack(c);
+	mem_free(c->save_image);
+
 	cave_connectors_free(c->join);
 
 	/* Look for orphaned objects and delete them. */
@@ -414,10 +447,12 @@ void cave_free(struct chunk *c) {
 				object_pile_free(c, p_c, c->squares[y][x].obj);
 		}
 		mem_free(c->squares[y]);
+		mem_free(c->caps[y]);
 		mem_free(c->noise.grids[y]);
 		mem_free(c->scent.grids[y]);
 	}
 	mem_free(c->squares);
+	mem_free(c->caps);
 	mem_free(c->noise.grids);
 	mem_free(c->scent.grids);
 
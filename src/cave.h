@@ -100,6 +100,20 @@ enum
 
 #define tf_has(f, flag)        flag_has_dbg(f, TF_SIZE, flag, #f, #flag)
 
+/**
+ * Terrain flags tested often enough to be worth keeping, packed, for every
+ * grid of a chunk; see feat_caps()
+ */
+enum {
+	FEAT_CAP_PASSABLE = 0x01,
+	FEAT_CAP_PROJECT = 0x02,
+	FEAT_CAP_LOS = 0x04,
+	FEAT_CAP_NO_FLOW = 0x08,
+	FEAT_CAP_NO_SCENT = 0x10,
+	FEAT_CAP_BRIGHT = 0x20,
+	FEAT_CAP_FIERY = 0x40
+};
+
 /**
  * Information about terrain features.
  *
@@ -118,6 +132,7 @@ struct feature {
 	uint8_t dig;		/**< How hard is it to dig through? */
 
 	bitflag flags[TF_SIZE];	/**< Terrain flags */
+	uint8_t caps;		/**< FEAT_CAP_ bits matching the flags */
 
 	uint8_t d_attr;	/**< Default feature attribute */
 	wchar_t d_char;	/**< Default feature character */
@@ -195,6 +210,8 @@ struct chunk {
 	int *feat_count;
 
 	struct square **squares;
+	uint8_t **caps;		/* f_info[feat].caps for each square */
+	uint32_t terrain_stamp;	/* New value whenever any terrain changes */
 	struct heatmap noise;
 	struct heatmap scent;
 	struct loc decoy;
@@ -211,6 +228,13 @@ struct chunk {
 	struct monster_group **monster_groups;
 
 	struct connector *join;
+
+	/* Compressed grids of a stored chunk; squares is NULL while set */
+	struct chunk_pack *packed;
+
+	/* Savefile record of a packed chunk, kept so it is only written once */
+	uint8_t *save_image;
+	uint32_t save_image_len;
 };
 
 /*** Feature Indexes (see "lib/gamedata/terrain.txt") ***/
@@ -272,6 +296,7 @@ bool feat_is_fiery(int feat);
 bool feat_is_no_flow(int feat);
 bool feat_is_no_scent(int feat);
 bool feat_is_smooth(int feat);
+uint8_t feat_caps(int feat);
 
 /* SQUARE FEATURE PREDICATES */
 bool square_isfloor(struct chunk *c, struct loc grid);
@@ -430,6 +455,8 @@ struct loc next_grid(struct loc grid, int dir);
 int lookup_feat(const char *name);
 int lookup_feat_code(const char *code);
 const char *get_feat_code_name(int idx);
+void cave_note_terrain_change(struct chunk *c);
+long cave_grids_allocated(void);
 struct chunk *cave_new(int height, int width);
 void cave_connectors_free(struct connector *join);
 void cave_free(struct chunk *c);
@@ -7,6 +7,13 @@ macro(configure_x11_frontend _NAME_TARGET)
         target_compile_definitions(${_NAME_TARGET} PRIVATE -D USE_X11)
         message(STATUS "Support for X11 front end - Ready")
 
+        if(X11_Xrender_FOUND)
+            target_link_libraries(${_NAME_TARGET} PRIVATE ${X11_Xrender_LIB})
+            target_include_directories(${_NAME_TARGET} PRIVATE ${X11_Xrender_INCLUDE_PATH})
+            target_compile_definitions(${_NAME_TARGET} PRIVATE -D USE_XRENDER)
+            message(STATUS "Support for XRender in the X11 front end - Ready")
+        endif()
+
     else()
         message(FATAL_ERROR "Support for X11 front end - Failed")
 
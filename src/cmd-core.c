@@ -144,6 +144,7 @@ static const struct command_info game_cmds[] =
 	{ CMD_WIZ_DETECT_ALL_LOCAL, "detect everything nearby", do_cmd_wiz_detect_all_local, false, false, 0 },
 	{ CMD_WIZ_DETECT_ALL_MONSTERS, "detect all monsters", do_cmd_wiz_detect_all_monsters, false, false, 0 },
 	{ CMD_WIZ_DISPLAY_KEYLOG, "display keystroke log", do_cmd_wiz_display_keylog, false, false, 0 },
+	{ CMD_WIZ_DISPLAY_NAME_CACHES, "display name cache counts", do_cmd_wiz_display_name_caches, false, false, 0 },
 	{ CMD_WIZ_DUMP_LEVEL_MAP, "write map of level", do_cmd_wiz_dump_level_map, false, false, 0 },
 	{ CMD_WIZ_EDIT_PLAYER_EXP, "change the player's experience", do_cmd_wiz_edit_player_exp, false, false, 0 },
 	{ CMD_WIZ_EDIT_PLAYER_GOLD, "change the player's gold", do_cmd_wiz_edit_player_gold, false, false, 0 },
@@ -355,6 +356,9 @@ static void process_command(cmd_context ctx, struct command *cmd)
 
 	cmd->context = ctx;
 
+	/* Anything may change under a command, so describe objects afresh */
+	object_desc_forget();
+
 	/* Actually execute the command function */
 	if (game_cmds[idx].fn) {
 		/* Occasional attack instead for bloodlust-affected characters */
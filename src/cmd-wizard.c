@@ -23,6 +23,7 @@
 #include "game-input.h"
 #include "generate.h"
 #include "init.h"
+#include "mon-desc.h"
 #include "mon-lore.h"
 #include "mon-make.h"
 #include "mon-util.h"
@@ -43,6 +44,7 @@
 #include "trap.h"
 #include "ui-input.h"
 #include "ui-map.h"
+#include "ui-mon-lore.h"
 #include "ui-output.h"
 #include "ui-target.h"
 #include "wizard.h"
@@ -1147,6 +1149,39 @@ void do_cmd_wiz_display_keylog(struct command *cmd)
 }
 
 
+/**
+ * Display how often object and monster names and monster recalls have been
+ * found remembered (CMD_WIZ_DISPLAY_NAME_CACHES).  Takes no arguments from cmd.
+ */
+void do_cmd_wiz_display_name_caches(struct command *cmd)
+{
+	uint32_t hits, misses;
+
+	screen_save();
+
+	prt("Remembered names:", 0, 0);
+	object_desc_cache_counts(&hits, &misses);
+	prt(format("    objects   %10lu hits %10lu misses (%3lu%%)",
+		(unsigned long)hits, (unsigned long)misses,
+		(unsigned long)(hits + misses ?
+		(100.0 * hits) / (hits + misses) : 0)), 1, 0);
+	monster_desc_cache_counts(&hits, &misses);
+	prt(format("    monsters  %10lu hits %10lu misses (%3lu%%)",
+		(unsigned long)hits, (unsigned long)misses,
+		(unsigned long)(hits + misses ?
+		(100.0 * hits) / (hits + misses) : 0)), 2, 0);
+	lore_description_cache_counts(&hits, &misses);
+	prt(format("    recalls   %10lu hits %10lu misses (%3lu%%)",
+		(unsigned long)hits, (unsigned long)misses,
+		(unsigned long)(hits + misses ?
+		(100.0 * hits) / (hits + misses) : 0)), 3, 0);
+
+	prt("Press any key to continue.", 5, 0);
+	anykey();
+	screen_load();
+}
+
+
 /**
  * Dump a map of the current level as an HTML file (CMD_WIZ_DUMP_LEVEL_MAP).
  * Takes no arguments from cmd.
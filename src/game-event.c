@@ -23,99 +23,357 @@
 
 struct event_handler_entry
 {
-	struct event_handler_entry *next;	
 	game_event_handler *fn;
 	void *user;
 };
 
-static struct event_handler_entry *event_handlers[N_GAME_EVENTS];
+/**
+ * The handlers for one event type, kept in registration order in a flat
+ * array so that dispatch is a simple walk
+ */
+struct event_handler_list
+{
+	struct event_handler_entry *entries;
+	size_t count;
+	size_t alloc;
+};
 
-static void game_event_dispatch(game_event_type type, game_event_data *data)
+static struct event_handler_list event_handlers[N_GAME_EVENTS];
+
+/**
+ * A signal waiting in the deferred queue.  "live" is cleared when a later
+ * copy of the same signal moves it to the back of the queue.
+ */
+struct deferred_event
 {
-	struct event_handler_entry *this = event_handlers[type];
+	game_event_type type;
+	bool has_point;
+	struct loc point;
+	bool live;
+};
+
+static bool defer_events;
+static int dispatch_depth;
+static struct deferred_event *deferred;
+static size_t n_deferred, deferred_alloc;
+
+/* Open-addressed index from a signal to its slot (plus one) in the queue */
+static size_t *deferred_index;
+static size_t deferred_index_size;
+
+/* How many signals of each type were folded into one already queued */
+static uint32_t coalesced[N_GAME_EVENTS];
+
+static void game_event_call(game_event_type type, game_event_data *data)
+{
+	struct event_handler_list *list = &event_handlers[type];
+	size_t i;
 
 	/* 
-	 * Send the word out to all interested event handlers.
+	 * Send the word out to all interested event handlers, most recently
+	 * registered first.  Re-check the bound in case a handler removed
+	 * another.
 	 */
-	while (this)
-	{
+	dispatch_depth++;
+	for (i = list->count; i > 0; i--) {
+		struct event_handler_entry entry;
+
+		if (i > list->count) continue;
+		entry = list->entries[i - 1];
+
 		/* Call the handler with the relevant data */
-		this->fn(type, data, this->user);
-		this = this->next;
+		entry.fn(type, data, entry.user);
+	}
+	dispatch_depth--;
+}
+
+/**
+ * UI redraw events which only say "this has changed", so that several of
+ * them between two refreshes mean no more than one.  Each carries either
+ * no data or a grid.
+ */
+static bool event_is_deferrable(game_event_type type)
+{
+	switch (type) {
+		case EVENT_MAP:
+		case EVENT_STATS:
+		case EVENT_HP:
+		case EVENT_MANA:
+		case EVENT_AC:
+		case EVENT_EXPERIENCE:
+		case EVENT_PLAYERLEVEL:
+		case EVENT_PLAYERTITLE:
+		case EVENT_GOLD:
+		case EVENT_MONSTERHEALTH:
+		case EVENT_DUNGEONLEVEL:
+		case EVENT_PLAYERSPEED:
+		case EVENT_RACE_CLASS:
+		case EVENT_STUDYSTATUS:
+		case EVENT_STATUS:
+		case EVENT_DETECTIONSTATUS:
+		case EVENT_FEELING:
+		case EVENT_LIGHT:
+		case EVENT_STATE:
+		case EVENT_INVENTORY:
+		case EVENT_EQUIPMENT:
+		case EVENT_ITEMLIST:
+		case EVENT_MONSTERLIST:
+		case EVENT_MONSTERTARGET:
+		case EVENT_OBJECTTARGET:
+		case EVENT_END:
+			return true;
+		default:
+			return false;
+	}
+}
+
+/**
+ * Events before which everything deferred has to be on screen: refreshes,
+ * anything that waits for or discards input, animations, and changes of
+ * game context
+ */
+static bool event_is_refresh_point(game_event_type type)
+{
+	switch (type) {
+		case EVENT_REFRESH:
+		case EVENT_INPUT_FLUSH:
+		case EVENT_MESSAGE_FLUSH:
+		case EVENT_CHECK_INTERRUPT:
+		case EVENT_NEW_LEVEL_DISPLAY:
+		case EVENT_EXPLOSION:
+		case EVENT_BOLT:
+		case EVENT_MISSILE:
+		case EVENT_CHEAT_DEATH:
+			return true;
+		default:
+			return type >= EVENT_ENTER_INIT && type <= EVENT_LEAVE_DEATH;
+	}
+}
+
+static size_t deferred_hash(game_event_type type, bool has_point,
+		struct loc point)
+{
+	uint32_t h = (uint32_t) type * 2654435761u;
+
+	if (has_point) {
+		h ^= ((uint32_t) point.x * 40503u) + ((uint32_t) point.y << 16)
+			+ 1;
+		h *= 2246822519u;
 	}
+	return (h ^ (h >> 15)) & (deferred_index_size - 1);
+}
+
+static bool deferred_matches(const struct deferred_event *ev,
+		game_event_type type, bool has_point, struct loc point)
+{
+	return ev->type == type && ev->has_point == has_point
+		&& (!has_point || loc_eq(ev->point, point));
+}
+
+/**
+ * Find the index slot for a signal; it either holds that signal's queue
+ * position or is empty
+ */
+static size_t *deferred_lookup(game_event_type type, bool has_point,
+		struct loc point)
+{
+	size_t i = deferred_hash(type, has_point, point);
+
+	while (deferred_index[i]) {
+		const struct deferred_event *ev = &deferred[deferred_index[i] - 1];
+
+		if (deferred_matches(ev, type, has_point, point)) break;
+		i = (i + 1) & (deferred_index_size - 1);
+	}
+	return &deferred_index[i];
+}
+
+/**
+ * Make room for one more queued signal, keeping the index at most half full
+ */
+static void deferred_reserve(void)
+{
+	size_t i;
+
+	if (n_deferred < deferred_alloc) return;
+
+	deferred_alloc = deferred_alloc ? deferred_alloc * 2 : 32;
+	deferred = mem_realloc(deferred, deferred_alloc * sizeof(*deferred));
+
+	mem_free(deferred_index);
+	deferred_index_size = deferred_alloc * 2;
+	deferred_index = mem_zalloc(deferred_index_size
+		* sizeof(*deferred_index));
+	for (i = 0; i < n_deferred; i++) {
+		if (deferred[i].live) {
+			*deferred_lookup(deferred[i].type, deferred[i].has_point,
+				deferred[i].point) = i + 1;
+		}
+	}
+}
+
+/**
+ * Queue a signal, or move an identical one already queued to the back so
+ * that it is still delivered after everything signalled before it
+ */
+static void game_event_defer(game_event_type type, game_event_data *data)
+{
+	bool has_point = (data != NULL);
+	struct loc point = has_point ? data->point : loc(0, 0);
+	size_t *slot;
+	struct deferred_event *ev;
+
+	deferred_reserve();
+	slot = deferred_lookup(type, has_point, point);
+	if (*slot) {
+		deferred[*slot - 1].live = false;
+		coalesced[type]++;
+	}
+
+	ev = &deferred[n_deferred++];
+	ev->type = type;
+	ev->has_point = has_point;
+	ev->point = point;
+	ev->live = true;
+	*slot = n_deferred;
+}
+
+/**
+ * Deliver everything queued while in deferred mode, in order
+ */
+void event_flush_deferred(void)
+{
+	size_t i;
+
+	/* Handlers signalling from here are dispatched directly; one that
+	 * waits for a key flushes again, so retire each signal before it is
+	 * delivered */
+	for (i = 0; i < n_deferred; i++) {
+		struct deferred_event ev = deferred[i];
+		game_event_data data;
+
+		if (!ev.live) continue;
+		deferred[i].live = false;
+		if (ev.has_point) {
+			data.point = ev.point;
+			game_event_call(ev.type, &data);
+		} else {
+			game_event_call(ev.type, NULL);
+		}
+	}
+
+	n_deferred = 0;
+	if (deferred_index) {
+		memset(deferred_index, 0, deferred_index_size
+			* sizeof(*deferred_index));
+	}
+}
+
+/**
+ * Turn deferred mode on or off.  While it is on, UI redraw events signalled
+ * by the game are queued, with repeats coalesced, until the next refresh
+ * point; turning it off delivers anything still queued.
+ */
+void event_set_deferred(bool defer)
+{
+	if (!defer) event_flush_deferred();
+	defer_events = defer;
+}
+
+/**
+ * Return how many signals of the given type have been coalesced into an
+ * earlier queued one
+ */
+uint32_t event_coalesced_count(game_event_type type)
+{
+	return coalesced[type];
+}
+
+static void game_event_dispatch(game_event_type type, game_event_data *data)
+{
+	/* Nothing is listening */
+	if (!event_handlers[type].count && !event_is_refresh_point(type))
+		return;
+
+	/* Only signals from the game itself are held back, not the ones
+	 * sent by the handlers as they draw */
+	if (defer_events && !dispatch_depth) {
+		if (event_is_deferrable(type)) {
+			game_event_defer(type, data);
+			return;
+		}
+		if (event_is_refresh_point(type) && n_deferred) {
+			event_flush_deferred();
+		}
+	}
+
+	game_event_call(type, data);
 }
 
 void event_add_handler(game_event_type type, game_event_handler *fn, void *user)
 {
-	struct event_handler_entry *new;
+	struct event_handler_list *list = &event_handlers[type];
 
 	assert(fn != NULL);
 
-	/* Make a new entry */
-	new = mem_alloc(sizeof *new);
-	new->fn = fn;
-	new->user = user;
+	/* Grow the list */
+	if (list->count == list->alloc) {
+		list->alloc = list->alloc ? list->alloc * 2 : 4;
+		list->entries = mem_realloc(list->entries,
+			list->alloc * sizeof(*list->entries));
+	}
 
-	/* Add it to the head of the appropriate list */
-	new->next = event_handlers[type];
-	event_handlers[type] = new;
+	/* Add it to the end of the appropriate list */
+	list->entries[list->count].fn = fn;
+	list->entries[list->count].user = user;
+	list->count++;
 }
 
 void event_remove_handler(game_event_type type, game_event_handler *fn, void *user)
 {
-	struct event_handler_entry *prev = NULL;
-	struct event_handler_entry *this = event_handlers[type];
+	struct event_handler_list *list = &event_handlers[type];
+	size_t i;
+
+	/* Look for the most recent matching entry in the list */
+	for (i = list->count; i > 0; i--) {
+		struct event_handler_entry *this = &list->entries[i - 1];
 
-	/* Look for the entry in the list */
-	while (this)
-	{
 		/* Check if this is the entry we want to remove */
-		if (this->fn == fn && this->user == user)
-		{
-			if (!prev)
-			{
-				event_handlers[type] = this->next;
-			}
-			else
-			{
-				prev->next = this->next;
-			}
-
-			mem_free(this);
+		if (this->fn == fn && this->user == user) {
+			memmove(this, this + 1,
+				(list->count - i) * sizeof(*this));
+			list->count--;
 			return;
 		}
-
-		prev = this;
-		this = this->next;
 	}
 }
 
 void event_remove_handler_type(game_event_type type)
 {
-	struct event_handler_entry *handler = event_handlers[type];
+	struct event_handler_list *list = &event_handlers[type];
 
-	while (handler) {
-		struct event_handler_entry *next = handler->next;
-		mem_free(handler);
-		handler = next;
-	}
-	event_handlers[type] = NULL;
+	mem_free(list->entries);
+	list->entries = NULL;
+	list->count = 0;
+	list->alloc = 0;
 }
 
 void event_remove_all_handlers(void)
 {
 	int type;
-	struct event_handler_entry *handler, *next;
-
-	for (type = 0; type < N_GAME_EVENTS; type++) {
-		handler = event_handlers[type];
-		while (handler) {
-			next = handler->next;
-			mem_free(handler);
-			handler = next;
-		}
-		event_handlers[type] = NULL;
-	}
+
+	for (type = 0; type < N_GAME_EVENTS; type++)
+		event_remove_handler_type(type);
+
+	/* Nothing is left to deliver queued signals to */
+	defer_events = false;
+	n_deferred = 0;
+	deferred_alloc = 0;
+	mem_free(deferred);
+	deferred = NULL;
+	mem_free(deferred_index);
+	deferred_index = NULL;
+	deferred_index_size = 0;
 }
 
 void event_add_handler_set(game_event_type *type, size_t n_types, game_event_handler *fn, void *user)
@@ -282,3 +540,16 @@ void event_signal_tunnel(game_event_type type, int nstep, int npierce, int ndug,
 	data.tunnel.early = early;
 	game_event_dispatch(type, &data);
 }
+
+void event_signal_attempt(game_event_type type, const char *profile,
+		const char *reason, int number, long usec, long grids)
+{
+	game_event_data data;
+
+	data.attempt.profile = profile;
+	data.attempt.reason = reason;
+	data.attempt.number = number;
+	data.attempt.usec = usec;
+	data.attempt.grids = grids;
+	game_event_dispatch(type, &data);
+}
@@ -99,6 +99,7 @@ typedef enum game_event_type
 	EVENT_GEN_ROOM_CHOOSE_SUBTYPE, /* has string in event data with name */
 	EVENT_GEN_ROOM_END, /* has flag in event data indicating success */
 	EVENT_GEN_TUNNEL_FINISHED, /* has tunnel in event data with results */
+	EVENT_GEN_LEVEL_ATTEMPT, /* has attempt in event data with results */
 
 	EVENT_END  /* Can be sent at the end of a series of events */
 } game_event_type;
@@ -196,6 +197,23 @@ typedef union
 		 */
 		bool early;
 	} tunnel;
+
+	struct
+	{
+		/*
+		 * "profile" is the name of the level profile tried, and
+		 * "reason" why the attempt failed or NULL if it worked.
+		 */
+		const char *profile, *reason;
+		/* "number" counts the attempts at the current level from zero. */
+		int number;
+		/*
+		 * "usec" is the processor time the attempt took, in
+		 * microseconds, and "grids" is the number of grids in the
+		 * chunks allocated during it.
+		 */
+		long usec, grids;
+	} attempt;
 } game_event_data;
 
 
@@ -213,6 +231,9 @@ void event_remove_handler_type(game_event_type type);
 void event_remove_all_handlers(void);
 void event_add_handler_set(game_event_type *type, size_t n_types, game_event_handler *fn, void *user);
 void event_remove_handler_set(game_event_type *type, size_t n_types, game_event_handler *fn, void *user);
+void event_set_deferred(bool defer);
+void event_flush_deferred(void);
+uint32_t event_coalesced_count(game_event_type type);
 
 void event_signal_birthpoints(const int *points, const int *inc_points,
 	int remaining);
@@ -247,5 +268,7 @@ void event_signal_missile(game_event_type type,
 void event_signal_size(game_event_type type, int h, int w);
 void event_signal_tunnel(game_event_type type, int nstep, int npierce, int ndug,
 	int dstart, int dend, bool early);
+void event_signal_attempt(game_event_type type, const char *profile,
+	const char *reason, int number, long usec, long grids);
 
 #endif /* INCLUDED_GAME_EVENT_H */
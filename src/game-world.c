@@ -384,7 +384,7 @@ static void decrease_timeouts(void)
  * mazes.  Monsters have a hearing value, which is the largest sound value
  * they can detect.
  */
-static void make_noise(struct player *p)
+void make_noise(struct player *p)
 {
 	struct loc next = p->grid;
 	int y, x, d;
@@ -1077,6 +1077,29 @@ static void on_leave_level(void) {
 }
 
 
+/**
+ * Let the monsters with enough energy act, holding back the UI's redraws
+ * while they do so that repeats are drawn once.  Everything held back is on
+ * screen again before the player gets control.
+ */
+static void process_monsters_deferred(int minimum_energy)
+{
+	event_set_deferred(true);
+	process_monsters(minimum_energy);
+	event_set_deferred(false);
+}
+
+/**
+ * Process the world, holding back the UI's redraws as for the monsters
+ */
+static void process_world_deferred(struct chunk *c)
+{
+	event_set_deferred(true);
+	process_world(c);
+	event_set_deferred(false);
+}
+
+
 /**
  * The main game loop.
  *
@@ -1105,7 +1128,7 @@ void run_game_loop(void)
 		event_signal(EVENT_ANIMATE);
 		
 		/* Process monster with even more energy first */
-		process_monsters(player->energy + 1);
+		process_monsters_deferred(player->energy + 1);
 		if (player->is_dead || !player->upkeep->playing ||
 			player->upkeep->generate_level)
 			break;
@@ -1134,7 +1157,7 @@ void run_game_loop(void)
 			return;
 		else if (!player->upkeep->generate_level) {
 			/* Process the rest of the monsters */
-			process_monsters(0);
+			process_monsters_deferred(0);
 
 			/* Mark all monsters as ready to act when they have the energy */
 			reset_monsters();
@@ -1148,7 +1171,7 @@ void run_game_loop(void)
 
 			/* Process the world every ten turns */
 			if (!(turn % 10) && !player->upkeep->generate_level) {
-				process_world(cave);
+				process_world_deferred(cave);
 
 				/* Refresh */
 				notice_stuff(player);
@@ -1196,7 +1219,7 @@ void run_game_loop(void)
 			event_signal(EVENT_ANIMATE);
 
 			/* Process monster with even more energy first */
-			process_monsters(player->energy + 1);
+			process_monsters_deferred(player->energy + 1);
 			if (player->is_dead || !player->upkeep->playing ||
 				player->upkeep->generate_level)
 				break;
@@ -1165,9 +1165,7 @@ struct chunk *classic_gen(struct player *p, int min_height, int min_width,
 	dun->col_blocks = c->width / dun->block_wid;
 
 	/* Initialize the room table */
-	dun->room_map = mem_zalloc(dun->row_blocks * sizeof(bool*));
-	for (i = 0; i < dun->row_blocks; i++)
-		dun->room_map[i] = mem_zalloc(dun->col_blocks * sizeof(bool));
+	alloc_room_map();
 
 	/* Initialize the block table */
 	blocks_tried = mem_zalloc(dun->row_blocks * sizeof(bool*));
@@ -1249,10 +1247,17 @@ struct chunk *classic_gen(struct player *p, int min_height, int min_width,
 
 	for (i = 0; i < dun->row_blocks; i++){
 		mem_free(blocks_tried[i]);
-		mem_free(dun->room_map[i]);
 	}
 	mem_free(blocks_tried);
-	mem_free(dun->room_map);
+	free_room_map();
+
+	/* Give up now if the level cannot work */
+	if (!level_is_viable(c, 1, p_error)) {
+		uncreate_artifacts(c);
+		wipe_mon_list(c, p);
+		cave_free(c);
+		return NULL;
+	}
 
 	/* Generate permanent walls around the edge of the generated area */
 	draw_rectangle(c, 0, 0, c->height - 1, c->width - 1, 
@@ -1541,6 +1546,13 @@ struct chunk *labyrinth_gen(struct player *p, int min_height, int min_width,
 		return NULL;
 	}
 
+	/* Give up now if the level cannot work */
+	if (!level_is_viable(c, 0, p_error)) {
+		uncreate_artifacts(c);
+		cave_free(c);
+		return NULL;
+	}
+
 	/* Determine the character location */
 	if (!new_player_spot(c, p)) {
 		uncreate_artifacts(c);
@@ -2177,6 +2189,12 @@ struct chunk *cavern_gen(struct player *p, int min_height, int min_width,
 		return NULL;
 	}
 
+	/* Give up now if the level cannot work */
+	if (!level_is_viable(c, 0, p_error)) {
+		cave_free(c);
+		return NULL;
+	}
+
 	/* Surround the level with perma-rock */
 	draw_rectangle(c, 0, 0, h - 1, w - 1, FEAT_PERM, SQUARE_NONE, true);
 
@@ -2717,10 +2735,12 @@ struct chunk *town_gen(struct player *p, int min_height, int min_width,
  * \param height are the chunk's dimensions
  * \param width are the chunk's dimensions
  * \param persistent If true, handle the connections for persistent levels.
+ * \param p_error will be dereferenced and set to a the address of a constant
+ * string describing the failure when the returned chunk is NULL.
  * \return a pointer to the generated chunk
  */
 static struct chunk *modified_chunk(struct player *p, int depth, int height,
-		int width, bool persistent)
+		int width, bool persistent, const char **p_error)
 {
 	int i;
 	int by = 0, bx = 0, key, rarity;
@@ -2750,9 +2770,7 @@ static struct chunk *modified_chunk(struct player *p, int depth, int height,
 	dun->col_blocks = c->width / dun->block_wid;
 
 	/* Initialize the room table */
-	dun->room_map = mem_zalloc(dun->row_blocks * sizeof(bool*));
-	for (i = 0; i < dun->row_blocks; i++)
-		dun->room_map[i] = mem_zalloc(dun->col_blocks * sizeof(bool));
+	alloc_room_map();
 
 	/* No rooms yet, pits or otherwise. */
 	dun->pit_num = 0;
@@ -2785,9 +2803,11 @@ static struct chunk *modified_chunk(struct player *p, int depth, int height,
 		 * saying no further progress is likely.
 		 */
 		if (n_attempt > 500) {
+			free_room_map();
 			uncreate_artifacts(c);
 			wipe_mon_list(c, p);
 			cave_free(c);
+			*p_error = "modified chunk could not be created";
 			return NULL;
 		}
 		++n_attempt;
@@ -2819,9 +2839,15 @@ static struct chunk *modified_chunk(struct player *p, int depth, int height,
 		}
 	}
 
-	for (i = 0; i < dun->row_blocks; i++)
-		mem_free(dun->room_map[i]);
-	mem_free(dun->room_map);
+	free_room_map();
+
+	/* Give up now if the level cannot work */
+	if (!level_is_viable(c, 1, p_error)) {
+		uncreate_artifacts(c);
+		wipe_mon_list(c, p);
+		cave_free(c);
+		return NULL;
+	}
 
 	/* Connect all the rooms together */
 	do_traditional_tunneling(c);
@@ -2889,9 +2915,8 @@ struct chunk *modified_gen(struct player *p, int min_height, int min_width,
 	dun->block_wid = dun->profile->block_size;
 
 	c = modified_chunk(p, p->depth, MIN(z_info->dungeon_hgt, y_size),
-		MIN(z_info->dungeon_wid, x_size), dun->persist);
+		MIN(z_info->dungeon_wid, x_size), dun->persist, p_error);
 	if (!c) {
-		*p_error = "modified chunk could not be created";
 		return NULL;
 	}
 
@@ -2963,10 +2988,12 @@ struct chunk *modified_gen(struct player *p, int min_height, int min_width,
  * \param height are the chunk's dimensions
  * \param width are the chunk's dimensions
  * \param persistent If true, handle the connections for persistent levels.
+ * \param p_error will be dereferenced and set to a the address of a constant
+ * string describing the failure when the returned chunk is NULL.
  * \return a pointer to the generated chunk
  */
 static struct chunk *moria_chunk(struct player *p, int depth, int height,
-		int width, bool persistent)
+		int width, bool persistent, const char **p_error)
 {
 	int i;
 	int by = 0, bx = 0, key, rarity;
@@ -2996,9 +3023,7 @@ static struct chunk *moria_chunk(struct player *p, int depth, int height,
 	dun->col_blocks = c->width / dun->block_wid;
 
 	/* Initialize the room table */
-	dun->room_map = mem_zalloc(dun->row_blocks * sizeof(bool*));
-	for (i = 0; i < dun->row_blocks; i++)
-		dun->room_map[i] = mem_zalloc(dun->col_blocks * sizeof(bool));
+	alloc_room_map();
 
 	/* No rooms yet, pits or otherwise. */
 	dun->pit_num = 0;
@@ -3032,9 +3057,11 @@ static struct chunk *moria_chunk(struct player *p, int depth, int height,
 		 * cutoff for saying no further progress is likely.
 		 */
 		if (n_attempt > 500) {
+			free_room_map();
 			uncreate_artifacts(c);
 			wipe_mon_list(c, p);
 			cave_free(c);
+			*p_error = "moria chunk could not be created";
 			return NULL;
 		}
 		++n_attempt;
@@ -3066,9 +3093,15 @@ static struct chunk *moria_chunk(struct player *p, int depth, int height,
 		}
 	}
 
-	for (i = 0; i < dun->row_blocks; i++)
-		mem_free(dun->room_map[i]);
-	mem_free(dun->room_map);
+	free_room_map();
+
+	/* Give up now if the level cannot work */
+	if (!level_is_viable(c, 1, p_error)) {
+		uncreate_artifacts(c);
+		wipe_mon_list(c, p);
+		cave_free(c);
+		return NULL;
+	}
 
 	/* Connect all the rooms together */
 	do_traditional_tunneling(c);
@@ -3127,9 +3160,8 @@ struct chunk *moria_gen(struct player *p, int min_height, int min_width,
 	dun->block_wid = dun->profile->block_size;
 
 	c = moria_chunk(p, p->depth, MIN(z_info->dungeon_hgt, y_size),
-		MIN(z_info->dungeon_wid, x_size), dun->persist);
+		MIN(z_info->dungeon_wid, x_size), dun->persist, p_error);
 	if (!c) {
-		*p_error = "moria chunk could not be created";
 		return NULL;
 	}
 
@@ -3445,6 +3477,21 @@ struct chunk *hard_centre_gen(struct player *p, int min_height, int min_width,
 		loc(z_info->dungeon_wid - 1, z_info->dungeon_hgt - 1));
 	floor[2] = grid;
 
+	/* Free all the chunks */
+	cave_free(left_cavern);
+	cave_free(upper_cavern);
+	cave_free(centre);
+	cave_free(lower_cavern);
+	cave_free(right_cavern);
+
+	/* Give up now if the level cannot work */
+	if (!level_is_viable(c, 0, p_error)) {
+		uncreate_artifacts(c);
+		wipe_mon_list(c, p);
+		cave_free(c);
+		return NULL;
+	}
+
 	/* Encase in perma-rock */
 	draw_rectangle(c, 0, 0, c->height - 1, c->width - 1,
 		FEAT_PERM, SQUARE_NONE, true);
@@ -3455,13 +3502,6 @@ struct chunk *hard_centre_gen(struct player *p, int min_height, int min_width,
 	/* Connect to the centre entrances. */
 	ensure_connectedness(c, false);
 
-	/* Free all the chunks */
-	cave_free(left_cavern);
-	cave_free(upper_cavern);
-	cave_free(centre);
-	cave_free(lower_cavern);
-	cave_free(right_cavern);
-
 	cavern_area = (left_cavern_wid + right_cavern_wid) * z_info->dungeon_hgt +
 		centre_cavern_wid * (upper_cavern_hgt + lower_cavern_hgt);
 
@@ -3586,12 +3626,11 @@ struct chunk *lair_gen(struct player *p, int min_height, int min_width,
 	dun->join = transform_join_list(cached_join, y_size, normal_width,
 		0, normal_offset, 0, false);
 	normal = modified_chunk(p, p->depth, y_size, normal_width,
-		dun->persist);
+		dun->persist, p_error);
 	/* Done with the transformed connector information. */
 	cave_connectors_free(dun->join);
 	dun->join = cached_join;
 	if (!normal) {
-		*p_error = "modified chunk could not be created";
 		return NULL;
 	}
 
@@ -3775,6 +3814,19 @@ struct chunk *gauntlet_gen(struct player *p, int min_height, int min_width,
 		return NULL;
 	}
 
+	/* Give up now if any part cannot work */
+	if (!level_is_viable(gauntlet, 0, p_error)
+			|| !level_is_viable(left, 0, p_error)
+			|| !level_is_viable(right, 0, p_error)) {
+		uncreate_artifacts(gauntlet);
+		cave_free(gauntlet);
+		uncreate_artifacts(left);
+		cave_free(left);
+		uncreate_artifacts(right);
+		cave_free(right);
+		return NULL;
+	}
+
 	/* Record lines between chunks */
 	line1 = left->width;
 	line2 = line1 + gauntlet->width;
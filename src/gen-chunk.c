@@ -54,6 +54,7 @@ struct chunk *chunk_write(struct chunk *c)
 		for (x = 0; x < new->width; x++) {
 			/* Terrain */
 			new->squares[y][x].feat = square(c, loc(x, y))->feat;
+			new->caps[y][x] = c->caps[y][x];
 			sqinfo_copy(square(new, loc(x, y))->info, square(c, loc(x, y))->info);
 		}
 	}
@@ -350,6 +351,9 @@ bool chunk_copy(struct chunk *dest, struct player *p, struct chunk *source,
 	int h = source->height, w = source->width;
 	int mon_skip = dest->mon_max - 1;
 
+	/* Stored chunks are kept compressed */
+	chunk_unpack(source);
+
 	/* Check bounds */
 	if (rotate % 1) {
 		if ((w + y0 > dest->height) || (h + x0 > dest->width))
@@ -369,6 +373,8 @@ bool chunk_copy(struct chunk *dest, struct player *p, struct chunk *source,
 			/* Terrain */
 			dest->squares[dest_grid.y][dest_grid.x].feat =
 				square(source, grid)->feat;
+			dest->caps[dest_grid.y][dest_grid.x] =
+				source->caps[grid.y][grid.x];
 			sqinfo_copy(square(dest, dest_grid)->info,
 						square(source, grid)->info);
 
@@ -491,6 +497,7 @@ bool chunk_copy(struct chunk *dest, struct player *p, struct chunk *source,
 	/* Miscellany */
 	for (i = 0; i < FEAT_MAX + 1; i++)
 		dest->feat_count[i] += source->feat_count[i];
+	cave_note_terrain_change(dest);
 
 	if (dest->obj_rating < UINT32_MAX - source->obj_rating) {
 		dest->obj_rating += source->obj_rating;
@@ -530,3 +537,305 @@ void chunk_validate_objects(struct chunk *c) {
 	}
 }
 
+
+/**
+ * ------------------------------------------------------------------------
+ * Packing of stored chunks
+ *
+ * A chunk sitting in the chunk list is never looked at grid by grid until
+ * the player returns to it, so its grids are kept run-length encoded.  Each
+ * plane (terrain, its FEAT_CAP_ bits, square flags, light, noise, scent) is
+ * encoded separately, in row-major order, as a byte count followed by the
+ * value.  Monsters, objects and traps are left where they are, and the few
+ * grids which point to them are kept in a list.
+ * ------------------------------------------------------------------------ */
+enum chunk_plane {
+	CHUNK_PLANE_FEAT = 0,
+	CHUNK_PLANE_CAPS,
+	CHUNK_PLANE_INFO,
+	CHUNK_PLANE_LIGHT,
+	CHUNK_PLANE_NOISE,
+	CHUNK_PLANE_SCENT,
+
+	CHUNK_PLANE_MAX
+};
+
+struct chunk_packed_grid {
+	struct loc grid;
+	int16_t mon;
+	struct object *obj;
+	struct trap *trap;
+};
+
+struct chunk_pack {
+	uint8_t *runs;
+	size_t runs_len;
+	size_t runs_size;
+
+	struct chunk_packed_grid *grids;
+	int grid_num;
+};
+
+/**
+ * Size of a single value in a plane
+ */
+static size_t chunk_plane_width(enum chunk_plane plane)
+{
+	switch (plane) {
+		case CHUNK_PLANE_FEAT: return 1;
+		case CHUNK_PLANE_CAPS: return 1;
+		case CHUNK_PLANE_INFO: return SQUARE_SIZE;
+		case CHUNK_PLANE_LIGHT: return sizeof(int);
+		case CHUNK_PLANE_NOISE: return sizeof(uint16_t);
+		case CHUNK_PLANE_SCENT: return sizeof(uint16_t);
+		default: break;
+	}
+	assert(0);
+	return 0;
+}
+
+/**
+ * Access the value of a plane at a grid
+ */
+static uint8_t *chunk_plane_value(struct chunk *c, enum chunk_plane plane,
+		struct loc grid)
+{
+	struct square *sq = &c->squares[grid.y][grid.x];
+
+	switch (plane) {
+		case CHUNK_PLANE_FEAT: return &sq->feat;
+		case CHUNK_PLANE_CAPS: return &c->caps[grid.y][grid.x];
+		case CHUNK_PLANE_INFO: return sq->info;
+		case CHUNK_PLANE_LIGHT: return (uint8_t *) &sq->light;
+		case CHUNK_PLANE_NOISE:
+			return (uint8_t *) &c->noise.grids[grid.y][grid.x];
+		case CHUNK_PLANE_SCENT:
+			return (uint8_t *) &c->scent.grids[grid.y][grid.x];
+		default: break;
+	}
+	assert(0);
+	return NULL;
+}
+
+/**
+ * Append a run to a pack
+ */
+static void chunk_pack_run(struct chunk_pack *pack, uint8_t count,
+		const uint8_t *value, size_t width)
+{
+	if (pack->runs_len + 1 + width > pack->runs_size) {
+		pack->runs_size = MAX(2 * pack->runs_size, 256);
+		pack->runs = mem_realloc(pack->runs, pack->runs_size);
+	}
+	pack->runs[pack->runs_len++] = count;
+	memcpy(pack->runs + pack->runs_len, value, width);
+	pack->runs_len += width;
+}
+
+/**
+ * Run-length encode one plane of a chunk
+ */
+static void chunk_pack_plane(struct chunk_pack *pack, struct chunk *c,
+		enum chunk_plane plane)
+{
+	size_t width = chunk_plane_width(plane);
+	const uint8_t *prev = NULL;
+	uint8_t count = 0;
+	struct loc grid;
+
+	for (grid.y = 0; grid.y < c->height; grid.y++) {
+		for (grid.x = 0; grid.x < c->width; grid.x++) {
+			const uint8_t *value = chunk_plane_value(c, plane, grid);
+
+			/* If the run is broken, or too full, flush it */
+			if (!prev || count == UCHAR_MAX
+					|| memcmp(value, prev, width)) {
+				if (count) {
+					chunk_pack_run(pack, count, prev, width);
+				}
+				prev = value;
+				count = 1;
+			} else {
+				count++;
+			}
+		}
+	}
+
+	/* Flush the data (if any) */
+	if (count) {
+		chunk_pack_run(pack, count, prev, width);
+	}
+}
+
+/**
+ * Decode one plane of a chunk, returning the position after it in the runs
+ */
+static size_t chunk_unpack_plane(const struct chunk_pack *pack, size_t pos,
+		struct chunk *c, enum chunk_plane plane)
+{
+	size_t width = chunk_plane_width(plane);
+	struct loc grid = loc(0, 0);
+
+	while (grid.y < c->height) {
+		uint8_t count;
+		const uint8_t *value;
+
+		assert(pos + 1 + width <= pack->runs_len);
+		count = pack->runs[pos];
+		value = pack->runs + pos + 1;
+		pos += 1 + width;
+
+		while (count--) {
+			assert(grid.y < c->height);
+			memcpy(chunk_plane_value(c, plane, grid), value, width);
+			if (++grid.x == c->width) {
+				grid.x = 0;
+				grid.y++;
+			}
+		}
+	}
+
+	return pos;
+}
+
+/**
+ * Check whether a chunk's grids are currently compressed
+ */
+bool chunk_is_packed(const struct chunk *c)
+{
+	return c->packed != NULL;
+}
+
+/**
+ * Compress the grids of a stored chunk and shrink its monster array.
+ *
+ * The chunk must not be the current level (or its known version); nothing
+ * may look at its squares until chunk_unpack() is called.
+ */
+void chunk_pack(struct chunk *c)
+{
+	struct chunk_pack *pack;
+	struct loc grid;
+	int plane, grid_max = 0;
+
+	if (chunk_is_packed(c)) return;
+	assert(c != cave && (!player || c != player->cave));
+
+	pack = mem_zalloc(sizeof(*pack));
+	for (plane = 0; plane < CHUNK_PLANE_MAX; plane++) {
+		chunk_pack_plane(pack, c, plane);
+	}
+	pack->runs = mem_realloc(pack->runs, pack->runs_len);
+	pack->runs_size = pack->runs_len;
+
+	/* Remember the grids with something in them, then free the grids */
+	for (grid.y = 0; grid.y < c->height; grid.y++) {
+		for (grid.x = 0; grid.x < c->width; grid.x++) {
+			struct square *sq = &c->squares[grid.y][grid.x];
+
+			if (sq->mon || sq->obj || sq->trap) {
+				struct chunk_packed_grid *pg;
+
+				if (pack->grid_num == grid_max) {
+					grid_max = MAX(2 * grid_max, 32);
+					pack->grids = mem_realloc(pack->grids,
+						grid_max * sizeof(*pack->grids));
+				}
+				pg = &pack->grids[pack->grid_num++];
+				pg->grid = grid;
+				pg->mon = sq->mon;
+				pg->obj = sq->obj;
+				pg->trap = sq->trap;
+			}
+			mem_free(sq->info);
+		}
+		mem_free(c->squares[grid.y]);
+		mem_free(c->caps[grid.y]);
+		mem_free(c->noise.grids[grid.y]);
+		mem_free(c->scent.grids[grid.y]);
+	}
+	mem_free(c->squares);
+	c->squares = NULL;
+	mem_free(c->caps);
+	c->caps = NULL;
+	mem_free(c->noise.grids);
+	c->noise.grids = NULL;
+	mem_free(c->scent.grids);
+	c->scent.grids = NULL;
+
+	/* Only the monsters actually in use need keeping */
+	c->monsters = mem_realloc(c->monsters,
+		c->mon_max * sizeof(struct monster));
+
+	c->packed = pack;
+}
+
+/**
+ * Restore the grids of a packed chunk so it can be used again
+ */
+void chunk_unpack(struct chunk *c)
+{
+	struct chunk_pack *pack = c->packed;
+	size_t pos = 0;
+	int i, y, x, plane;
+
+	if (!pack) return;
+
+	/* The chunk may now change, so its savefile record is stale */
+	mem_free(c->save_image);
+	c->save_image = NULL;
+	c->save_image_len = 0;
+
+	c->squares = mem_zalloc(c->height * sizeof(struct square*));
+	c->caps = mem_zalloc(c->height * sizeof(uint8_t*));
+	c->noise.grids = mem_zalloc(c->height * sizeof(uint16_t*));
+	c->scent.grids = mem_zalloc(c->height * sizeof(uint16_t*));
+	for (y = 0; y < c->height; y++) {
+		c->squares[y] = mem_zalloc(c->width * sizeof(struct square));
+		for (x = 0; x < c->width; x++) {
+			c->squares[y][x].info = mem_zalloc(SQUARE_SIZE * sizeof(bitflag));
+		}
+		c->caps[y] = mem_zalloc(c->width * sizeof(uint8_t));
+		c->noise.grids[y] = mem_zalloc(c->width * sizeof(uint16_t));
+		c->scent.grids[y] = mem_zalloc(c->width * sizeof(uint16_t));
+	}
+
+	for (plane = 0; plane < CHUNK_PLANE_MAX; plane++) {
+		pos = chunk_unpack_plane(pack, pos, c, plane);
+	}
+	assert(pos == pack->runs_len);
+
+	for (i = 0; i < pack->grid_num; i++) {
+		struct chunk_packed_grid *pg = &pack->grids[i];
+		struct square *sq = &c->squares[pg->grid.y][pg->grid.x];
+
+		sq->mon = pg->mon;
+		sq->obj = pg->obj;
+		sq->trap = pg->trap;
+	}
+
+	c->monsters = mem_realloc(c->monsters,
+		z_info->level_monster_max * sizeof(struct monster));
+	memset(c->monsters + c->mon_max, 0,
+		(z_info->level_monster_max - c->mon_max) * sizeof(struct monster));
+
+	mem_free(pack->grids);
+	mem_free(pack->runs);
+	mem_free(pack);
+	c->packed = NULL;
+}
+
+/**
+ * Pack every chunk in the chunk list except the given ones
+ * \param keep1 is a chunk to leave alone; may be NULL
+ * \param keep2 is another chunk to leave alone; may be NULL
+ */
+void chunk_list_pack(const struct chunk *keep1, const struct chunk *keep2)
+{
+	int i;
+
+	for (i = 0; i < chunk_list_max; i++) {
+		if (chunk_list[i] == keep1 || chunk_list[i] == keep2) continue;
+		chunk_pack(chunk_list[i]);
+	}
+}
@@ -46,6 +46,39 @@
  * ------------------------------------------------------------------------
  * Selection of random templates
  * ------------------------------------------------------------------------ */
+/**
+ * Room templates and vaults are indexed when they are read, so that picking
+ * one only looks at the candidates.  The pick is still made by stepping
+ * through the candidates in file order and keeping the nth with chance 1/n,
+ * so the random numbers used, and so the levels generated, are the same as
+ * when the whole list was searched.
+ */
+struct room_template_group {
+	uint8_t typ;
+	uint8_t rat;
+	int num;
+	struct room_template **list;
+};
+
+/**
+ * Vaults of one type, split into bands of depth which have the same
+ * candidates
+ */
+struct vault_group {
+	const char *typ;
+	int16_t band[UCHAR_MAX + 1];	/* Band for each depth, or -1 if none */
+	int num_bands;
+	struct vault_band {
+		int num;
+		struct vault **list;
+	} *bands;
+};
+
+static struct room_template_group *template_groups;
+static int num_template_groups;
+static struct vault_group *vault_groups;
+static int num_vault_groups;
+
 /**
  * Chooses a room template of a particular kind at random.
  * \param typ template room type to select
@@ -54,16 +87,19 @@
  */
 static struct room_template *random_room_template(int typ, int rating)
 {
-	struct room_template *t = room_templates;
 	struct room_template *r = NULL;
-	int n = 1;
-	do {
-		if ((t->typ == typ) && (t->rat == rating)) {
-			if (one_in_(n)) r = t;
-			n++;
-		}
-		t = t->next;
-	} while(t);
+	int i;
+
+	for (i = 0; i < num_template_groups; i++) {
+		const struct room_template_group *g = &template_groups[i];
+		int j;
+
+		if (g->typ != typ || g->rat != rating) continue;
+		for (j = 0; j < g->num; j++) {
+			if (one_in_(j + 1)) r = g->list[j];
+		}
+		break;
+	}
 	return r;
 }
 
@@ -75,20 +111,176 @@ static struct room_template *random_room_template(int typ, int rating)
  */
 struct vault *random_vault(int depth, const char *typ)
 {
-	struct vault *v = vaults;
 	struct vault *r = NULL;
-	int n = 1;
-	do {
-		if (streq(v->typ, typ) && (v->min_lev <= depth)
-			&& (v->max_lev >= depth)) {
-			if (one_in_(n)) r = v;
-			n++;
-		}
-		v = v->next;
-	} while(v);
+	int i;
+
+	if (depth < 0 || depth > UCHAR_MAX) return NULL;
+	for (i = 0; i < num_vault_groups; i++) {
+		const struct vault_group *g = &vault_groups[i];
+		const struct vault_band *b;
+		int j;
+
+		if (!streq(g->typ, typ)) continue;
+		if (g->band[depth] < 0) break;
+		b = &g->bands[g->band[depth]];
+		for (j = 0; j < b->num; j++) {
+			if (one_in_(j + 1)) r = b->list[j];
+		}
+		break;
+	}
 	return r;
 }
 
+/**
+ * Index the room templates by type and rating
+ */
+void index_room_templates(struct room_template *templates)
+{
+	struct room_template *t;
+
+	free_room_template_index();
+	for (t = templates; t; t = t->next) {
+		struct room_template_group *g = NULL;
+		int i;
+
+		for (i = 0; i < num_template_groups; i++) {
+			if (template_groups[i].typ == t->typ
+					&& template_groups[i].rat == t->rat) {
+				g = &template_groups[i];
+				break;
+			}
+		}
+		if (!g) {
+			template_groups = mem_realloc(template_groups,
+				(num_template_groups + 1) * sizeof(*template_groups));
+			g = &template_groups[num_template_groups++];
+			memset(g, 0, sizeof(*g));
+			g->typ = t->typ;
+			g->rat = t->rat;
+		}
+		g->list = mem_realloc(g->list, (g->num + 1) * sizeof(*g->list));
+		g->list[g->num++] = t;
+	}
+}
+
+void free_room_template_index(void)
+{
+	int i;
+
+	for (i = 0; i < num_template_groups; i++) {
+		mem_free(template_groups[i].list);
+	}
+	mem_free(template_groups);
+	template_groups = NULL;
+	num_template_groups = 0;
+}
+
+/**
+ * Index the vaults by type and depth
+ */
+void index_vaults(struct vault *list)
+{
+	struct vault *v;
+	int i;
+
+	free_vault_index();
+
+	/* Find the types */
+	for (v = list; v; v = v->next) {
+		for (i = 0; i < num_vault_groups; i++) {
+			if (streq(vault_groups[i].typ, v->typ)) break;
+		}
+		if (i < num_vault_groups) continue;
+		vault_groups = mem_realloc(vault_groups,
+			(num_vault_groups + 1) * sizeof(*vault_groups));
+		memset(&vault_groups[num_vault_groups], 0, sizeof(*vault_groups));
+		vault_groups[num_vault_groups++].typ = v->typ;
+	}
+
+	/* Split each type into bands of depth with the same candidates */
+	for (i = 0; i < num_vault_groups; i++) {
+		struct vault_group *g = &vault_groups[i];
+		struct vault_band *b = NULL;
+		int depth;
+
+		for (depth = 0; depth <= UCHAR_MAX; depth++) {
+			bool changed = (depth == 0);
+
+			/* Candidates only change where some vault starts or stops */
+			for (v = list; v && !changed; v = v->next) {
+				if (!streq(v->typ, g->typ)) continue;
+				if (v->min_lev == depth || v->max_lev + 1 == depth)
+					changed = true;
+			}
+			if (changed) {
+				g->bands = mem_realloc(g->bands,
+					(g->num_bands + 1) * sizeof(*g->bands));
+				b = &g->bands[g->num_bands++];
+				b->num = 0;
+				b->list = NULL;
+				for (v = list; v; v = v->next) {
+					if (!streq(v->typ, g->typ)) continue;
+					if (v->min_lev > depth || v->max_lev < depth)
+						continue;
+					b->list = mem_realloc(b->list,
+						(b->num + 1) * sizeof(*b->list));
+					b->list[b->num++] = v;
+				}
+			}
+			g->band[depth] = b->num ? g->num_bands - 1 : -1;
+		}
+	}
+}
+
+void free_vault_index(void)
+{
+	int i, j;
+
+	for (i = 0; i < num_vault_groups; i++) {
+		for (j = 0; j < vault_groups[i].num_bands; j++) {
+			mem_free(vault_groups[i].bands[j].list);
+		}
+		mem_free(vault_groups[i].bands);
+	}
+	mem_free(vault_groups);
+	vault_groups = NULL;
+	num_vault_groups = 0;
+}
+
+/**
+ * ------------------------------------------------------------------------
+ * Room stamps
+ * ------------------------------------------------------------------------ */
+/**
+ * Compile the text of a room template or vault.  Builders walk the stamp
+ * instead of the text, so the grids are visited, and the random numbers used,
+ * in the same order as before.
+ */
+struct room_stamp *room_stamp_new(const char *text, int hgt, int wid)
+{
+	struct room_stamp *stamp = mem_zalloc(sizeof(*stamp));
+	const char *t;
+	int x, y;
+
+	stamp->grids = mem_alloc(hgt * wid * sizeof(*stamp->grids));
+	for (t = text, y = 0; t && y < hgt && *t; y++) {
+		for (x = 0; x < wid && *t; x++, t++) {
+			if (*t == ' ') continue;
+			stamp->grids[stamp->num].x = x;
+			stamp->grids[stamp->num].y = y;
+			stamp->grids[stamp->num].sym = *t;
+			stamp->num++;
+		}
+	}
+	return stamp;
+}
+
+void room_stamp_free(struct room_stamp *stamp)
+{
+	if (!stamp) return;
+	mem_free(stamp->grids);
+	mem_free(stamp);
+}
 
 
 /**
@@ -993,6 +1185,38 @@ void set_pit_type(int depth, int type)
 	dun->pit_type = &pit_info[pit_idx];
 }
 
+/**
+ * The block map holds a bit for each block, set if the block is reserved,
+ * with each row of blocks in ROOM_MAP_WORDS() words.
+ */
+#define ROOM_MAP_BITS 32
+#define ROOM_MAP_WORDS(n) (((n) + ROOM_MAP_BITS - 1) / ROOM_MAP_BITS)
+
+/**
+ * Allocate an empty block map for the current row_blocks and col_blocks
+ */
+void alloc_room_map(void)
+{
+	int by;
+
+	dun->room_map = mem_zalloc(dun->row_blocks * sizeof(*dun->room_map));
+	for (by = 0; by < dun->row_blocks; by++) {
+		dun->room_map[by] = mem_zalloc(ROOM_MAP_WORDS(dun->col_blocks)
+			* sizeof(**dun->room_map));
+	}
+}
+
+void free_room_map(void)
+{
+	int by;
+
+	for (by = 0; by < dun->row_blocks; by++) {
+		mem_free(dun->room_map[by]);
+	}
+	mem_free(dun->room_map);
+	dun->room_map = NULL;
+}
+
 /**
  * Check that a rectangular range has not been reserved in the block map.
  * \param by1 Is the y block coordinate for the top left corner of the range.
@@ -1013,7 +1237,9 @@ static bool check_for_unreserved_blocks(int by1, int bx1, int by2, int bx2)
 	/* Verify open space */
 	for (by = by1; by <= by2; by++) {
 		for (bx = bx1; bx <= bx2; bx++) {
-			if (dun->room_map[by][bx]) return false;
+			if (dun->room_map[by][bx / ROOM_MAP_BITS]
+					& (1U << (bx % ROOM_MAP_BITS)))
+				return false;
 		}
 	}
 	return true;
@@ -1032,9 +1258,78 @@ static void reserve_blocks(int by1, int bx1, int by2, int bx2)
 
 	for (by = by1; by <= by2; by++) {
 		for (bx = bx1; bx <= bx2; bx++) {
-			dun->room_map[by][bx] = true;
+			dun->room_map[by][bx / ROOM_MAP_BITS] |=
+				1U << (bx % ROOM_MAP_BITS);
+		}
+	}
+}
+
+/**
+ * Count the set bits in a word of the block map
+ */
+static int count_map_bits(uint32_t bits)
+{
+	int n = 0;
+
+	while (bits) {
+		bits &= bits - 1;
+		n++;
+	}
+	return n;
+}
+
+/**
+ * Mark, for each block in one row, whether a range of unreserved blocks
+ * blocks_high by blocks_wide could have its top left corner there.
+ * \param by is the row of blocks
+ * \param blocks_high is the height of the range in blocks
+ * \param blocks_wide is the width of the range in blocks
+ * \param fits is where the marks go, one bit per block
+ * \param open is space for one row of the map
+ * \return the number of blocks marked
+ */
+static int mark_free_corners(int by, int blocks_high, int blocks_wide,
+		uint32_t *fits, uint32_t *open)
+{
+	int words = ROOM_MAP_WORDS(dun->col_blocks);
+	int i, k, n = 0;
+
+	/* Blocks free in every row of the range, and on the map */
+	for (i = 0; i < words; i++) {
+		int left = dun->col_blocks - i * ROOM_MAP_BITS;
+
+		open[i] = (left >= ROOM_MAP_BITS) ? 0xFFFFFFFFU :
+			((1U << left) - 1);
+		for (k = by; k < by + blocks_high; k++) {
+			open[i] &= ~dun->room_map[k][i];
+		}
+	}
+
+	/* Corners with enough free blocks to their right */
+	for (i = 0; i < words; i++) {
+		fits[i] = open[i];
+	}
+	for (k = 1; k < blocks_wide; k++) {
+		int shift = k % ROOM_MAP_BITS, skip = k / ROOM_MAP_BITS;
+
+		for (i = 0; i < words; i++) {
+			uint32_t shifted = 0;
+
+			if (i + skip < words) {
+				shifted = open[i + skip] >> shift;
+				if (shift && i + skip + 1 < words) {
+					shifted |= open[i + skip + 1]
+						<< (ROOM_MAP_BITS - shift);
+				}
+			}
+			fits[i] &= shifted;
 		}
 	}
+
+	for (i = 0; i < words; i++) {
+		n += count_map_bits(fits[i]);
+	}
+	return n;
 }
 
 /**
@@ -1048,7 +1343,9 @@ static void reserve_blocks(int by1, int bx1, int by2, int bx2)
  * Find and allocate a free space in the dungeon large enough to hold
  * the room calling this function.
  *
- * We allocate space in blocks.
+ * We allocate space in blocks.  Every place the room could go is found from
+ * the block map, and one of them chosen at random, so a room which fits
+ * anywhere always gets a place.
  *
  * Be careful to include the edges of the room in height and width!
  *
@@ -1057,63 +1354,90 @@ static void reserve_blocks(int by1, int bx1, int by2, int bx2)
  */
 static bool find_space(struct loc *centre, int height, int width)
 {
-	int i;
-	int by1, bx1, by2, bx2;
+	int by, i, pick, total = 0;
+	int by1, bx1 = 0, by2, bx2;
+	int words = ROOM_MAP_WORDS(dun->col_blocks);
+	uint32_t *fits, *open;
+	int *row_count;
 
 	/* Find out how many blocks we need. */
 	int blocks_high = 1 + ((height - 1) / dun->block_hgt);
 	int blocks_wide = 1 + ((width - 1) / dun->block_wid);
 
-	/* We'll allow twenty-five guesses. */
-	for (i = 0; i < 25; i++) {
-		/* Pick a top left block at random */
-		by1 = randint0(dun->row_blocks);
-		bx1 = randint0(dun->col_blocks);
-
-		/* Extract bottom right corner block */
-		by2 = by1 + blocks_high - 1;
-		bx2 = bx1 + blocks_wide - 1;
+	if (blocks_high > dun->row_blocks || blocks_wide > dun->col_blocks)
+		return false;
 
-		if (!check_for_unreserved_blocks(by1, bx1, by2, bx2)) continue;
+	/* Find every top left block which has room */
+	fits = mem_alloc(dun->row_blocks * words * sizeof(*fits));
+	open = mem_alloc(words * sizeof(*open));
+	row_count = mem_zalloc(dun->row_blocks * sizeof(*row_count));
+	for (by = 0; by + blocks_high <= dun->row_blocks; by++) {
+		row_count[by] = mark_free_corners(by, blocks_high, blocks_wide,
+			fits + by * words, open);
+		total += row_count[by];
+	}
+	mem_free(open);
+	if (!total) {
+		mem_free(row_count);
+		mem_free(fits);
+		return false;
+	}
 
-		/* Get the location of the room */
-		centre->y = ((by1 + by2 + 1) * dun->block_hgt) / 2;
-		centre->x = ((bx1 + bx2 + 1) * dun->block_wid) / 2;
+	/* Pick one */
+	pick = randint0(total);
+	for (by1 = 0; pick >= row_count[by1]; by1++) {
+		pick -= row_count[by1];
+	}
+	for (i = 0; i < words; i++) {
+		uint32_t bits = fits[by1 * words + i];
+		int n = count_map_bits(bits);
 
-		/* Save the room location */
-		if (dun->cent_n < z_info->level_room_max) {
-			dun->cent[dun->cent_n] = *centre;
-			dun->cent_n++;
+		if (pick >= n) {
+			pick -= n;
+			continue;
+		}
+		for (bx1 = i * ROOM_MAP_BITS; ; bx1++, bits >>= 1) {
+			if ((bits & 1) && !pick--) break;
 		}
+		break;
+	}
+	mem_free(row_count);
+	mem_free(fits);
 
-		reserve_blocks(by1, bx1, by2, bx2);
+	/* Extract bottom right corner block */
+	by2 = by1 + blocks_high - 1;
+	bx2 = bx1 + blocks_wide - 1;
+	assert(check_for_unreserved_blocks(by1, bx1, by2, bx2));
 
-		/* Success. */
-		return (true);
+	/* Get the location of the room */
+	centre->y = ((by1 + by2 + 1) * dun->block_hgt) / 2;
+	centre->x = ((bx1 + bx2 + 1) * dun->block_wid) / 2;
+
+	/* Save the room location */
+	if (dun->cent_n < z_info->level_room_max) {
+		dun->cent[dun->cent_n] = *centre;
+		dun->cent_n++;
 	}
 
-	/* Failure. */
-	return (false);
+	reserve_blocks(by1, bx1, by2, bx2);
+
+	/* Success. */
+	return (true);
 }
 
 /**
  * Build a room template from its string representation.
  * \param c the chunk the room is being built in
  * \param centre the room centre; out of chunk centre invokes find_space()
- * \param ymax the room dimensions
- * \param xmax the room dimensions
- * \param doors the door position
- * \param data the room template text description
- * \param tval the object type for any included objects
- * \param flags the flags for the room
+ * \param room the room template
  * \return success
  */
-static bool build_room_template(struct chunk *c, struct loc centre, int ymax,
-	int xmax, int doors, const char *data, int tval,
-	const bitflag flags[ROOMF_SIZE])
+static bool build_room_template(struct chunk *c, struct loc centre,
+	struct room_template *room)
 {
-	int dx, dy, rnddoors, doorpos;
-	const char *t;
+	int ymax = room->hgt, xmax = room->wid;
+	int i, num, rnddoors, doorpos;
+	const struct room_stamp_grid *grids;
 	bool rndwalls, light;
 	int rotate, txmax, tymax;
 	bool reflect;
@@ -1125,7 +1449,7 @@ static bool build_room_template(struct chunk *c, struct loc centre, int ymax,
 
 	/* Set the random door position here so it generates doors in all squares
 	 * marked with the same number */
-	rnddoors = randint1(doors);
+	rnddoors = randint1(room->dor);
 
 	/* Decide whether optional walls will be generated this time */
 	rndwalls = one_in_(2) ? true : false;
@@ -1153,179 +1477,177 @@ static bool build_room_template(struct chunk *c, struct loc centre, int ymax,
 	centre.y -= tymax / 2;
 
 	/* Place dungeon features, objects, and monsters for specific grids. */
-	for (t = data, dy = 0; dy < ymax && *t; dy++) {
-		for (dx = 0; dx < xmax && *t; dx++, t++) {
-			/* Extract the location */
-			struct loc grid = loc(dx, dy);
-
-			symmetry_transform(&grid, centre.y, centre.x,
-				ymax, xmax, rotate, reflect);
-
-			/* Skip non-grids */
-			if (*t == ' ') continue;
-
-			/* Lay down a floor */
-			square_set_feat(c, grid, FEAT_FLOOR);
-
-			/* Debugging assertion */
-			assert(square_isempty(c, grid));
-
-			/* Analyze the grid */
-			switch (*t) {
-			case '%': {
-				set_marked_granite(c, grid, SQUARE_WALL_OUTER);
-				if (roomf_has(flags, ROOMF_FEW_ENTRANCES)) {
-					append_entrance(grid);
-				}
-				break;
-			}
-			case '#': set_marked_granite(c, grid, SQUARE_WALL_SOLID); break;
-			case '+': place_closed_door(c, grid); break;
-			case '^': if (one_in_(4)) place_trap(c, grid, -1, c->depth); break;
-			case 'x': {
-
-				/* If optional walls are generated, put a wall in this square */
-				if (rndwalls)
-					set_marked_granite(c, grid, SQUARE_WALL_SOLID);
-				break;
+	assert(room->stamp);
+	grids = room->stamp->grids;
+	num = room->stamp->num;
+	for (i = 0; i < num; i++) {
+		/* Extract the location */
+		struct loc grid = loc(grids[i].x, grids[i].y);
+		char sym = grids[i].sym;
+
+		symmetry_transform(&grid, centre.y, centre.x,
+			ymax, xmax, rotate, reflect);
+
+		/* Lay down a floor */
+		square_set_feat(c, grid, FEAT_FLOOR);
+
+		/* Debugging assertion */
+		assert(square_isempty(c, grid));
+
+		/* Analyze the grid */
+		switch (sym) {
+		case '%': {
+			set_marked_granite(c, grid, SQUARE_WALL_OUTER);
+			if (roomf_has(room->flags, ROOMF_FEW_ENTRANCES)) {
+				append_entrance(grid);
 			}
-			case '(': {
-
-				/* If optional walls are generated, put a door in this square */
-				if (rndwalls)
-					place_secret_door(c, grid);
-				break;
-			}
-			case ')': {
-				/* If no optional walls generated, put a door in this square */
-				if (!rndwalls)
-					place_secret_door(c, grid);
-				else
-					set_marked_granite(c, grid, SQUARE_WALL_SOLID);
-				break;
-			}
-			case '8': {
-				/* Put something nice in this square
-				 * Object (80%) or Stairs (20%) */
-				if (randint0(100) < 80 || dun->persist) {
-					place_object(c, grid, c->depth, false, false,
-								 ORIGIN_SPECIAL, 0);
-				} else {
-					place_random_stairs(c, grid, dun->quest);
-				}
-				/* Place nearby guards in second pass. */
-				break;
-			}
-			case '9': {
-				/* Everything is handled in the second pass. */
-				break;
-			}
-			case '[': {
-				
-				/* Place an object of the template's specified tval */
-				place_object(c, grid, c->depth, false, false, ORIGIN_SPECIAL,
-							 tval);
-				break;
-			}
-			case '1':
-			case '2':
-			case '3':
-			case '4':
-			case '5':
-			case '6': {
-				/* Check if this is chosen random door position */
-				doorpos = (int) (*t - '0');
-
-				if (doorpos == rnddoors)
-					place_secret_door(c, grid);
-				else
-					set_marked_granite(c, grid, SQUARE_WALL_SOLID);
+			break;
+		}
+		case '#': set_marked_granite(c, grid, SQUARE_WALL_SOLID); break;
+		case '+': place_closed_door(c, grid); break;
+		case '^': if (one_in_(4)) place_trap(c, grid, -1, c->depth); break;
+		case 'x': {
+
+			/* If optional walls are generated, put a wall in this square */
+			if (rndwalls)
+				set_marked_granite(c, grid, SQUARE_WALL_SOLID);
+			break;
+		}
+		case '(': {
 
-				break;
-			}
+			/* If optional walls are generated, put a door in this square */
+			if (rndwalls)
+				place_secret_door(c, grid);
+			break;
+		}
+		case ')': {
+			/* If no optional walls generated, put a door in this square */
+			if (!rndwalls)
+				place_secret_door(c, grid);
+			else
+				set_marked_granite(c, grid, SQUARE_WALL_SOLID);
+			break;
+		}
+		case '8': {
+			/* Put something nice in this square
+			 * Object (80%) or Stairs (20%) */
+			if (randint0(100) < 80 || dun->persist) {
+				place_object(c, grid, c->depth, false, false,
+							 ORIGIN_SPECIAL, 0);
+			} else {
+				place_random_stairs(c, grid, dun->quest);
 			}
+			/* Place nearby guards in second pass. */
+			break;
+		}
+		case '9': {
+			/* Everything is handled in the second pass. */
+			break;
+		}
+		case '[': {
+			
+			/* Place an object of the template's specified tval */
+			place_object(c, grid, c->depth, false, false, ORIGIN_SPECIAL,
+						 room->tval);
+			break;
+		}
+		case '1':
+		case '2':
+		case '3':
+		case '4':
+		case '5':
+		case '6': {
+			/* Check if this is chosen random door position */
+			doorpos = (int) (sym - '0');
+
+			if (doorpos == rnddoors)
+				place_secret_door(c, grid);
+			else
+				set_marked_granite(c, grid, SQUARE_WALL_SOLID);
 
-			/* Part of a room */
-			sqinfo_on(square(c, grid)->info, SQUARE_ROOM);
-			if (light)
-				sqinfo_on(square(c, grid)->info, SQUARE_GLOW);
+			break;
+		}
 		}
+
+		/* Part of a room */
+		sqinfo_on(square(c, grid)->info, SQUARE_ROOM);
+		if (light)
+			sqinfo_on(square(c, grid)->info, SQUARE_GLOW);
 	}
 	/*
 	 * Perform second pass for placement of monsters and objects at
 	 * unspecified locations after all the features are in place.
 	 */
-	for (t = data, dy = 0; dy < ymax && *t; dy++) {
-		for (dx = 0; dx < xmax && *t; dx++, t++) {
-			/* Extract the location */
-			struct loc grid = loc(dx, dy);
-
-			symmetry_transform(&grid, centre.y, centre.x,
-				ymax, xmax, rotate, reflect);
-
-			/* Analyze the grid. */
-			switch (*t) {
-			case '#':
-				/* Check consistency with first pass. */
-				assert(square_isroom(c, grid) &&
-					square_isgranite(c, grid) &&
-					sqinfo_has(square(c, grid)->info,
-					SQUARE_WALL_SOLID));
-				/*
-				 * Convert to SQUARE_WALL_INNER if it does not
-				 * touch the outside of the room.
-				 */
-				if (count_neighbors(NULL, c, grid,
-						square_isroom, false) == 8) {
-					sqinfo_off(square(c, grid)->info,
-						SQUARE_WALL_SOLID);
-					sqinfo_on(square(c, grid)->info,
-						SQUARE_WALL_INNER);
-				}
-				break;
+	for (i = 0; i < num; i++) {
+		/* Extract the location */
+		struct loc grid = loc(grids[i].x, grids[i].y);
+		char sym = grids[i].sym;
+
+		symmetry_transform(&grid, centre.y, centre.x,
+			ymax, xmax, rotate, reflect);
+
+		/* Analyze the grid. */
+		switch (sym) {
+		case '#':
+			/* Check consistency with first pass. */
+			assert(square_isroom(c, grid) &&
+				square_isgranite(c, grid) &&
+				sqinfo_has(square(c, grid)->info,
+				SQUARE_WALL_SOLID));
+			/*
+			 * Convert to SQUARE_WALL_INNER if it does not
+			 * touch the outside of the room.
+			 */
+			if (count_neighbors(NULL, c, grid,
+					square_isroom, false) == 8) {
+				sqinfo_off(square(c, grid)->info,
+					SQUARE_WALL_SOLID);
+				sqinfo_on(square(c, grid)->info,
+					SQUARE_WALL_INNER);
+			}
+			break;
 
-			case '8':
-				/* Check consistency with first pass. */
-				assert(square_isroom(c, grid) &&
-					(square_isfloor(c, grid) ||
-					square_isstairs(c, grid)));
+		case '8':
+			/* Check consistency with first pass. */
+			assert(square_isroom(c, grid) &&
+				(square_isfloor(c, grid) ||
+				square_isstairs(c, grid)));
 
-				/* Add some monsters to guard it. */
-				vault_monsters(c, grid, c->depth + 2,
-					randint0(2) + 3);
-				break;
+			/* Add some monsters to guard it. */
+			vault_monsters(c, grid, c->depth + 2,
+				randint0(2) + 3);
+			break;
 
-			case '9': {
-				/* Create some interesting stuff nearby. */
-				struct loc off2 = loc(2, -2);
-				struct loc off3 = loc(3, 3);
+		case '9': {
+			/* Create some interesting stuff nearby. */
+			struct loc off2 = loc(2, -2);
+			struct loc off3 = loc(3, 3);
 
-				/* Check consistency with first pass. */
-				assert(square_isroom(c, grid) &&
-					square_isfloor(c, grid));
+			/* Check consistency with first pass. */
+			assert(square_isroom(c, grid) &&
+				square_isfloor(c, grid));
 
-				/* Add a few monsters. */
-				vault_monsters(c, loc_diff(grid, off3),
-					c->depth + randint0(2), randint1(2));
-				vault_monsters(c, loc_sum(grid, off3),
-					c->depth + randint0(2), randint1(2));
+			/* Add a few monsters. */
+			vault_monsters(c, loc_diff(grid, off3),
+				c->depth + randint0(2), randint1(2));
+			vault_monsters(c, loc_sum(grid, off3),
+				c->depth + randint0(2), randint1(2));
 
-				/* And maybe a bit of treasure. */
-				if (one_in_(2)) {
-					vault_objects(c, loc_sum(grid, off2),
-						c->depth, 1 + randint0(2));
-				}
-				if (one_in_(2)) {
-					vault_objects(c, loc_diff(grid, off2),
-						c->depth, 1 + randint0(2));
-				}
-				break;
+			/* And maybe a bit of treasure. */
+			if (one_in_(2)) {
+				vault_objects(c, loc_sum(grid, off2),
+					c->depth, 1 + randint0(2));
 			}
-
-			default:
-				/* Everything was handled in the first pass. */
-				break;
+			if (one_in_(2)) {
+				vault_objects(c, loc_diff(grid, off2),
+					c->depth, 1 + randint0(2));
 			}
+			break;
+		}
+
+		default:
+			/* Everything was handled in the first pass. */
+			break;
 		}
 	}
 
@@ -1350,8 +1672,7 @@ static bool build_room_template_type(struct chunk *c, struct loc centre,
 
 	/* Build the room */
 	event_signal_string(EVENT_GEN_ROOM_CHOOSE_SUBTYPE, room->name);
-	if (!build_room_template(c, centre, room->hgt, room->wid, room->dor,
-			room->text, room->tval, room->flags))
+	if (!build_room_template(c, centre, room))
 		return false;
 
 	ROOM_LOG("Room template (%s)", room->name);
@@ -1368,10 +1689,9 @@ static bool build_room_template_type(struct chunk *c, struct loc centre,
  */
 bool build_vault(struct chunk *c, struct loc centre, struct vault *v)
 {
-	const char *data = v->text;
 	int y1, x1, y2, x2;
-	int x, y, races_local = 0;
-	const char *t;
+	int i, num, races_local = 0;
+	const struct room_stamp_grid *grids;
 	char racial_symbol[30] = "";
 	bool icky;
 	int rotate, thgt, twid;
@@ -1412,292 +1732,287 @@ bool build_vault(struct chunk *c, struct loc centre, struct vault *v)
 	generate_mark(c, y1, x1, y2, x2, SQUARE_MON_RESTRICT);
 
 	/* Place dungeon features and objects */
-	for (t = data, y = 0; y < v->hgt && *t; y++) {
-		for (x = 0; x < v->wid && *t; x++, t++) {
-			struct loc grid = loc(x, y);
-
-			symmetry_transform(&grid, centre.y, centre.x, v->hgt,
-				v->wid, rotate, reflect);
-			assert(grid.x >= x1 && grid.x <= x2 &&
-				grid.y >= y1 && grid.y <= y2);
-
-			/* Skip non-grids */
-			if (*t == ' ') continue;
+	assert(v->stamp);
+	grids = v->stamp->grids;
+	num = v->stamp->num;
+	for (i = 0; i < num; i++) {
+		struct loc grid = loc(grids[i].x, grids[i].y);
+		char sym = grids[i].sym;
+
+		symmetry_transform(&grid, centre.y, centre.x, v->hgt,
+			v->wid, rotate, reflect);
+		assert(grid.x >= x1 && grid.x <= x2 &&
+			grid.y >= y1 && grid.y <= y2);
+
+		/* Lay down a floor */
+		square_set_feat(c, grid, FEAT_FLOOR);
+
+		/* Debugging assertion */
+		assert(square_isempty(c, grid));
+
+		/* By default vault squares are marked icky */
+		icky = true;
+
+		/* Analyze the grid */
+		switch (sym) {
+		case '%': {
+			/* In this case, the square isn't really part
+			 * of the vault, but rather is part of the
+			 * "door step" to the vault. We don't mark it
+			 * icky so that the tunneling code knows it's
+			 * allowed to remove this wall. */
+			set_marked_granite(c, grid, SQUARE_WALL_OUTER);
+			if (roomf_has(v->flags, ROOMF_FEW_ENTRANCES)) {
+				append_entrance(grid);
+			}
+			icky = false;
+			break;
+		}
+			/* Inner or non-tunnelable outside granite wall */
+		case '#': set_marked_granite(c, grid, SQUARE_WALL_SOLID); break;
+			/* Permanent wall */
+		case '@': square_set_feat(c, grid, FEAT_PERM); break;
+			/* Gold seam */
+		case '*': {
+			square_set_feat(c, grid, one_in_(2) ? FEAT_MAGMA_K :
+							FEAT_QUARTZ_K);
+			break;
+		}
+			/* Rubble */
+		case ':': {
+			square_set_feat(c, grid, one_in_(2) ? FEAT_PASS_RUBBLE :
+							FEAT_RUBBLE);
+			break;
+		}
+			/* Secret door */
+		case '+': place_secret_door(c, grid); break;
+			/* Trap */
+		case '^': if (one_in_(4)) place_trap(c, grid, -1, c->depth); break;
+			/* Treasure or a trap */
+		case '&': {
+			if (randint0(100) < 75) {
+				place_object(c, grid, c->depth, false, false, ORIGIN_VAULT,
+							 0);
+			} else if (one_in_(4)) {
+				place_trap(c, grid, -1, c->depth);
+			}
+			break;
+		}
+			/* Stairs */
+		case '<': {
+			if (dun->persist) break;
+			square_set_feat(c, grid, FEAT_LESS); break;
+		}
+		case '>': {
+			if (dun->persist) break;
+			/* No down stairs at bottom or on quests */
+			if (dun->quest || c->depth
+					>= z_info->max_depth - 1) {
+				square_set_feat(c, grid, FEAT_LESS);
+			} else {
+				square_set_feat(c, grid, FEAT_MORE);
+			}
+			break;
+		}
+			/* Lava */
+		case '`': square_set_feat(c, grid, FEAT_LAVA); break;
+			/* Included to allow simple inclusion of FA vaults */
+		case '/': /*square_set_feat(c, grid, FEAT_WATER)*/; break;
+		case ';': /*square_set_feat(c, grid, FEAT_TREE)*/; break;
+		}
 
-			/* Lay down a floor */
-			square_set_feat(c, grid, FEAT_FLOOR);
+		/* Part of a vault */
+		sqinfo_on(square(c, grid)->info, SQUARE_ROOM);
+		if (icky) sqinfo_on(square(c, grid)->info, SQUARE_VAULT);
+	}
 
-			/* Debugging assertion */
-			assert(square_isempty(c, grid));
 
-			/* By default vault squares are marked icky */
-			icky = true;
+	/* Place regular dungeon monsters and objects, convert inner walls */
+	for (i = 0; i < num; i++) {
+		struct loc grid = loc(grids[i].x, grids[i].y);
+		char sym = grids[i].sym;
+
+		symmetry_transform(&grid, centre.y, centre.x, v->hgt,
+			v->wid, rotate, reflect);
+		assert(grid.x >= x1 && grid.x <= x2 &&
+			grid.y >= y1 && grid.y <= y2);
+
+		/* Most alphabetic characters signify monster races. */
+		if (isalpha((unsigned char)sym) && (sym != 'x') && (sym != 'X')) {
+			/* If the symbol is not yet stored, ... */
+			if (!strchr(racial_symbol, sym)) {
+				/* ... store it for later processing. */
+				if (races_local < 30)
+					racial_symbol[races_local++] = sym;
+			}
+		}
 
-			/* Analyze the grid */
-			switch (*t) {
-			case '%': {
-				/* In this case, the square isn't really part
-				 * of the vault, but rather is part of the
-				 * "door step" to the vault. We don't mark it
-				 * icky so that the tunneling code knows it's
-				 * allowed to remove this wall. */
-				set_marked_granite(c, grid, SQUARE_WALL_OUTER);
-				if (roomf_has(v->flags, ROOMF_FEW_ENTRANCES)) {
-					append_entrance(grid);
+		/* Otherwise, analyze the symbol */
+		else
+			switch (sym) {
+				/* An ordinary monster, object (sometimes good), or trap. */
+			case '1': {
+				if (one_in_(2)) {
+					pick_and_place_monster(c, grid, c->depth , true, true,
+										   ORIGIN_DROP_VAULT);
+				} else if (one_in_(2)) {
+					place_object(c, grid, c->depth,
+								 one_in_(8) ? true : false, false,
+								 ORIGIN_VAULT, 0);
+				} else if (one_in_(4)) {
+					place_trap(c, grid, -1, c->depth);
 				}
-				icky = false;
 				break;
 			}
-				/* Inner or non-tunnelable outside granite wall */
-			case '#': set_marked_granite(c, grid, SQUARE_WALL_SOLID); break;
-				/* Permanent wall */
-			case '@': square_set_feat(c, grid, FEAT_PERM); break;
-				/* Gold seam */
-			case '*': {
-				square_set_feat(c, grid, one_in_(2) ? FEAT_MAGMA_K :
-								FEAT_QUARTZ_K);
+				/* Slightly out of depth monster. */
+			case '2': pick_and_place_monster(c, grid, c->depth + 5, true,
+											 true, ORIGIN_DROP_VAULT);
 				break;
-			}
-				/* Rubble */
-			case ':': {
-				square_set_feat(c, grid, one_in_(2) ? FEAT_PASS_RUBBLE :
-								FEAT_RUBBLE);
+				/* Slightly out of depth object. */
+			case '3': place_object(c, grid, c->depth + 3, false, false, 
+								   ORIGIN_VAULT, 0); break;
+				/* Monster and/or object */
+			case '4': {
+				if (one_in_(2))
+					pick_and_place_monster(c, grid, c->depth + 3, true, 
+										   true, ORIGIN_DROP_VAULT);
+				if (one_in_(2))
+					place_object(c, grid, c->depth + 7, false, false,
+								 ORIGIN_VAULT, 0);
 				break;
 			}
-				/* Secret door */
-			case '+': place_secret_door(c, grid); break;
-				/* Trap */
-			case '^': if (one_in_(4)) place_trap(c, grid, -1, c->depth); break;
-				/* Treasure or a trap */
-			case '&': {
-				if (randint0(100) < 75) {
-					place_object(c, grid, c->depth, false, false, ORIGIN_VAULT,
-								 0);
-				} else if (one_in_(4)) {
-					place_trap(c, grid, -1, c->depth);
-				}
+				/* Out of depth object. */
+			case '5': place_object(c, grid, c->depth + 7, false, false,
+								   ORIGIN_VAULT, 0); break;
+				/* Out of depth monster. */
+			case '6': pick_and_place_monster(c, grid, c->depth + 11, true,
+											 true, ORIGIN_DROP_VAULT);
+				break;
+				/* Very out of depth object. */
+			case '7': place_object(c, grid, c->depth + 15, false, false,
+								   ORIGIN_VAULT, 0); break;
+				/* Very out of depth monster. */
+			case '0': pick_and_place_monster(c, grid, c->depth + 20, true,
+											 true, ORIGIN_DROP_VAULT);
+				break;
+				/* Meaner monster, plus treasure */
+			case '9': {
+				pick_and_place_monster(c, grid, c->depth + 9, true, true,
+									   ORIGIN_DROP_VAULT);
+				place_object(c, grid, c->depth + 7, true, false,
+							 ORIGIN_VAULT, 0);
 				break;
 			}
-				/* Stairs */
-			case '<': {
-				if (dun->persist) break;
-				square_set_feat(c, grid, FEAT_LESS); break;
+				/* Nasty monster and treasure */
+			case '8': {
+				pick_and_place_monster(c, grid, c->depth + 40, true, true,
+									   ORIGIN_DROP_VAULT);
+				place_object(c, grid, c->depth + 20, true, true,
+							 ORIGIN_VAULT, 0);
+				break;
 			}
-			case '>': {
-				if (dun->persist) break;
-				/* No down stairs at bottom or on quests */
-				if (dun->quest || c->depth
-						>= z_info->max_depth - 1) {
-					square_set_feat(c, grid, FEAT_LESS);
-				} else {
-					square_set_feat(c, grid, FEAT_MORE);
+				/* A chest. */
+			case '~': place_object(c, grid, c->depth + 5, false, false,
+								   ORIGIN_VAULT, TV_CHEST); break;
+				/* Treasure. */
+			case '$': place_gold(c, grid, c->depth, ORIGIN_VAULT);break;
+				/* Armour. */
+			case ']': {
+				int	tval = 0, temp = one_in_(3) ? randint1(9) : randint1(8);
+				switch (temp) {
+				case 1: tval = TV_BOOTS; break;
+				case 2: tval = TV_GLOVES; break;
+				case 3: tval = TV_HELM; break;
+				case 4: tval = TV_CROWN; break;
+				case 5: tval = TV_SHIELD; break;
+				case 6: tval = TV_CLOAK; break;
+				case 7: tval = TV_SOFT_ARMOR; break;
+				case 8: tval = TV_HARD_ARMOR; break;
+				case 9: tval = TV_DRAG_ARMOR; break;
 				}
+				place_object(c, grid, c->depth + 3, true, false,
+							 ORIGIN_VAULT, tval);
 				break;
 			}
-				/* Lava */
-			case '`': square_set_feat(c, grid, FEAT_LAVA); break;
-				/* Included to allow simple inclusion of FA vaults */
-			case '/': /*square_set_feat(c, grid, FEAT_WATER)*/; break;
-			case ';': /*square_set_feat(c, grid, FEAT_TREE)*/; break;
-			}
-
-			/* Part of a vault */
-			sqinfo_on(square(c, grid)->info, SQUARE_ROOM);
-			if (icky) sqinfo_on(square(c, grid)->info, SQUARE_VAULT);
-		}
-	}
-
-
-	/* Place regular dungeon monsters and objects, convert inner walls */
-	for (t = data, y = 0; y < v->hgt && *t; y++) {
-		for (x = 0; x < v->wid && *t; x++, t++) {
-			struct loc grid = loc(x, y);
-
-			symmetry_transform(&grid, centre.y, centre.x, v->hgt,
-				v->wid, rotate, reflect);
-			assert(grid.x >= x1 && grid.x <= x2 &&
-				grid.y >= y1 && grid.y <= y2);
-
-			/* Skip "non-grids" */
-			if (*t == ' ') continue;
-
-			/* Most alphabetic characters signify monster races. */
-			if (isalpha((unsigned char)*t) && (*t != 'x') && (*t != 'X')) {
-				/* If the symbol is not yet stored, ... */
-				if (!strchr(racial_symbol, *t)) {
-					/* ... store it for later processing. */
-					if (races_local < 30)
-						racial_symbol[races_local++] = *t;
+				/* Weapon. */
+			case '|': {
+				int	tval = 0, temp = randint1(4);
+				switch (temp) {
+				case 1: tval = TV_SWORD; break;
+				case 2: tval = TV_POLEARM; break;
+				case 3: tval = TV_HAFTED; break;
+				case 4: tval = TV_BOW; break;
 				}
+				place_object(c, grid, c->depth + 3, true, false,
+							 ORIGIN_VAULT, tval);
+				break;
 			}
-
-			/* Otherwise, analyze the symbol */
-			else
-				switch (*t) {
-					/* An ordinary monster, object (sometimes good), or trap. */
-				case '1': {
-					if (one_in_(2)) {
-						pick_and_place_monster(c, grid, c->depth , true, true,
-											   ORIGIN_DROP_VAULT);
-					} else if (one_in_(2)) {
-						place_object(c, grid, c->depth,
-									 one_in_(8) ? true : false, false,
-									 ORIGIN_VAULT, 0);
-					} else if (one_in_(4)) {
-						place_trap(c, grid, -1, c->depth);
-					}
-					break;
-				}
-					/* Slightly out of depth monster. */
-				case '2': pick_and_place_monster(c, grid, c->depth + 5, true,
-												 true, ORIGIN_DROP_VAULT);
-					break;
-					/* Slightly out of depth object. */
-				case '3': place_object(c, grid, c->depth + 3, false, false, 
-									   ORIGIN_VAULT, 0); break;
-					/* Monster and/or object */
-				case '4': {
-					if (one_in_(2))
-						pick_and_place_monster(c, grid, c->depth + 3, true, 
-											   true, ORIGIN_DROP_VAULT);
-					if (one_in_(2))
-						place_object(c, grid, c->depth + 7, false, false,
-									 ORIGIN_VAULT, 0);
-					break;
-				}
-					/* Out of depth object. */
-				case '5': place_object(c, grid, c->depth + 7, false, false,
-									   ORIGIN_VAULT, 0); break;
-					/* Out of depth monster. */
-				case '6': pick_and_place_monster(c, grid, c->depth + 11, true,
-												 true, ORIGIN_DROP_VAULT);
-					break;
-					/* Very out of depth object. */
-				case '7': place_object(c, grid, c->depth + 15, false, false,
-									   ORIGIN_VAULT, 0); break;
-					/* Very out of depth monster. */
-				case '0': pick_and_place_monster(c, grid, c->depth + 20, true,
-												 true, ORIGIN_DROP_VAULT);
-					break;
-					/* Meaner monster, plus treasure */
-				case '9': {
-					pick_and_place_monster(c, grid, c->depth + 9, true, true,
-										   ORIGIN_DROP_VAULT);
-					place_object(c, grid, c->depth + 7, true, false,
-								 ORIGIN_VAULT, 0);
-					break;
-				}
-					/* Nasty monster and treasure */
-				case '8': {
-					pick_and_place_monster(c, grid, c->depth + 40, true, true,
-										   ORIGIN_DROP_VAULT);
-					place_object(c, grid, c->depth + 20, true, true,
-								 ORIGIN_VAULT, 0);
-					break;
-				}
-					/* A chest. */
-				case '~': place_object(c, grid, c->depth + 5, false, false,
-									   ORIGIN_VAULT, TV_CHEST); break;
-					/* Treasure. */
-				case '$': place_gold(c, grid, c->depth, ORIGIN_VAULT);break;
-					/* Armour. */
-				case ']': {
-					int	tval = 0, temp = one_in_(3) ? randint1(9) : randint1(8);
-					switch (temp) {
-					case 1: tval = TV_BOOTS; break;
-					case 2: tval = TV_GLOVES; break;
-					case 3: tval = TV_HELM; break;
-					case 4: tval = TV_CROWN; break;
-					case 5: tval = TV_SHIELD; break;
-					case 6: tval = TV_CLOAK; break;
-					case 7: tval = TV_SOFT_ARMOR; break;
-					case 8: tval = TV_HARD_ARMOR; break;
-					case 9: tval = TV_DRAG_ARMOR; break;
-					}
-					place_object(c, grid, c->depth + 3, true, false,
-								 ORIGIN_VAULT, tval);
-					break;
-				}
-					/* Weapon. */
-				case '|': {
-					int	tval = 0, temp = randint1(4);
-					switch (temp) {
-					case 1: tval = TV_SWORD; break;
-					case 2: tval = TV_POLEARM; break;
-					case 3: tval = TV_HAFTED; break;
-					case 4: tval = TV_BOW; break;
-					}
-					place_object(c, grid, c->depth + 3, true, false,
-								 ORIGIN_VAULT, tval);
-					break;
-				}
-					/* Ring. */
-				case '=': place_object(c, grid, c->depth + 3, one_in_(4), false,
-									   ORIGIN_VAULT, TV_RING); break;
-					/* Amulet. */
-				case '"': place_object(c, grid, c->depth + 3, one_in_(4), false,
-									   ORIGIN_VAULT, TV_AMULET); break;
-					/* Potion. */
-				case '!': place_object(c, grid, c->depth + 3, one_in_(4), false,
-									   ORIGIN_VAULT, TV_POTION); break;
-					/* Scroll. */
-				case '?': place_object(c, grid, c->depth + 3, one_in_(4), false,
-									   ORIGIN_VAULT, TV_SCROLL); break;
-					/* Staff. */
-				case '_': place_object(c, grid, c->depth + 3, one_in_(4), false,
-									   ORIGIN_VAULT, TV_STAFF); break;
-					/* Wand or rod. */
-				case '-': place_object(c, grid, c->depth + 3, one_in_(4), false,
-									   ORIGIN_VAULT,
-									   one_in_(2) ? TV_WAND : TV_ROD);
-					break;
-					/* Food or mushroom. */
-				case ',': place_object(c, grid, c->depth + 3, one_in_(4), false,
-									   ORIGIN_VAULT, TV_FOOD); break;
-					/* Inner or non-tunnelable outside granite wall */
-				case '#': {
-					/* Check consistency with first pass. */
-					assert(square_isroom(c, grid) &&
-						square_isvault(c, grid) &&
-						square_isgranite(c, grid) &&
-						sqinfo_has(square(c, grid)->info, SQUARE_WALL_SOLID));
-					/*
-					 * Convert to SQUARE_WALL_INNER if it
-					 * does not touch the outside of the
-					 * vault.
-					 */
-					if (count_neighbors(NULL, c, grid,
-							square_isroom, false) == 8) {
-						sqinfo_off(square(c, grid)->info,
-							SQUARE_WALL_SOLID);
-						sqinfo_on(square(c, grid)->info,
-							SQUARE_WALL_INNER);
-					}
-					break;
-				}
-					/* Permanent wall */
-				case '@': {
-					/* Check consistency with first pass. */
-					assert(square_isroom(c, grid) &&
-						square_isvault(c, grid) &&
-						square_isperm(c, grid));
-					/*
-					 * Mark as SQUARE_WALL_INNER if it does
-					 * not touch the outside of the vault.
-					 */
-					if (count_neighbors(NULL, c, grid,
-							square_isroom, false) == 8) {
-						sqinfo_on(square(c, grid)->info,
-							SQUARE_WALL_INNER);
-					}
-					break;
+				/* Ring. */
+			case '=': place_object(c, grid, c->depth + 3, one_in_(4), false,
+								   ORIGIN_VAULT, TV_RING); break;
+				/* Amulet. */
+			case '"': place_object(c, grid, c->depth + 3, one_in_(4), false,
+								   ORIGIN_VAULT, TV_AMULET); break;
+				/* Potion. */
+			case '!': place_object(c, grid, c->depth + 3, one_in_(4), false,
+								   ORIGIN_VAULT, TV_POTION); break;
+				/* Scroll. */
+			case '?': place_object(c, grid, c->depth + 3, one_in_(4), false,
+								   ORIGIN_VAULT, TV_SCROLL); break;
+				/* Staff. */
+			case '_': place_object(c, grid, c->depth + 3, one_in_(4), false,
+								   ORIGIN_VAULT, TV_STAFF); break;
+				/* Wand or rod. */
+			case '-': place_object(c, grid, c->depth + 3, one_in_(4), false,
+								   ORIGIN_VAULT,
+								   one_in_(2) ? TV_WAND : TV_ROD);
+				break;
+				/* Food or mushroom. */
+			case ',': place_object(c, grid, c->depth + 3, one_in_(4), false,
+								   ORIGIN_VAULT, TV_FOOD); break;
+				/* Inner or non-tunnelable outside granite wall */
+			case '#': {
+				/* Check consistency with first pass. */
+				assert(square_isroom(c, grid) &&
+					square_isvault(c, grid) &&
+					square_isgranite(c, grid) &&
+					sqinfo_has(square(c, grid)->info, SQUARE_WALL_SOLID));
+				/*
+				 * Convert to SQUARE_WALL_INNER if it
+				 * does not touch the outside of the
+				 * vault.
+				 */
+				if (count_neighbors(NULL, c, grid,
+						square_isroom, false) == 8) {
+					sqinfo_off(square(c, grid)->info,
+						SQUARE_WALL_SOLID);
+					sqinfo_on(square(c, grid)->info,
+						SQUARE_WALL_INNER);
 				}
+				break;
+			}
+				/* Permanent wall */
+			case '@': {
+				/* Check consistency with first pass. */
+				assert(square_isroom(c, grid) &&
+					square_isvault(c, grid) &&
+					square_isperm(c, grid));
+				/*
+				 * Mark as SQUARE_WALL_INNER if it does
+				 * not touch the outside of the vault.
+				 */
+				if (count_neighbors(NULL, c, grid,
+						square_isroom, false) == 8) {
+					sqinfo_on(square(c, grid)->info,
+						SQUARE_WALL_INNER);
 				}
-		}
+				break;
+			}
+			}
 	}
 
 	/* Place specified monsters */
-	get_vault_monsters(c, racial_symbol, v->typ, data, y1, y2, x1, x2);
+	get_vault_monsters(c, racial_symbol, v->typ, v->text, y1, y2, x1, x2);
 
 	return true;
 }
@@ -403,6 +403,31 @@ static bool find_start(struct chunk *c, struct loc *grid)
 }
 
 
+/**
+ * Check a level partway through building for anything which would make it
+ * fail anyway.  Every dungeon profile calls this once its rooms or caverns are
+ * in, so that a hopeless attempt is given up before the tunnelling and the
+ * placement of the player, monsters and objects.  The town has a fixed
+ * layout and does not call it.
+ * \param c is the level being built
+ * \param min_rooms is the fewest rooms the level can work with, or 0 for a
+ * level that is not built from rooms
+ * \param p_error is set to the reason if the level is not viable
+ * \return true if building should go on
+ */
+bool level_is_viable(struct chunk *c, int min_rooms, const char **p_error)
+{
+	if (min_rooms > 0 && dun->cent_n < min_rooms) {
+		*p_error = "too few rooms";
+		return false;
+	}
+	if (!c->feat_count[FEAT_FLOOR]) {
+		*p_error = "no floor";
+		return false;
+	}
+	return true;
+}
+
 /**
  * Place the player at a random starting location.
  * \param c current chunk
@@ -448,16 +448,26 @@ static errr run_parse_room(struct parser *p) {
 }
 
 static errr finish_parse_room(struct parser *p) {
+	struct room_template *t;
+
 	room_templates = parser_priv(p);
 	parser_destroy(p);
+
+	/* Compile the layouts and index the templates for selection */
+	for (t = room_templates; t; t = t->next) {
+		t->stamp = room_stamp_new(t->text, t->hgt, t->wid);
+	}
+	index_room_templates(room_templates);
 	return 0;
 }
 
 static void cleanup_room(void)
 {
 	struct room_template *t, *next;
+	free_room_template_index();
 	for (t = room_templates; t; t = next) {
 		next = t->next;
+		room_stamp_free(t->stamp);
 		mem_free(t->name);
 		mem_free(t->text);
 		mem_free(t);
@@ -612,16 +622,26 @@ static errr run_parse_vault(struct parser *p) {
 }
 
 static errr finish_parse_vault(struct parser *p) {
+	struct vault *v;
+
 	vaults = parser_priv(p);
 	parser_destroy(p);
+
+	/* Compile the layouts and index the vaults for selection */
+	for (v = vaults; v; v = v->next) {
+		v->stamp = room_stamp_new(v->text, v->hgt, v->wid);
+	}
+	index_vaults(vaults);
 	return 0;
 }
 
 static void cleanup_vault(void)
 {
 	struct vault *v, *next;
+	free_vault_index();
 	for (v = vaults; v; v = next) {
 		next = v->next;
+		room_stamp_free(v->stamp);
 		mem_free(v->name);
 		mem_free(v->typ);
 		mem_free(v->text);
@@ -1075,6 +1095,23 @@ static void cleanup_dun_data(struct dun_data *dd)
 }
 
 
+/**
+ * Report on one attempt at generating a level.
+ * \param profile is the profile tried
+ * \param reason is why the attempt failed, or NULL if it worked
+ * \param number counts the attempts at this level from zero
+ * \param start is the processor time when the attempt began
+ * \param grids is cave_grids_allocated() when the attempt began
+ */
+static void signal_attempt(const struct cave_profile *profile,
+		const char *reason, int number, clock_t start, long grids)
+{
+	double usec = (double) (clock() - start) * 1000000.0 / CLOCKS_PER_SEC;
+
+	event_signal_attempt(EVENT_GEN_LEVEL_ATTEMPT, profile->name, reason,
+		number, (long) usec, cave_grids_allocated() - grids);
+}
+
 /**
  * Generate a random level.
  *
@@ -1116,6 +1153,8 @@ static struct chunk *cave_generate(struct player *p, int height, int width)
 	for (tries = 0; tries < 100 && error; tries++) {
 		int y, x;
 		struct dun_data dun_body;
+		clock_t start = clock();
+		long grids = cave_grids_allocated();
 
 		error = NULL;
 
@@ -1158,6 +1197,7 @@ static struct chunk *cave_generate(struct player *p, int height, int width)
 			if (OPT(p, cheat_room)) {
 				msg("Generation restarted: %s.", error);
 			}
+			signal_attempt(dun->profile, error, tries, start, grids);
 			cleanup_dun_data(dun);
 			event_signal_flag(EVENT_GEN_LEVEL_END, false);
 			continue;
@@ -1219,7 +1259,10 @@ static struct chunk *cave_generate(struct player *p, int height, int width)
 			}
 			uncreate_artifacts(chunk);
 			cave_clear(chunk, p);
+			signal_attempt(dun->profile, error, tries, start, grids);
 			event_signal_flag(EVENT_GEN_LEVEL_END, false);
+		} else {
+			signal_attempt(dun->profile, NULL, tries, start, grids);
 		}
 
 		cleanup_dun_data(dun);
@@ -1416,6 +1459,10 @@ void prepare_next_level(struct player *p)
 			struct chunk *old_known = chunk_find_name(known_name);
 			assert(old_known);
 
+			/* Restore their grids */
+			chunk_unpack(old_level);
+			chunk_unpack(old_known);
+
 			/* Assign the new ones */
 			cave = old_level;
 			p->cave = old_known;
@@ -1545,6 +1592,9 @@ void prepare_next_level(struct player *p)
 
 	}
 
+	/* Compress everything else that has been stored */
+	chunk_list_pack(cave, p->cave);
+
 	/* The dungeon is ready */
 	character_dungeon = true;
 }
@@ -159,8 +159,8 @@ struct dun_data {
     int row_blocks;
     int col_blocks;
 
-    /*!< Array of which blocks are used */
-    bool **room_map;
+    /*!< Bit map of which blocks are used, see alloc_room_map() */
+    uint32_t **room_map;
 
     /*!< Number of pits/nests on the level */
     int pit_num;
@@ -258,6 +258,20 @@ struct room_profile {
 };
 
 
+/**
+ * A vault or room template layout compiled from its text: the grids which
+ * are not blank, in the order the text has them
+ */
+struct room_stamp_grid {
+    uint8_t x, y;
+    char sym;
+};
+
+struct room_stamp {
+    int num;
+    struct room_stamp_grid *grids;
+};
+
 /*
  * Information about vault generation
  */
@@ -278,6 +292,8 @@ struct vault {
 
     uint8_t min_lev;		/*!< Minimum allowable level, if specified. */
     uint8_t max_lev;		/*!< Maximum allowable level, if specified. */
+
+    struct room_stamp *stamp;	/*!< Compiled layout, made when parsed */
 };
 
 
@@ -301,6 +317,8 @@ struct room_template {
     uint8_t wid;		/*!< Room width */
     uint8_t dor;		/*!< Random door options */
     uint8_t tval;		/*!< tval for objects in this room */
+
+    struct room_stamp *stamp;	/*!< Compiled layout, made when parsed */
 };
 
 /**
@@ -363,6 +381,10 @@ bool chunk_copy(struct chunk *dest, struct player *p, struct chunk *source,
 	 int y0, int x0, int rotate, bool reflect);
 
 void chunk_validate_objects(struct chunk *c);
+bool chunk_is_packed(const struct chunk *c);
+void chunk_pack(struct chunk *c);
+void chunk_unpack(struct chunk *c);
+void chunk_list_pack(const struct chunk *keep1, const struct chunk *keep2);
 
 
 /* gen-room.c */
@@ -376,7 +398,15 @@ extern bool generate_starburst_room(struct chunk *c, int y1, int x1, int y2,
 									int x2, bool light, int feat, 
 									bool special_ok);
 
+void alloc_room_map(void);
+void free_room_map(void);
 struct vault *random_vault(int depth, const char *typ);
+void index_vaults(struct vault *list);
+void free_vault_index(void);
+void index_room_templates(struct room_template *templates);
+void free_room_template_index(void);
+struct room_stamp *room_stamp_new(const char *text, int hgt, int wid);
+void room_stamp_free(struct room_stamp *stamp);
 bool build_vault(struct chunk *c, struct loc centre, struct vault *v);
 
 bool build_staircase(struct chunk *c, struct loc centre, int rating);
@@ -424,6 +454,7 @@ bool find_nearby_grid(struct chunk *c, struct loc *grid, struct loc centre,
 					  int yd, int xd);
 void correct_dir(struct loc *offset, struct loc grid1, struct loc grid2);
 void rand_dir(struct loc *offset);
+bool level_is_viable(struct chunk *c, int min_rooms, const char **p_error);
 bool new_player_spot(struct chunk *c, struct player *p);
 void place_object(struct chunk *c, struct loc grid, int level, bool good,
 	bool great, uint8_t origin, int tval);
@@ -45,6 +45,7 @@
 #include "mon-util.h"
 #include "monster.h"
 #include "obj-chest.h"
+#include "obj-desc.h"
 #include "obj-ignore.h"
 #include "obj-init.h"
 #include "obj-list.h"
@@ -2256,6 +2257,8 @@ static errr finish_parse_feat(struct parser *p) {
 		if (tf_has(f_info[fidx].flags, TF_SHOP)) {
 			f_info[fidx].shopnum = ++shop_idx;
 		}
+		/* Pack the most tested flags for the per-grid copies */
+		f_info[fidx].caps = feat_caps(fidx);
 		/*
 		 * Ensure the prefixes and prepositions end with a space for
 		 * ease of use with the targeting code.
@@ -4431,6 +4434,7 @@ static struct init_module arrays_module = {
 
 extern struct init_module z_quark_module;
 extern struct init_module generate_module;
+extern struct init_module project_module;
 extern struct init_module rune_module;
 extern struct init_module obj_make_module;
 extern struct init_module ignore_module;
@@ -4449,6 +4453,7 @@ static struct init_module *modules[] = {
 	&arrays_module,
 	&player_module,
 	&generate_module,
+	&project_module,
 	&rune_module,
 	&obj_make_module,
 	&ignore_module,
@@ -4510,6 +4515,7 @@ void cleanup_angband(void)
 
 	/* Free the chunk list */
 	for (i = 0; i < chunk_list_max; i++) {
+		chunk_unpack(chunk_list[i]);
 		wipe_mon_list(chunk_list[i], player);
 		cave_free(chunk_list[i]);
 	}
@@ -4531,6 +4537,8 @@ void cleanup_angband(void)
 
 	monster_list_finalize();
 	object_list_finalize();
+	object_cache_free();
+	object_desc_cache_free();
 
 	cleanup_game_constants();
 
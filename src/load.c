@@ -1191,7 +1191,7 @@ int rd_gear(void)
 /**
  * Read store contents
  */
-static int rd_stores_aux(rd_item_t rd_item_version)
+static int rd_stores_aux(rd_item_t rd_item_version, bool days_owed)
 {
 	int i;
 	uint16_t tmp16u;
@@ -1207,14 +1207,17 @@ static int rd_stores_aux(rd_item_t rd_item_version)
 		struct store *store = (i < z_info->store_max) ?
 			 &stores[i] : NULL;
 		uint8_t own, num;
+		uint16_t owed = 0;
 
 		/* Read the basic info */
 		rd_byte(&own);
 		rd_byte(&num);
+		if (days_owed) rd_u16b(&owed);
 
 		/* XXX: refactor into store.c */
 		if (store) {
 			store->owner = store_ownerbyidx(store, own);
+			store->days_owed = (store->feat == FEAT_HOME) ? 0 : owed;
 		}
 
 		/* Read the items */
@@ -1258,7 +1261,8 @@ static int rd_stores_aux(rd_item_t rd_item_version)
 /**
  * Read the stores - wrapper functions
  */
-int rd_stores(void) { return rd_stores_aux(rd_item); }
+int rd_stores(void) { return rd_stores_aux(rd_item, true); }
+int rd_stores_1(void) { return rd_stores_aux(rd_item, false); }
 
 
 /**
@@ -201,8 +201,36 @@ static int bg_color = COLOR_BLACK;
 #define PAIR_CYAN_CYAN 14
 #define PAIR_BLACK_BLACK 15
 
+/**
+ * The color pairs and colors as they were last set, so reacting to changes
+ * only sends the terminal the ones which did change
+ */
+#define PAIR_CACHE_SIZE (2 * BASIC_COLORS)
+static short pair_cache[PAIR_CACHE_SIZE][2];
+static bool pair_cached[PAIR_CACHE_SIZE];
+static short color_cache[BASIC_COLORS][3];
+static bool color_cached[BASIC_COLORS];
+
 #endif
 
+/**
+ * Longest run of cells handed to curses at once
+ */
+#define GCU_RUN_MAX 256
+
+/**
+ * Some term has changes which are waiting for doupdate()
+ */
+static bool update_pending = false;
+
+/**
+ * Report on the output at the end (-F), and what is counted for it
+ */
+static bool frame_stats = false;
+static unsigned long frames = 0;
+static unsigned long cells_drawn = 0;
+static unsigned long long bytes_sent = 0;
+
 /**
  * Place the "keymap" into its "normal" state
  */
@@ -271,6 +299,41 @@ static void keymap_game_prepare(void) {
 }
 
 
+/**
+ * How many bytes the process has written, where the system keeps count
+ */
+static unsigned long long bytes_written(void) {
+	unsigned long long n = 0;
+#ifdef __linux__
+	ang_file *f = file_open("/proc/self/io", MODE_READ, FTYPE_TEXT);
+	char buf[80];
+
+	if (!f) return 0;
+	while (file_getl(f, buf, sizeof(buf))) {
+		if (sscanf(buf, "wchar: %llu", &n) == 1) break;
+	}
+	file_close(f);
+#endif
+	return n;
+}
+
+/**
+ * Send the terminal the changes to every term at once
+ */
+static void gcu_update(void) {
+	unsigned long long before = 0;
+
+	if (!update_pending) return;
+
+	if (frame_stats) before = bytes_written();
+	doupdate();
+	update_pending = false;
+	if (frame_stats) {
+		bytes_sent += bytes_written() - before;
+		frames++;
+	}
+}
+
 /**
  * Suspend/Resume
  */
@@ -291,6 +354,7 @@ static errr Term_xtra_gcu_alive(int v) {
 		Term_xtra(TERM_XTRA_SHAPE, 1);
 
 		/* Flush the curses buffer */
+		gcu_update();
 		refresh();
 
 		/* Get current cursor position */
@@ -334,6 +398,7 @@ const char help_gcu[] = "Text mode, subopts\n"
 	"              -B     Use brighter bold characters\n"
 	"              -D     Use terminal default background color\n"
 	"              -K     Keep terminal's color table when changing colors\n"
+	"              -F     Report the frames and bytes sent to the terminal on exit\n"
 	"              -nN    Use N terminals (up to 6, calculate size automatically. This option cannot be used with below options)\n"
 	"                   To manually set terminal sizes use below options\n"
 	"              -right (dimension)[,dimension]\n"
@@ -626,6 +691,9 @@ static void Term_nuke_gcu(term *t) {
 	/* Count nuke's, handle last */
 	if (--active != 0) return;
 
+	/* Show what is left */
+	gcu_update();
+
 	/* Make sure the cursor is visible */
 	Term_xtra(TERM_XTRA_SHAPE, 1);
 
@@ -789,6 +857,9 @@ static void do_gcu_resize(void) {
 static errr Term_xtra_gcu_event(int v) {
 	int i, j, k, mods=0;
 
+	/* Show the terms before looking for input */
+	gcu_update();
+
 	if (v) {
 		/* Wait for a keypress; use halfdelay(1) so if the user takes more */
 		/* than 0.2 seconds we get a chance to do updates. */
@@ -797,6 +868,7 @@ static errr Term_xtra_gcu_event(int v) {
 		while (i == ERR) {
 			i = getch();
 			idle_update();
+			gcu_update();
 		}
 		cbreak();
 	} else {
@@ -950,6 +1022,41 @@ static errr Term_xtra_gcu_event(int v) {
 	return (0);
 }
 
+#ifdef A_COLOR
+/**
+ * Set a color pair, unless it is already set that way
+ */
+static void gcu_init_pair(int pair, int fg, int bg) {
+	if (pair >= 0 && pair < PAIR_CACHE_SIZE) {
+		if (pair_cached[pair] && pair_cache[pair][0] == fg
+				&& pair_cache[pair][1] == bg) {
+			return;
+		}
+		pair_cached[pair] = true;
+		pair_cache[pair][0] = fg;
+		pair_cache[pair][1] = bg;
+	}
+	init_pair(pair, fg, bg);
+}
+
+/**
+ * Redefine a color, unless it is already defined that way
+ */
+static void gcu_init_color(int i, int r, int g, int b) {
+	if (i >= 0 && i < BASIC_COLORS) {
+		if (color_cached[i] && color_cache[i][0] == r
+				&& color_cache[i][1] == g && color_cache[i][2] == b) {
+			return;
+		}
+		color_cached[i] = true;
+		color_cache[i][0] = r;
+		color_cache[i][1] = g;
+		color_cache[i][2] = b;
+	}
+	init_color(i, r, g, b);
+}
+#endif
+
 static int scale_color(int i, int j, int scale) {
 	return (angband_color_table[i][j] * (scale - 1) + 127) / 255;
 }
@@ -1000,9 +1107,9 @@ static void handle_extended_color_tables(void) {
 			bg_color = create_color(COLOUR_DARK, scale);
 			for (i = 0; i < BASIC_COLORS; i++) {
 				int fg = create_color(i, scale);
-				init_pair(i + 1, fg, bg_color);
+				gcu_init_pair(i + 1, fg, bg_color);
 				colortable[i] = COLOR_PAIR(i + 1) | isbold;
-				init_pair(BASIC_COLORS + i, fg, fg);
+				gcu_init_pair(BASIC_COLORS + i, fg, fg);
 				same_colortable[i] =
 					COLOR_PAIR(BASIC_COLORS + i) | isbold;
 			}
@@ -1013,13 +1120,13 @@ static void handle_extended_color_tables(void) {
 				 * Scale components to a range of 0 - 1000 per
 				 * init_color()'s documentation.
 				 */
-				init_color(i,
+				gcu_init_color(i,
 					(angband_color_table[i][1] * 1001) / 256,
 					(angband_color_table[i][2] * 1001) / 256,
 					(angband_color_table[i][3] * 1001) / 256);
-				init_pair(i + 1, i, bg_color);
+				gcu_init_pair(i + 1, i, bg_color);
 				colortable[i] = COLOR_PAIR(i + 1) | isbold;
-				init_pair(BASIC_COLORS + i, i, i);
+				gcu_init_pair(BASIC_COLORS + i, i, i);
 				same_colortable[i] =
 					COLOR_PAIR(BASIC_COLORS + i) | isbold;
 			}
@@ -1057,16 +1164,19 @@ static errr Term_xtra_gcu(int n, int v) {
 
 	/* Analyze the request */
 	switch (n) {
-		/* Clear screen */
-		case TERM_XTRA_CLEAR: touchwin(td->win); wclear(td->win); return 0;
+		/* Clear screen; curses sends only what differs from before */
+		case TERM_XTRA_CLEAR: werase(td->win); return 0;
 
 		/* Make a noise; beep() has been part of the Curses interface
 		 * since 1984; on systems not capable of an audible warning,
 		 * it may flash the screen */
 		case TERM_XTRA_NOISE: beep(); return 0;
 
-		/* Flush the Curses buffer */
-		case TERM_XTRA_FRESH: wrefresh(td->win); return 0;
+		/* Queue the changes, to be sent with those of the other terms */
+		case TERM_XTRA_FRESH:
+			wnoutrefresh(td->win);
+			update_pending = true;
+			return 0;
 
 #ifdef USE_CURS_SET
 		/* Change the cursor visibility */
@@ -1082,11 +1192,17 @@ static errr Term_xtra_gcu(int n, int v) {
 		/* Flush events */
 		case TERM_XTRA_FLUSH: while (!Term_xtra_gcu_event(false)); return 0;
 
-		/* Delay */
-		case TERM_XTRA_DELAY: if (v > 0) usleep(1000 * v); return 0;
-
-		/* React to events */
-		case TERM_XTRA_REACT: handle_extended_color_tables(); return 0;
+		/* Delay, showing what there is first */
+		case TERM_XTRA_DELAY:
+			gcu_update();
+			if (v > 0) usleep(1000 * v);
+			return 0;
+
+		/* React to events; also repaint the whole screen, as for ^R */
+		case TERM_XTRA_REACT:
+			handle_extended_color_tables();
+			clearok(curscr, true);
+			return 0;
 	}
 
 	/* Unknown event */
@@ -1104,6 +1220,36 @@ static errr Term_curs_gcu(int x, int y) {
 }
 
 
+/**
+ * Put 'n' cells on the screen at once, in the given mode: the text in 's',
+ * or spaces if 's' is NULL
+ */
+static void gcu_put(term_data *td, int x, int y, int n, int mode,
+		const wchar_t *s) {
+	cchar_t cells[GCU_RUN_MAX];
+	attr_t attrs = mode & ~A_COLOR;
+	short pair = PAIR_NUMBER(mode);
+
+	cells_drawn += n;
+	while (n > 0) {
+		int k = MIN(n, GCU_RUN_MAX), i;
+
+		for (i = 0; i < k; i++) {
+			wchar_t wc[2];
+
+			wc[0] = s ? s[i] : L' ';
+			wc[1] = L'\0';
+			setcchar(&cells[i], wc, attrs, pair, NULL);
+		}
+		mvwadd_wchnstr(td->win, y, x, cells, k);
+
+		x += k;
+		n -= k;
+		if (s) s += k;
+	}
+}
+
+
 /**
  * Erase a grid of space
  * Try to be "semi-efficient".
@@ -1111,20 +1257,19 @@ static errr Term_curs_gcu(int x, int y) {
 static errr Term_wipe_gcu(int x, int y, int n) {
 	term_data *td = (term_data *)(Term->data);
 
-	wmove(td->win, y, x);
-
 	if (x + n >= td->t.wid) {
 		/* Clear to end of line */
+		wmove(td->win, y, x);
 		wclrtoeol(td->win);
+		cells_drawn += n;
 	} else {
 		/* Clear some characters */
-		if (can_use_color) {
-			wattrset(td->win, colortable[COLOUR_DARK] | A_NORMAL);
-		}
-		whline(td->win, ' ', n);
-		if (can_use_color) {
-			wattrset(td->win, A_NORMAL);
-		}
+		int mode = A_NORMAL;
+
+#ifdef A_COLOR
+		if (can_use_color) mode = colortable[COLOUR_DARK] | A_NORMAL;
+#endif
+		gcu_put(td, x, y, n, mode, NULL);
 	}
 
 	return 0;
@@ -1136,6 +1281,7 @@ static errr Term_wipe_gcu(int x, int y, int n) {
  */
 static errr Term_text_gcu(int x, int y, int n, int a, const wchar_t *s) {
 	term_data *td = (term_data *)(Term->data);
+	int mode = A_NORMAL;
 
 #ifdef A_COLOR
 	if (can_use_color) {
@@ -1156,22 +1302,17 @@ static errr Term_text_gcu(int x, int y, int n, int a, const wchar_t *s) {
 		}
 
 		/* the following check for A_BRIGHT is to avoid #1813 */
-		int mode;
 		if (reversed && (color & A_BRIGHT))
 			mode = (color & ~A_BRIGHT) | A_BLINK | A_REVERSE;
 		else if (reversed)
 			mode = color | A_REVERSE;
 		else
 			mode = color | A_NORMAL;
-
-		wattrset(td->win, mode);
-		mvwaddnwstr(td->win, y, x, s, n);
-		wattrset(td->win, A_NORMAL);
-		return 0;
 	}
 #endif
 
-	mvwaddnwstr(td->win, y, x, s, n);
+	/* The whole run at once, attributes and all */
+	gcu_put(td, x, y, n, mode, s);
 	return 0;
 }
 
@@ -1272,6 +1413,13 @@ static void hook_quit(const char *str) {
 		}
 	}
 	endwin();
+
+	/* Report on the output */
+	if (frame_stats && frames) {
+		fprintf(stderr, "%lu frames, %lu cells drawn, %llu bytes sent "
+			"(%llu a frame)\n", frames, cells_drawn, bytes_sent,
+			bytes_sent / frames);
+	}
 }
 
 /**
@@ -1297,6 +1445,8 @@ errr init_gcu(int argc, char **argv) {
 			use_default_background = true;
 		} else if (streq(argv[i], "-K")) {
 			keep_terminal_colors = true;
+		} else if (streq(argv[i], "-F")) {
+			frame_stats = true;
 		}
 	}
 
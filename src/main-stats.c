@@ -42,6 +42,7 @@
 #include "stats/db.h"
 #include "stats/structs.h"
 #include "store.h"
+#include "wizard.h"
 #include <stddef.h>
 #include <time.h>
 
@@ -141,6 +142,27 @@ static uint32_t num_runs = 1;
 static bool quiet = false;
 static int nextkey = 0;
 static int running_stats = 0;
+
+/**
+ * Level generation statistics (from wiz-stats.c) that -g can run instead of
+ * the database run
+ */
+static const struct {
+	const char *name;
+	int simtype;	/**< stats_collect() simulation type, or 0 */
+	int pittype;	/**< pit_stats() pit type, or 0 */
+} gen_stats_kinds[] = {
+	{ "dive", 1, 0 },
+	{ "clear", 2, 0 },
+	{ "regen", 3, 0 },
+	{ "disconnect", 0, 0 },
+	{ "pit", 0, 1 },
+	{ "nest", 0, 2 },
+	{ "other", 0, 3 },
+};
+static int gen_stats = -1;
+static int gen_depth = 0;
+static int num_workers = 1;
 static char *ANGBAND_DIR_STATS;
 
 static int *consumables_index;
@@ -1803,6 +1825,41 @@ static errr run_stats(void)
 	exit(0);
 }
 
+/**
+ * Run the level generation statistics selected by -g and exit.
+ */
+static errr run_gen_stats(void)
+{
+	int simtype = gen_stats_kinds[gen_stats].simtype;
+	int pittype = gen_stats_kinds[gen_stats].pittype;
+
+	initialize_character();
+	stats_set_workers(num_workers);
+	if (!quiet) {
+		printf("Beginning %lu %s simulations with %d worker%s...\n",
+			(unsigned long) num_runs, gen_stats_kinds[gen_stats].name, num_workers,
+			PLURAL(num_workers));
+		fflush(stdout);
+	}
+
+	if (simtype) {
+		stats_collect(num_runs, simtype);
+	} else if (pittype) {
+		pit_stats(num_runs, pittype, gen_depth ? gen_depth : 1,
+			gen_depth ? gen_depth : z_info->max_depth - 1);
+	} else {
+		player->depth = gen_depth ?
+			MIN(gen_depth, z_info->max_depth - 1) : 1;
+		disconnect_stats(num_runs, false);
+	}
+
+	if (!quiet) printf("Done!  The results are in %s.\n", ANGBAND_DIR_USER);
+	stats_cleanup_angband_run();
+	cleanup_angband();
+	quit(NULL);
+	exit(0);
+}
+
 typedef struct term_data term_data;
 struct term_data {
 	term t;
@@ -1851,7 +1908,7 @@ static errr term_xtra_event(int v) {
 		return 0;
 	}
 	running_stats = 1;
-	return run_stats();
+	return (gen_stats >= 0) ? run_gen_stats() : run_stats();
 }
 
 static errr term_xtra_flush(int v) {
@@ -1925,17 +1982,26 @@ static void term_data_link(int i) {
 	angband_term[i] = t;
 }
 
-const char help_stats[] = "Stats mode, subopts -q(uiet) -r(andarts) -n(# of runs) -s(no selling)";
+const char help_stats[] = "Stats mode, subopts -q(uiet) -r(andarts) -n(# of runs) -s(no selling)\n"
+	"              -g(eneration stats) -j(# of workers) -d(epth)";
 
 /**
  * Usage:
  *
- * angband -mstats -- [-q] [-r] [-nNNNN] [-s]
+ * angband -mstats -- [-q] [-r] [-nNNNN] [-s] [-gKIND [-jNN] [-dNN]]
  *
  *   -q      Quiet mode (turn off progress messages)
  *   -r      Turn on randarts
  *   -nNNNN  Make NNNN runs through the dungeon (default: 1)
  *   -s      Turn on no-selling
+ *   -gKIND  Instead of the database run, collect the level generation
+ *           statistics also available from the debug commands; KIND is
+ *           dive, clear or regen (object and monster statistics), disconnect
+ *           (connectivity and generation statistics) or pit, nest or other
+ *           (room profile choices).  The results go in the user directory.
+ *   -jNN    Split the -g runs across NN worker processes (default: 1)
+ *   -dNN    Depth for -g disconnect (default: 1) or the only depth for
+ *           -g pit, nest or other (default: all)
  */
 
 errr init_stats(int argc, char *argv[]) {
@@ -1959,6 +2025,28 @@ errr init_stats(int argc, char *argv[]) {
 			no_selling = 1;
 			continue;
 		}
+		if (prefix(argv[i], "-g")) {
+			size_t j;
+
+			for (j = 0; j < N_ELEMENTS(gen_stats_kinds); j++) {
+				if (streq(&argv[i][2], gen_stats_kinds[j].name)) {
+					gen_stats = j;
+				}
+			}
+			if (gen_stats < 0) {
+				printf("init-stats: unknown statistics '%s'\n",
+					&argv[i][2]);
+			}
+			continue;
+		}
+		if (prefix(argv[i], "-j")) {
+			num_workers = MAX(1, atoi(&argv[i][2]));
+			continue;
+		}
+		if (prefix(argv[i], "-d")) {
+			gen_depth = MAX(0, atoi(&argv[i][2]));
+			continue;
+		}
 		printf("init-stats: bad argument '%s'\n", argv[i]);
 	}
 
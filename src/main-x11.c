@@ -112,6 +112,9 @@
 #include <X11/keysym.h>
 #include <X11/keysymdef.h>
 #include <X11/XKBlib.h>
+#ifdef USE_XRENDER
+#include <X11/extensions/Xrender.h>
+#endif
 
 #include "main.h"
 
@@ -286,6 +289,11 @@ struct metadpy
  *	- The width, height of the window
  *	- The border width of this window
  *
+ *	- The off-screen copy of the window that is drawn into (or None)
+ *	- The size of that copy
+ *	- The XRender picture for that copy (if using XRender)
+ *	- The part of that copy changed since it was last shown
+ *
  *	- Byte: 1st Extra byte
  *
  *	- Bit Flag: This window is currently Mapped
@@ -311,6 +319,13 @@ struct infowin
 	int16_t w, h;
 	uint16_t b;
 
+	Pixmap back;
+	int16_t back_w, back_h;
+#ifdef USE_XRENDER
+	Picture back_pict;
+#endif
+	int16_t dirty_x1, dirty_y1, dirty_x2, dirty_y2;
+
 	uint8_t byte1;
 
 	unsigned int mapped:1;
@@ -356,6 +371,14 @@ struct infoclr
 
 
 
+#ifdef USE_XRENDER
+/**
+ * Glyph sets are indexed by code point, so cover all of Unicode
+ */
+#define GLYPH_PAGES (0x110000 / 256)
+#endif
+
+
 /**
  * A Structure to Hold Font Information
  *
@@ -369,6 +392,9 @@ struct infoclr
  *
  *	- Byte: Pixel offset used during fake mono
  *
+ *	- The XRender glyph set made from the font (if using XRender)
+ *	- Which characters that glyph set has, in pages of 256 bits
+ *
  *	- Flag: Force monospacing via 'wid'
  *	- Flag: Nuke info when done
  */
@@ -385,12 +411,32 @@ struct infofnt
 
 	uint8_t off;
 
+#ifdef USE_XRENDER
+	GlyphSet gs;
+	uint32_t *loaded[GLYPH_PAGES];
+#endif
+
 	unsigned int mono:1;
 	unsigned int nuke:1;
 };
 
 
 
+#ifdef USE_XRENDER
+/**
+ * A run of text (or, with no glyphs, of blank space) waiting to be drawn
+ */
+struct text_run
+{
+	int16_t x, y;
+	int16_t n;
+	int16_t len;
+	int a;
+	int first;
+};
+#endif
+
+
 /**
  * Forward declare
  */
@@ -414,6 +460,18 @@ struct term_data
 	/* Pointers to allocated data, needed to clear up memory */
 	XClassHint *classh;
 	XSizeHints *sizeh;
+
+#ifdef USE_XRENDER
+	/* Runs drawn since the last frame, and their glyphs */
+	struct text_run *runs;
+	int run_count, run_alloc;
+	unsigned int *glyphs;
+	int glyph_count, glyph_alloc;
+#endif
+
+	/* Protocol requests made in each frame */
+	unsigned long frame_start;
+	unsigned long frames, requests, max_requests;
 };
 
 
@@ -436,6 +494,10 @@ struct term_data
 #define Infowin_set(I) \
 	(Infowin = (I))
 
+/* Where to draw for the current Infowin: its off-screen copy if it has one */
+#define Infowin_drawable() \
+	((Infowin->back != None) ? Infowin->back : Infowin->win)
+
 
 /* Set the current Infoclr */
 #define Infoclr_set(C) \
@@ -480,6 +542,12 @@ static infofnt *Infofnt = (infofnt*)(NULL);
 static infoclr *clr[MAX_COLORS * BG_MAX];
 
 
+/*
+ * Copying from the off-screen windows, without asking for exposures
+ */
+static GC back_gc = (GC)(NULL);
+
+
 
 /**
  * ------------------------------------------------------------------------
@@ -800,6 +868,18 @@ static errr Infowin_nuke(void)
 {
 	infowin *iwin = Infowin;
 
+	/* Free the off-screen copy */
+#ifdef USE_XRENDER
+	if (iwin->back_pict != None) {
+		XRenderFreePicture(Metadpy->dpy, iwin->back_pict);
+		iwin->back_pict = None;
+	}
+#endif
+	if (iwin->back != None) {
+		XFreePixmap(Metadpy->dpy, iwin->back);
+		iwin->back = None;
+	}
+
 	/* Nuke if requested */
 	if (iwin->nuke) {
 		/* Destory the old window */
@@ -1041,11 +1121,131 @@ static errr Infowin_locate(int x, int y, int w, int h)
 #endif /* IGNORE_UNUSED_FUNCTIONS */
 
 
+/**
+ * Note that part of the off-screen copy of Infowin has changed
+ */
+static void Infowin_note(int x, int y, int w, int h)
+{
+	infowin *iwin = Infowin;
+
+	if (iwin->dirty_x1 >= iwin->dirty_x2) {
+		iwin->dirty_x1 = x;
+		iwin->dirty_y1 = y;
+		iwin->dirty_x2 = x + w;
+		iwin->dirty_y2 = y + h;
+	} else {
+		if (x < iwin->dirty_x1) iwin->dirty_x1 = x;
+		if (y < iwin->dirty_y1) iwin->dirty_y1 = y;
+		if (x + w > iwin->dirty_x2) iwin->dirty_x2 = x + w;
+		if (y + h > iwin->dirty_y2) iwin->dirty_y2 = y + h;
+	}
+}
+
+
+/**
+ * Give Infowin an off-screen copy to draw into, or resize the one it has,
+ * keeping what was drawn.  The copy is shown a frame at a time, so the
+ * window neither flickers nor shows half drawn turns.
+ */
+static errr Infowin_back_resize(void)
+{
+	infowin *iwin = Infowin;
+	Pixmap back;
+	int w = MAX(iwin->w, 1);
+	int h = MAX(iwin->h, 1);
+
+	/* Nothing to do */
+	if (iwin->back != None && iwin->back_w == w && iwin->back_h == h)
+		return (0);
+
+	/* Copy without being sent exposures */
+	if (!back_gc) {
+		XGCValues gcv;
+
+		gcv.graphics_exposures = False;
+		back_gc = XCreateGC(Metadpy->dpy, Metadpy->root,
+			GCGraphicsExposures, &gcv);
+	}
+
+	/* Start out clear, then keep what the old copy had */
+	back = XCreatePixmap(Metadpy->dpy, iwin->win, w, h, Metadpy->depth);
+	XFillRectangle(Metadpy->dpy, back, clr[COLOUR_DARK]->gc, 0, 0, w, h);
+	if (iwin->back != None) {
+		XCopyArea(Metadpy->dpy, iwin->back, back, back_gc, 0, 0,
+			MIN(w, iwin->back_w), MIN(h, iwin->back_h), 0, 0);
+#ifdef USE_XRENDER
+		if (iwin->back_pict != None) {
+			XRenderFreePicture(Metadpy->dpy, iwin->back_pict);
+		}
+#endif
+		XFreePixmap(Metadpy->dpy, iwin->back);
+	}
+	iwin->back = back;
+	iwin->back_w = w;
+	iwin->back_h = h;
+#ifdef USE_XRENDER
+	iwin->back_pict = None;
+#endif
+
+	/* Show it all next time */
+	Infowin_note(0, 0, w, h);
+
+	/* Success */
+	return (0);
+}
+
+
+/**
+ * Copy part of the off-screen copy of Infowin to the window
+ */
+static errr Infowin_show(int x, int y, int w, int h)
+{
+	infowin *iwin = Infowin;
+
+	if (iwin->back == None) return (1);
+
+	XCopyArea(Metadpy->dpy, iwin->back, iwin->win, back_gc, x, y, w, h,
+		x, y);
+
+	/* Success */
+	return (0);
+}
+
+
+/**
+ * Show whatever has changed in the off-screen copy of Infowin since it was
+ * last shown
+ */
+static errr Infowin_show_dirty(void)
+{
+	infowin *iwin = Infowin;
+
+	if (iwin->dirty_x1 < iwin->dirty_x2 && iwin->dirty_y1 < iwin->dirty_y2) {
+		Infowin_show(iwin->dirty_x1, iwin->dirty_y1,
+			iwin->dirty_x2 - iwin->dirty_x1,
+			iwin->dirty_y2 - iwin->dirty_y1);
+	}
+	iwin->dirty_x1 = iwin->dirty_x2 = 0;
+	iwin->dirty_y1 = iwin->dirty_y2 = 0;
+
+	/* Success */
+	return (0);
+}
+
+
 /**
  * Visually clear Infowin
  */
 static errr Infowin_wipe(void)
 {
+	/* Clear the copy, to be shown with the rest of the frame */
+	if (Infowin->back != None) {
+		XFillRectangle(Metadpy->dpy, Infowin->back, clr[COLOUR_DARK]->gc,
+			0, 0, Infowin->back_w, Infowin->back_h);
+		Infowin_note(0, 0, Infowin->back_w, Infowin->back_h);
+		return (0);
+	}
+
 	/* Execute the request */
 	XClearWindow(Metadpy->dpy, Infowin->win);
 
@@ -1380,6 +1580,20 @@ static errr Infofnt_nuke(void)
 		XFreeFontSet(Metadpy->dpy, ifnt->fs);
 	}
 
+#ifdef USE_XRENDER
+	/* Free the glyphs made from it */
+	if (ifnt->gs != None) {
+		int i;
+
+		XRenderFreeGlyphSet(Metadpy->dpy, ifnt->gs);
+		ifnt->gs = None;
+		for (i = 0; i < GLYPH_PAGES; i++) {
+			mem_free(ifnt->loaded[i]);
+			ifnt->loaded[i] = NULL;
+		}
+	}
+#endif
+
 	/* Success */
 	return (0);
 }
@@ -1505,8 +1719,9 @@ static errr Infofnt_text_std(int x, int y, const wchar_t *str, int len)
 	h = td->tile_hgt;
 
 	/* Fill the background */
-	XFillRectangle(Metadpy->dpy, Infowin->win, clr[COLOUR_DARK]->gc,
+	XFillRectangle(Metadpy->dpy, Infowin_drawable(), clr[COLOUR_DARK]->gc,
 				   x, y, w, h);
+	Infowin_note(x, y, w, h);
 
 
 	/*** Actually draw 'str' onto the infowin ***/
@@ -1520,14 +1735,14 @@ static errr Infofnt_text_std(int x, int y, const wchar_t *str, int len)
 		/* Do each character */
 		for (i = 0; i < len; ++i) {
 			/* Note that the Infoclr is set up to contain the Infofnt */
-			XwcDrawImageString(Metadpy->dpy, Infowin->win, Infofnt->fs,
+			XwcDrawImageString(Metadpy->dpy, Infowin_drawable(), Infofnt->fs,
 							   Infoclr->gc, x + i * td->tile_wid + Infofnt->off,
 							   y, str + i, 1);
 		}
 	} else {
 		/* Note that the Infoclr is set up to contain the Infofnt */
-		XwcDrawImageString(Metadpy->dpy, Infowin->win, Infofnt->fs, Infoclr->gc,
-		                 x, y, str, len);
+		XwcDrawImageString(Metadpy->dpy, Infowin_drawable(), Infofnt->fs,
+		                 Infoclr->gc, x, y, str, len);
 	}
 
 	/* Success */
@@ -1568,7 +1783,8 @@ static errr Infofnt_text_non(int x, int y, const wchar_t *str, int len)
 	/*** Actually 'paint' the area ***/
 
 	/* Just do a Fill Rectangle */
-	XFillRectangle(Metadpy->dpy, Infowin->win, Infoclr->gc, x, y, w, h);
+	XFillRectangle(Metadpy->dpy, Infowin_drawable(), Infoclr->gc, x, y, w, h);
+	Infowin_note(x, y, w, h);
 
 	/* Success */
 	return (0);
@@ -1597,6 +1813,25 @@ static infoclr *xor;
 static uint8_t color_table_x11[MAX_COLORS][4];
 
 
+#ifdef USE_XRENDER
+/**
+ * Whether text is drawn a frame at a time through XRender glyph sets
+ */
+static bool use_xrender = false;
+
+/**
+ * Solid XRender sources for each color, made as needed
+ */
+static Picture fill_pict[MAX_COLORS];
+#endif
+
+
+/**
+ * Whether to report how many requests each window's frames took
+ */
+static bool frame_stats = false;
+
+
 /**
  * The number of term data structures
  */
@@ -1863,6 +2098,12 @@ static errr CheckEvent(bool wait)
 		{
 			int x1, x2, y1, y2;
 
+			/* Show it again from the off-screen copy */
+			if (!Infowin_show(xev->xexpose.x, xev->xexpose.y,
+					xev->xexpose.width, xev->xexpose.height)) {
+				break;
+			}
+
 			x1 = (xev->xexpose.x - Infowin->ox) / td->tile_wid;
 			x2 = (xev->xexpose.x + xev->xexpose.width - Infowin->ox) /
 				td->tile_wid;
@@ -1904,6 +2145,9 @@ static errr CheckEvent(bool wait)
 			Infowin->w = xev->xconfigure.width;
 			Infowin->h = xev->xconfigure.height;
 
+			/* Resize the off-screen copy to match */
+			Infowin_back_resize();
+
 			/* Determine "proper" number of rows/cols */
 			cols = ((Infowin->w - (ox + ox)) / td->tile_wid);
 			rows = ((Infowin->h - (oy + oy)) / td->tile_hgt);
@@ -1954,6 +2198,261 @@ static errr CheckEvent(bool wait)
 }
 
 
+#ifdef USE_XRENDER
+
+/**
+ * Find the glyph for 'ch' in the glyph set made from the term's font,
+ * drawing it with the core font the first time it is asked for.  That
+ * takes a round trip, but only once for each character.
+ */
+static unsigned int xrender_glyph(term_data *td, wchar_t ch)
+{
+	infofnt *ifnt = td->fnt;
+	uint32_t g = (uint32_t) ch;
+	uint32_t **page;
+	int w = td->tile_wid, h = td->tile_hgt, stride = (w + 3) & ~3;
+	wchar_t wc;
+	Pixmap pix;
+	GC gc;
+	XImage *image;
+	XGlyphInfo info;
+	Glyph gid;
+	char *bits;
+	int x, y;
+
+	/* Not a character */
+	if (g >= GLYPH_PAGES * 256) g = '?';
+
+	/* Already made */
+	page = &ifnt->loaded[g / 256];
+	if (*page && ((*page)[(g % 256) / 32] & (1U << (g % 32)))) return g;
+
+	if (ifnt->gs == None) {
+		ifnt->gs = XRenderCreateGlyphSet(Metadpy->dpy,
+			XRenderFindStandardFormat(Metadpy->dpy, PictStandardA8));
+	}
+	if (!*page) *page = mem_zalloc(256 / 8);
+
+	/* Draw the character into a grid sized coverage mask */
+	wc = (wchar_t) g;
+	pix = XCreatePixmap(Metadpy->dpy, Metadpy->root, w, h, 8);
+	gc = XCreateGC(Metadpy->dpy, pix, 0, NULL);
+	XSetForeground(Metadpy->dpy, gc, 0);
+	XFillRectangle(Metadpy->dpy, pix, gc, 0, 0, w, h);
+	XSetForeground(Metadpy->dpy, gc, 0xff);
+	XwcDrawString(Metadpy->dpy, pix, ifnt->fs, gc, ifnt->off, ifnt->asc,
+		&wc, 1);
+
+	/* Glyph images have their rows padded to 32 bits */
+	bits = mem_zalloc(stride * h);
+	image = XGetImage(Metadpy->dpy, pix, 0, 0, w, h, AllPlanes, ZPixmap);
+	if (image) {
+		for (y = 0; y < h; y++) {
+			for (x = 0; x < w; x++) {
+				bits[y * stride + x] = (char) XGetPixel(image, x, y);
+			}
+		}
+		XDestroyImage(image);
+	}
+	XFreeGC(Metadpy->dpy, gc);
+	XFreePixmap(Metadpy->dpy, pix);
+
+	/* The origin is on the baseline at the left of the grid */
+	info.width = w;
+	info.height = h;
+	info.x = 0;
+	info.y = ifnt->asc;
+	info.xOff = w;
+	info.yOff = 0;
+	gid = g;
+	XRenderAddGlyphs(Metadpy->dpy, ifnt->gs, &gid, &info, 1, bits,
+		stride * h);
+	mem_free(bits);
+
+	(*page)[(g % 256) / 32] |= 1U << (g % 32);
+	return g;
+}
+
+
+/**
+ * Queue a run of text, or of blank space if 's' is NULL, for the frame
+ */
+static void xrender_queue(term_data *td, int x, int y, int n, int a,
+		const wchar_t *s)
+{
+	struct text_run *run;
+	int i;
+
+	if (td->run_count == td->run_alloc) {
+		td->run_alloc = td->run_alloc ? td->run_alloc * 2 : 64;
+		td->runs = mem_realloc(td->runs,
+			td->run_alloc * sizeof(*td->runs));
+	}
+	if (s && td->glyph_count + n > td->glyph_alloc) {
+		while (td->glyph_count + n > td->glyph_alloc) {
+			td->glyph_alloc = td->glyph_alloc ?
+				td->glyph_alloc * 2 : 256;
+		}
+		td->glyphs = mem_realloc(td->glyphs,
+			td->glyph_alloc * sizeof(*td->glyphs));
+	}
+
+	run = &td->runs[td->run_count++];
+	run->x = x;
+	run->y = y;
+	run->n = n;
+	run->a = a;
+	run->first = td->glyph_count;
+	run->len = s ? n : 0;
+	for (i = 0; i < run->len; i++) {
+		td->glyphs[td->glyph_count++] = xrender_glyph(td, s[i]);
+	}
+}
+
+
+/**
+ * The color of the text in a run, or of its background
+ */
+static int xrender_color(const struct text_run *run, bool bg)
+{
+	if (!bg) return run->a % MAX_COLORS;
+
+	switch (run->a / MULT_BG)
+	{
+		case BG_SAME: return run->a % MAX_COLORS;
+		case BG_DARK: return COLOUR_SHADE;
+	}
+	return COLOUR_DARK;
+}
+
+
+/**
+ * Order the queued runs by the color of their text or background; the
+ * runs with color 'c' are then 'order[start[c]]' on for 'count[c]'
+ */
+static void xrender_sort(term_data *td, int *order, int *count, int *start,
+		bool bg)
+{
+	int next[MAX_COLORS];
+	int i, c;
+
+	for (c = 0; c < MAX_COLORS; c++) count[c] = 0;
+	for (i = 0; i < td->run_count; i++) {
+		count[xrender_color(&td->runs[i], bg)]++;
+	}
+	for (c = 0; c < MAX_COLORS; c++) {
+		start[c] = c ? start[c - 1] + count[c - 1] : 0;
+		next[c] = start[c];
+	}
+	for (i = 0; i < td->run_count; i++) {
+		order[next[xrender_color(&td->runs[i], bg)]++] = i;
+	}
+}
+
+
+/**
+ * The solid source for drawing in a color
+ */
+static Picture xrender_fill(int c)
+{
+	if (fill_pict[c] == None) {
+		XRenderColor col;
+
+		col.red = color_table_x11[c][1] * 0x101;
+		col.green = color_table_x11[c][2] * 0x101;
+		col.blue = color_table_x11[c][3] * 0x101;
+		col.alpha = 0xffff;
+		fill_pict[c] = XRenderCreateSolidFill(Metadpy->dpy, &col);
+	}
+	return fill_pict[c];
+}
+
+
+/**
+ * Draw the runs queued for the frame into the off-screen copy of the
+ * window: the backgrounds with a request for each color, then the text
+ * over them with a request for each color.  Term_fresh() draws each grid
+ * at most once a frame, and the cursor is drawn after the runs, so the
+ * order of the runs does not matter.
+ */
+static void xrender_flush(term_data *td)
+{
+	infowin *iwin = td->win;
+	int count[MAX_COLORS], start[MAX_COLORS];
+	int *order;
+	XRectangle *rects;
+	XGlyphElt32 *elts;
+	int i, c;
+
+	if (!td->run_count) return;
+
+	if (iwin->back_pict == None) {
+		iwin->back_pict = XRenderCreatePicture(Metadpy->dpy, iwin->back,
+			XRenderFindVisualFormat(Metadpy->dpy,
+			DefaultVisualOfScreen(Metadpy->screen)), 0, NULL);
+	}
+
+	order = mem_alloc(td->run_count * sizeof(*order));
+	rects = mem_alloc(td->run_count * sizeof(*rects));
+	elts = mem_alloc(td->run_count * sizeof(*elts));
+
+	/* Backgrounds */
+	xrender_sort(td, order, count, start, true);
+	for (c = 0; c < MAX_COLORS; c++) {
+		if (!count[c]) continue;
+		for (i = 0; i < count[c]; i++) {
+			const struct text_run *run = &td->runs[order[start[c] + i]];
+
+			rects[i].x = run->x * td->tile_wid + iwin->ox;
+			rects[i].y = run->y * td->tile_hgt + iwin->oy;
+			rects[i].width = run->n * td->tile_wid;
+			rects[i].height = td->tile_hgt;
+			Infowin_note(rects[i].x, rects[i].y, rects[i].width,
+				rects[i].height);
+		}
+		XFillRectangles(Metadpy->dpy, iwin->back, clr[c]->gc, rects,
+			count[c]);
+	}
+
+	/* Text, each run placed relative to where the last one ended */
+	xrender_sort(td, order, count, start, false);
+	for (c = 0; c < MAX_COLORS; c++) {
+		int k = 0, pen_x = 0, pen_y = 0;
+
+		for (i = 0; i < count[c]; i++) {
+			const struct text_run *run = &td->runs[order[start[c] + i]];
+			int x = run->x * td->tile_wid + iwin->ox;
+			int y = run->y * td->tile_hgt + iwin->oy + td->fnt->asc;
+
+			/* Blank, or the same color as its background */
+			if (!run->len || run->a / MULT_BG == BG_SAME) continue;
+
+			elts[k].glyphset = td->fnt->gs;
+			elts[k].chars = &td->glyphs[run->first];
+			elts[k].nchars = run->len;
+			elts[k].xOff = x - pen_x;
+			elts[k].yOff = y - pen_y;
+			pen_x = x + run->len * td->tile_wid;
+			pen_y = y;
+			k++;
+		}
+		if (k) {
+			XRenderCompositeText32(Metadpy->dpy, PictOpOver,
+				xrender_fill(c), iwin->back_pict, NULL, 0, 0, 0, 0,
+				elts, k);
+		}
+	}
+
+	mem_free(elts);
+	mem_free(rects);
+	mem_free(order);
+	td->run_count = 0;
+	td->glyph_count = 0;
+}
+
+#endif /* USE_XRENDER */
+
+
 /**
  * Handle "activation" of a term
  */
@@ -1968,6 +2467,9 @@ static errr Term_xtra_x11_level(int v)
 
 		/* Activate the font */
 		Infofnt_set(td->fnt);
+
+		/* Count requests from here towards the term's next frame */
+		td->frame_start = NextRequest(Metadpy->dpy);
 	}
 
 	/* Success */
@@ -2009,6 +2511,14 @@ static errr Term_xtra_x11_react(void)
 				Infoclr_set(clr[i]);
 				Infoclr_change_fg(pixel);
 
+#ifdef USE_XRENDER
+				/* Forget the old solid source */
+				if (fill_pict[i] != None) {
+					XRenderFreePicture(Metadpy->dpy, fill_pict[i]);
+					fill_pict[i] = None;
+				}
+#endif
+
 				if (i == COLOUR_DARK) {
 					int j;
 
@@ -2066,6 +2576,50 @@ static errr Term_xtra_x11_react(void)
 }
 
 
+/**
+ * Finish a frame: draw what was queued, then show what changed
+ */
+static errr Term_xtra_x11_fresh(void)
+{
+	term_data *td = (term_data*)(Term->data);
+	unsigned long requests;
+
+#ifdef USE_XRENDER
+	if (use_xrender) xrender_flush(td);
+#endif
+	Infowin_show_dirty();
+
+	/* Count the requests that made the frame */
+	requests = NextRequest(Metadpy->dpy) - td->frame_start;
+	td->frames++;
+	td->requests += requests;
+	if (requests > td->max_requests) td->max_requests = requests;
+
+	/* Flush the output */
+	Metadpy_update(1, 0, 0);
+	td->frame_start = NextRequest(Metadpy->dpy);
+
+	/* Success */
+	return (0);
+}
+
+
+/**
+ * Clear the screen, along with anything queued for it
+ */
+static errr Term_xtra_x11_clear(void)
+{
+#ifdef USE_XRENDER
+	term_data *td = (term_data*)(Term->data);
+
+	td->run_count = 0;
+	td->glyph_count = 0;
+#endif
+
+	return (Infowin_wipe());
+}
+
+
 /**
  * Handle a "special request"
  */
@@ -2077,8 +2631,8 @@ static errr Term_xtra_x11(int n, int v)
 		/* Make a noise */
 		case TERM_XTRA_NOISE: Metadpy_do_beep(); return (0);
 
-		/* Flush the output XXX XXX */
-		case TERM_XTRA_FRESH: Metadpy_update(1, 0, 0); return (0);
+		/* Show the frame */
+		case TERM_XTRA_FRESH: return (Term_xtra_x11_fresh());
 
 		/* Process random events XXX */
 		case TERM_XTRA_BORED: return (CheckEvent(0));
@@ -2093,7 +2647,7 @@ static errr Term_xtra_x11(int n, int v)
 		case TERM_XTRA_LEVEL: return (Term_xtra_x11_level(v));
 
 		/* Clear the screen */
-		case TERM_XTRA_CLEAR: Infowin_wipe(); return (0);
+		case TERM_XTRA_CLEAR: return (Term_xtra_x11_clear());
 
 		/* Delay for some milliseconds */
 		case TERM_XTRA_DELAY:
@@ -2116,10 +2670,17 @@ static errr Term_curs_x11(int x, int y)
 {
 	term_data *td = (term_data*)(Term->data);
 
-	XDrawRectangle(Metadpy->dpy, Infowin->win, xor->gc,
+	/* Over the text */
+#ifdef USE_XRENDER
+	if (use_xrender) xrender_flush(td);
+#endif
+
+	XDrawRectangle(Metadpy->dpy, Infowin_drawable(), xor->gc,
 				   x * td->tile_wid + Infowin->ox,
 				   y * td->tile_hgt + Infowin->oy,
 				   td->tile_wid - 1, td->tile_hgt - 1);
+	Infowin_note(x * td->tile_wid + Infowin->ox,
+		y * td->tile_hgt + Infowin->oy, td->tile_wid, td->tile_hgt);
 
 	/* Success */
 	return (0);
@@ -2133,10 +2694,17 @@ static errr Term_bigcurs_x11(int x, int y)
 {
 	term_data *td = (term_data*)(Term->data);
 
-	XDrawRectangle(Metadpy->dpy, Infowin->win, xor->gc,
+	/* Over the text */
+#ifdef USE_XRENDER
+	if (use_xrender) xrender_flush(td);
+#endif
+
+	XDrawRectangle(Metadpy->dpy, Infowin_drawable(), xor->gc,
 				   x * td->tile_wid + Infowin->ox,
 				   y * td->tile_hgt + Infowin->oy,
 				   td->tile_wid2 - 1, td->tile_hgt - 1);
+	Infowin_note(x * td->tile_wid + Infowin->ox,
+		y * td->tile_hgt + Infowin->oy, td->tile_wid2, td->tile_hgt);
 
 	/* Success */
 	return (0);
@@ -2148,6 +2716,14 @@ static errr Term_bigcurs_x11(int x, int y)
  */
 static errr Term_wipe_x11(int x, int y, int n)
 {
+#ifdef USE_XRENDER
+	if (use_xrender) {
+		xrender_queue((term_data*)(Term->data), x, y, n, COLOUR_DARK,
+			NULL);
+		return (0);
+	}
+#endif
+
 	/* Erase (use black) */
 	Infoclr_set(clr[COLOUR_DARK]);
 
@@ -2164,6 +2740,13 @@ static errr Term_wipe_x11(int x, int y, int n)
  */
 static errr Term_text_x11(int x, int y, int n, int a, const wchar_t *s)
 {
+#ifdef USE_XRENDER
+	if (use_xrender) {
+		xrender_queue((term_data*)(Term->data), x, y, n, a, s);
+		return (0);
+	}
+#endif
+
 	/* Draw the text */
 	Infoclr_set(clr[(a / MULT_BG) * MAX_COLORS + (a % MAX_COLORS)]);
 
@@ -2489,6 +3072,9 @@ static errr term_data_init(term_data *td, int i)
 	Infowin->ox = ox;
 	Infowin->oy = oy;
 
+	/* Draw off-screen */
+	Infowin_back_resize();
+
 	/* Make Class Hints */
 	ch = XAllocClassHint();
 
@@ -2615,6 +3201,23 @@ static void hook_quit(const char *str)
 		term_data *td = &data[i];
 		term *t = &td->t;
 
+		/* Report how the frames went */
+		if (frame_stats && td->frames) {
+			fprintf(stderr, "%s: %lu frames, %lu requests a frame "
+				"(at most %lu)%s\n", angband_term_name[i], td->frames,
+				td->requests / td->frames, td->max_requests,
+#ifdef USE_XRENDER
+				use_xrender ? " with XRender" :
+#endif
+				"");
+		}
+
+#ifdef USE_XRENDER
+		/* Free queued runs */
+		mem_free(td->runs);
+		mem_free(td->glyphs);
+#endif
+
 		/* Free size hints */
 		XFree(td->sizeh);
 
@@ -2635,6 +3238,18 @@ static void hook_quit(const char *str)
 		(void)term_nuke(t);
 	}
 
+#ifdef USE_XRENDER
+	/* Free solid sources */
+	for (i = 0; i < MAX_COLORS; ++i) {
+		if (fill_pict[i] != None) {
+			XRenderFreePicture(Metadpy->dpy, fill_pict[i]);
+		}
+	}
+#endif
+
+	/* Free the copying context */
+	if (back_gc) XFreeGC(Metadpy->dpy, back_gc);
+
 	/* Free colors */
 	Infoclr_set(xor);
 	(void)Infoclr_nuke();
@@ -2736,6 +3351,22 @@ errr init_x11(int argc, char **argv)
 	/* Remember the number of terminal windows */
 	term_windows_open = num_term;
 
+#ifdef USE_XRENDER
+	/* Draw text through XRender if the server has solid fills (0.10) */
+	if (Metadpy->color && !getenv("ANGBAND_X11_NO_XRENDER")) {
+		int event_base, error_base, major, minor;
+
+		if (XRenderQueryExtension(Metadpy->dpy, &event_base, &error_base)
+				&& XRenderQueryVersion(Metadpy->dpy, &major, &minor)
+				&& (major > 0 || minor >= 10)) {
+			use_xrender = true;
+		}
+	}
+#endif
+
+	/* Report on frames at the end if asked */
+	frame_stats = (getenv("ANGBAND_X11_FRAME_STATS") != NULL);
+
 	/* Prepare cursor color */
 	xor = mem_zalloc(sizeof(infoclr));
 	Infoclr_set(xor);
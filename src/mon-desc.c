@@ -63,6 +63,104 @@ void get_mon_name(char *buf, size_t buflen,
     }
 }
 
+/**
+ * Remembered names of visible monsters, for the monster list and the many
+ * messages about the same few monsters.  A name depends only on the race
+ * (which shapechanges alter), the mode and whether the monster is on screen.
+ */
+#define MON_DESC_CACHE_SIZE 64
+#define MON_DESC_CACHE_TEXT 80
+
+struct mon_desc_entry {
+	const struct monster *mon;
+	const struct monster_race *race;
+	const char *name;
+	size_t max;
+	int mode;
+	bool offscreen;
+	char text[MON_DESC_CACHE_TEXT];
+};
+
+static struct mon_desc_entry mon_desc_cache[MON_DESC_CACHE_SIZE];
+static uint32_t mon_desc_hits, mon_desc_misses;
+
+/**
+ * Report how often monster names have been found remembered
+ */
+void monster_desc_cache_counts(uint32_t *hits, uint32_t *misses)
+{
+	*hits = mon_desc_hits;
+	*misses = mon_desc_misses;
+}
+
+/**
+ * Build the name of a visible monster, as for monster_desc()
+ */
+static void monster_desc_name(char *desc, size_t max,
+		const struct monster *mon, int mode, bool offscreen)
+{
+	const char *comma_pos;
+
+	/* Unique, indefinite or definite */
+	if (monster_is_shape_unique(mon)) {
+		/* Start with the name (thus nominative and objective) */
+		/*
+		 * Strip off descriptive phrase if a possessive will be
+		 * added.
+		 */
+		if ((mode & MDESC_POSS)
+				&& rf_has(mon->race->flags, RF_NAME_COMMA)
+				&& (comma_pos = strchr(mon->race->name, ','))
+				&& comma_pos - mon->race->name < 1024) {
+			strnfmt(desc, max, "%.*s",
+				(int) (comma_pos - mon->race->name),
+				mon->race->name);
+		} else {
+			my_strcpy(desc, mon->race->name, max);
+		}
+	} else {
+		if (mode & MDESC_IND_VIS) {
+			/* XXX Check plurality for "some" */
+			/* Indefinite monsters need an indefinite article */
+			my_strcpy(desc, is_a_vowel(mon->race->name[0]) ? "an " : "a ", max);
+		} else {
+			/* Definite monsters need a definite article */
+			my_strcpy(desc, "the ", max);
+		}
+
+		/*
+		 * As with uniques, strip off phrase if a possessive
+		 * will be added.
+		 */
+		if ((mode & MDESC_POSS)
+				&& rf_has(mon->race->flags, RF_NAME_COMMA)
+				&& (comma_pos = strchr(mon->race->name, ','))
+				&& comma_pos - mon->race->name < 1024) {
+			my_strcat(desc, format("%.*s",
+				(int) (comma_pos - mon->race->name),
+				mon->race->name), max);
+		} else {
+			my_strcat(desc, mon->race->name, max);
+		}
+	}
+
+	if ((mode & MDESC_COMMA)
+			&& rf_has(mon->race->flags, RF_NAME_COMMA)) {
+		my_strcat(desc, ",", max);
+	}
+
+	/* Handle the possessive */
+	/* XXX Check for trailing "s" */
+	if (mode & MDESC_POSS) {
+		my_strcat(desc, "'s", max);
+	}
+
+	/* Mention "offscreen" monsters */
+	if (offscreen) {
+		my_strcat(desc, " (offscreen)", max);
+	}
+}
+
 /**
  * Builds a string describing a monster in some way.
  *
@@ -176,66 +274,30 @@ void monster_desc(char *desc, size_t max, const struct monster *mon, int mode)
 		else
 			my_strcpy(desc, "itself", max);
 	} else {
-		const char *comma_pos;
-
-		/* Unique, indefinite or definite */
-		if (monster_is_shape_unique(mon)) {
-			/* Start with the name (thus nominative and objective) */
-			/*
-			 * Strip off descriptive phrase if a possessive will be
-			 * added.
-			 */
-			if ((mode & MDESC_POSS)
-					&& rf_has(mon->race->flags, RF_NAME_COMMA)
-					&& (comma_pos = strchr(mon->race->name, ','))
-					&& comma_pos - mon->race->name < 1024) {
-				strnfmt(desc, max, "%.*s",
-					(int) (comma_pos - mon->race->name),
-					mon->race->name);
-			} else {
-				my_strcpy(desc, mon->race->name, max);
-			}
-		} else {
-			if (mode & MDESC_IND_VIS) {
-				/* XXX Check plurality for "some" */
-				/* Indefinite monsters need an indefinite article */
-				my_strcpy(desc, is_a_vowel(mon->race->name[0]) ? "an " : "a ", max);
-			} else {
-				/* Definite monsters need a definite article */
-				my_strcpy(desc, "the ", max);
-			}
+		bool offscreen = !panel_contains(mon->grid.y, mon->grid.x);
+		uintptr_t h = ((uintptr_t) mon >> 4) ^ (mode * 0x9e3779b1U);
+		struct mon_desc_entry *entry =
+			&mon_desc_cache[h % MON_DESC_CACHE_SIZE];
 
-			/*
-			 * As with uniques, strip off phrase if a possessive
-			 * will be added.
-			 */
-			if ((mode & MDESC_POSS)
-					&& rf_has(mon->race->flags, RF_NAME_COMMA)
-					&& (comma_pos = strchr(mon->race->name, ','))
-					&& comma_pos - mon->race->name < 1024) {
-				my_strcat(desc, format("%.*s",
-					(int) (comma_pos - mon->race->name),
-					mon->race->name), max);
-			} else {
-				my_strcat(desc, mon->race->name, max);
+		if (entry->mon == mon && entry->race == mon->race
+				&& entry->name == mon->race->name
+				&& entry->max == max && entry->mode == mode
+				&& entry->offscreen == offscreen) {
+			mon_desc_hits++;
+			my_strcpy(desc, entry->text, max);
+		} else {
+			mon_desc_misses++;
+			monster_desc_name(desc, max, mon, mode, offscreen);
+			if (strlen(desc) < MON_DESC_CACHE_TEXT) {
+				entry->mon = mon;
+				entry->race = mon->race;
+				entry->name = mon->race->name;
+				entry->max = max;
+				entry->mode = mode;
+				entry->offscreen = offscreen;
+				my_strcpy(entry->text, desc, sizeof(entry->text));
 			}
 		}
-
-		if ((mode & MDESC_COMMA)
-				&& rf_has(mon->race->flags, RF_NAME_COMMA)) {
-			my_strcat(desc, ",", max);
-		}
-
-		/* Handle the possessive */
-		/* XXX Check for trailing "s" */
-		if (mode & MDESC_POSS) {
-			my_strcat(desc, "'s", max);
-		}
-
-		/* Mention "offscreen" monsters */
-		if (!panel_contains(mon->grid.y, mon->grid.x)) {
-			my_strcat(desc, " (offscreen)", max);
-		}
 	}
 
 	if (mode & MDESC_CAPITAL) {
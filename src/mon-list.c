@@ -18,9 +18,11 @@
  */
 
 #include "game-world.h"
+#include "init.h"
 #include "mon-desc.h"
 #include "mon-list.h"
 #include "mon-predicate.h"
+#include "player-timed.h"
 #include "project.h"
 
 /**
@@ -43,6 +45,8 @@ monster_list_t *monster_list_new(void)
 	}
 
 	list->entries_size = size;
+	list->race_entry = mem_zalloc(z_info->r_max * sizeof(list->race_entry[0]));
+	list->race_order = mem_zalloc(z_info->r_max * sizeof(list->race_order[0]));
 
 	return list;
 }
@@ -60,6 +64,9 @@ void monster_list_free(monster_list_t *list)
 		list->entries = NULL;
 	}
 
+	mem_free(list->race_entry);
+	mem_free(list->race_order);
+	mem_free(list->shown);
 	mem_free(list);
 	list = NULL;
 }
@@ -125,6 +132,7 @@ void monster_list_reset(monster_list_t *list)
 	}
 
 	memset(list->entries, 0, list->entries_size * sizeof(monster_list_entry_t));
+	memset(list->race_entry, 0, z_info->r_max * sizeof(list->race_entry[0]));
 	memset(list->total_entries, 0, MONSTER_LIST_SECTION_MAX * sizeof(uint16_t));
 	memset(list->total_monsters, 0, MONSTER_LIST_SECTION_MAX * sizeof(uint16_t));
 	list->distinct_entries = 0;
@@ -149,27 +157,26 @@ void monster_list_collect(monster_list_t *list)
 	for (i = 1; i < cave_monster_max(cave); i++) {
 		struct monster *mon = cave_monster(cave, i);
 		monster_list_entry_t *entry = NULL;
-		int j, field;
+		int ridx, field;
 		bool los = false;
 
 		/* Only consider visible, known monsters */
 		if (!monster_is_visible(mon) ||	monster_is_camouflaged(mon))
 			continue;
 
-		/* Find or add a list entry. */
-		for (j = 0; j < (int)list->entries_size; j++) {
-			if (list->entries[j].race == NULL) {
-				/* We found an empty slot, so add this race here. */
-				entry = &list->entries[j];
-				memset(entry, 0, sizeof(monster_list_entry_t));
-				entry->race = mon->race;
-				break;
-			}
-			else if (list->entries[j].race == mon->race) {
-				/* We found a matching race and we'll use that. */
-				entry = &list->entries[j];
-				break;
-			}
+		/* Find or add a list entry; the race index maps straight to it. */
+		ridx = mon->race->ridx;
+		if (list->race_entry[ridx]) {
+			entry = &list->entries[list->race_entry[ridx] - 1];
+		} else if (list->distinct_entries < list->entries_size) {
+			entry = &list->entries[list->distinct_entries++];
+			entry->race = mon->race;
+			list->race_entry[ridx] = list->distinct_entries;
+
+			/* Races already on the list keep their place among equals */
+			if (!list->race_order[ridx])
+				list->race_order[ridx] = ++list->next_order;
+			entry->order = list->race_order[ridx];
 		}
 
 		if (entry == NULL)
@@ -214,13 +221,37 @@ void monster_list_collect(monster_list_t *list)
 			list->entries[i].count[MONSTER_LIST_SECTION_LOS];
 		list->total_monsters[MONSTER_LIST_SECTION_ESP] +=
 			list->entries[i].count[MONSTER_LIST_SECTION_ESP];
-		list->distinct_entries++;
+	}
+
+	/* Races that have left the list go to the back of the queue next time */
+	for (i = 0; i < z_info->r_max; i++) {
+		if (!list->race_entry[i])
+			list->race_order[i] = 0;
 	}
 
 	list->creation_turn = turn;
 	list->sorted = false;
 }
 
+/**
+ * Tie-breaker for the monster list comparators: races keep the order in which
+ * they first appeared on the list, so equal entries don't shuffle between
+ * redraws.
+ */
+static int monster_list_order_compare(const void *a, const void *b)
+{
+	uint32_t ao = ((monster_list_entry_t *)a)->order;
+	uint32_t bo = ((monster_list_entry_t *)b)->order;
+
+	if (ao < bo)
+		return -1;
+
+	if (ao > bo)
+		return 1;
+
+	return 0;
+}
+
 /**
  * Standard comparison function for the monster list: sort by depth and then
  * power.
@@ -241,7 +272,7 @@ int monster_list_standard_compare(const void *a, const void *b)
 	if (ar->level < br->level)
 		return 1;
 
-	return 0;
+	return monster_list_order_compare(a, b);
 }
 
 /**
@@ -269,7 +300,7 @@ int monster_list_compare_exp(const void *a, const void *b)
 	if (a_exp < b_exp)
 		return 1;
 
-	return 0;
+	return monster_list_order_compare(a, b);
 }
 
 /**
@@ -295,6 +326,56 @@ void monster_list_sort(monster_list_t *list,
 	list->sorted = true;
 }
 
+/**
+ * Check a collected (and sorted) list against what was last shown, and
+ * remember it as shown if it differs.
+ *
+ * The subwindow is redrawn whenever PR_MONLIST is set, which can be every
+ * game turn while monsters move in view; most of those redraws would produce
+ * exactly the text that is already on screen.
+ *
+ * \param list is the monster list to check.
+ * \param where identifies the display the list is shown on.
+ * \param height is the height of the display.
+ * \param width is the width of the display.
+ * \return true if the list needs to be redrawn.
+ */
+bool monster_list_changed(monster_list_t *list, const void *where,
+						  int height, int width)
+{
+	size_t size;
+	bool image;
+
+	if (list == NULL || list->entries == NULL)
+		return false;
+
+	size = list->distinct_entries * sizeof(list->entries[0]);
+	image = player->timed[TMD_IMAGE] > 0;
+	if (list->shown && !list->shown_stale
+			&& list->shown_entries == list->distinct_entries
+			&& list->shown_where == where
+			&& list->shown_height == height && list->shown_width == width
+			&& list->shown_depth == player->depth
+			&& list->shown_image == image
+			&& !memcmp(list->shown, list->entries, size))
+		return false;
+
+	if (list->shown_size < list->entries_size) {
+		list->shown = mem_realloc(list->shown,
+			list->entries_size * sizeof(list->shown[0]));
+		list->shown_size = list->entries_size;
+	}
+	memcpy(list->shown, list->entries, size);
+	list->shown_entries = list->distinct_entries;
+	list->shown_where = where;
+	list->shown_height = height;
+	list->shown_width = width;
+	list->shown_depth = player->depth;
+	list->shown_image = image;
+	list->shown_stale = false;
+	return true;
+}
+
 /**
  * Return an color to display a particular list entry with.
  *
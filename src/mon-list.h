@@ -34,6 +34,7 @@ typedef struct monster_list_entry_s {
 	uint16_t asleep[MONSTER_LIST_SECTION_MAX];
 	int16_t dx[MONSTER_LIST_SECTION_MAX], dy[MONSTER_LIST_SECTION_MAX];
 	uint8_t attr;
+	uint32_t order;
 } monster_list_entry_t;
 
 typedef struct monster_list_s {
@@ -44,6 +45,17 @@ typedef struct monster_list_s {
 	bool sorted;
 	uint16_t total_entries[MONSTER_LIST_SECTION_MAX];
 	uint16_t total_monsters[MONSTER_LIST_SECTION_MAX];
+	uint16_t *race_entry;
+	uint32_t *race_order;
+	uint32_t next_order;
+	monster_list_entry_t *shown;
+	size_t shown_size;
+	uint16_t shown_entries;
+	const void *shown_where;
+	int shown_height, shown_width;
+	int shown_depth;
+	bool shown_image;
+	bool shown_stale;
 } monster_list_t;
 
 monster_list_t *monster_list_new(void);
@@ -57,6 +69,8 @@ int monster_list_standard_compare(const void *a, const void *b);
 int monster_list_compare_exp(const void *a, const void *b);
 void monster_list_sort(monster_list_t *list,
 					   int (*compare)(const void *, const void *));
+bool monster_list_changed(monster_list_t *list, const void *where,
+						  int height, int width);
 uint8_t monster_list_entry_line_color(const monster_list_entry_t *entry);
 
 #endif /* MONSTER_LIST_H */
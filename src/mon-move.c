@@ -67,7 +67,8 @@ static bool monster_near_permwall(const struct monster *mon)
 	int path_grids, j;
 
 	/* If player is in LOS, there's no need to go around walls */
-    if (projectable(cave, mon->grid, player->grid, PROJECT_SHORT)) return false;
+    if (field_projectable(cave, mon->grid, player->grid, PROJECT_SHORT))
+        return false;
 
     /* PASS_WALL & KILL_WALL monsters occasionally flow for a turn anyway */
     if (randint0(99) < 5) return true;
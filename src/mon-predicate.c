@@ -22,6 +22,7 @@
 #include "mon-group.h"
 #include "mon-spell.h"
 #include "mon-util.h"
+#include "project.h"
 
 /**
  * ------------------------------------------------------------------------
@@ -313,7 +314,7 @@ bool monster_is_decoyed(const struct monster *mon)
 	if (loc_is_zero(decoy)) return false;
 
 	/* Monster can't see the decoy */
-	if (!los(cave, mon->grid, decoy)) return false;
+	if (!field_los(cave, mon->grid, decoy)) return false;
 
 	return true;
 }
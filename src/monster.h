@@ -374,6 +374,16 @@ struct monster_race {
 };
 
 
+/**
+ * What a monster has learned about the player (see update_smart_learn());
+ * only the flags and resistances of the player's state are ever learned.
+ */
+struct monster_known_pstate {
+	bitflag flags[OF_SIZE];			/* Known object flags */
+	bitflag pflags[PF_SIZE];		/* Known player flags */
+	struct element_info el_info[ELEM_MAX];	/* Known resistances */
+};
+
 /**
  * Monster information, for a specific monster.
  *
@@ -381,6 +391,11 @@ struct monster_race {
  *
  * The "held_obj" field points to the first object of a stack
  * of objects (if any) being carried by the monster (see above).
+ *
+ * The fields looked at every game turn for every monster come first, so a
+ * sweep over the monster array touches as few cache lines as possible; the
+ * targeting, group and learning state that only matter when a monster acts
+ * come last.
  */
 struct monster {
 	struct monster_race *race;		/* Monster's (current) race */
@@ -406,12 +421,11 @@ struct monster {
 
 	uint8_t attr;  				/* attr last used for drawing monster */
 
-	struct player_state known_pstate;	/* Known player state */
-
 	struct target target;			/* Monster target */
 
 	struct monster_group_info group_info[GROUP_MAX];/* Monster group details */
-	struct heatmap heatmap;			/* Monster location heatmap */
+
+	struct monster_known_pstate known_pstate;	/* Known player state */
 
 	uint8_t min_range;			/* What is the closest we want to be? */
 	uint8_t best_range;			/* How close do we want to be? */
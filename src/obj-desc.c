@@ -577,6 +577,192 @@ static size_t obj_desc_aware(const struct object *obj, char *buf, size_t max,
 }
 
 
+/**
+ * ------------------------------------------------------------------------
+ * Remembered descriptions
+ *
+ * Inventory, equipment and store menus describe every row again on each
+ * keypress, so recent descriptions are kept along with everything that went
+ * into them.  Objects are changed by direct assignment all over the game, so
+ * an entry is only reused while the object's fields still match; what the
+ * player knows about runes and flavours is covered by an epoch which
+ * object_desc_forget() moves on.
+ * ------------------------------------------------------------------------ */
+#define DESC_CACHE_SIZE 256
+#define DESC_CACHE_TEXT 120
+
+struct desc_key {
+	const struct object *obj;
+	const struct player *p;
+	const struct object *known;
+	const struct object_kind *kind;
+	const struct object_kind *known_kind;
+	const struct ego_item *ego;
+	const struct ego_item *known_ego;
+	const struct artifact *artifact;
+	const struct artifact *known_artifact;
+	const struct curse_data *known_curses;
+	const struct effect *effect;
+	const struct activation *activation;
+	random_value time;
+	size_t max;
+	uint32_t mode;
+	uint32_t epoch;
+	int16_t pval, known_pval, timeout;
+	int16_t ac, to_a, to_h, to_d;
+	int16_t known_ac, known_to_a, known_to_h, known_to_d;
+	int16_t known_modifiers[OBJ_MOD_MAX];
+	bitflag flags[OF_SIZE];
+	uint8_t number, known_dd, known_ds;
+	bitflag notice, known_notice;
+	quark_t note;
+	bool aware, tried, ignore, show_flavors;
+};
+
+struct desc_entry {
+	struct desc_key key;
+	size_t end;
+	char text[DESC_CACHE_TEXT];
+};
+
+static struct desc_entry *desc_cache;
+static uint32_t desc_epoch = 1;
+static uint32_t desc_hits, desc_misses;
+
+/**
+ * Fill in everything object_desc_calc() reads for this object and mode
+ */
+static void object_desc_key(struct desc_key *key, size_t max,
+		const struct object *obj, uint32_t mode, const struct player *p)
+{
+	const struct object *known = obj->known;
+
+	/* Padding is compared too */
+	memset(key, 0, sizeof(*key));
+	key->obj = obj;
+	key->p = p;
+	key->known = known;
+	key->kind = obj->kind;
+	key->known_kind = known->kind;
+	key->ego = obj->ego;
+	key->known_ego = known->ego;
+	key->artifact = obj->artifact;
+	key->known_artifact = known->artifact;
+	key->known_curses = known->curses;
+	key->effect = obj->effect;
+	key->activation = obj->activation;
+	key->time = obj->time;
+	key->max = max;
+	key->mode = mode;
+	key->epoch = desc_epoch;
+	key->pval = obj->pval;
+	key->known_pval = known->pval;
+	key->timeout = obj->timeout;
+	key->ac = obj->ac;
+	key->to_a = obj->to_a;
+	key->to_h = obj->to_h;
+	key->to_d = obj->to_d;
+	key->known_ac = known->ac;
+	key->known_to_a = known->to_a;
+	key->known_to_h = known->to_h;
+	key->known_to_d = known->to_d;
+	memcpy(key->known_modifiers, known->modifiers,
+		sizeof(key->known_modifiers));
+	of_copy(key->flags, obj->flags);
+	key->number = obj->number;
+	key->known_dd = known->dd;
+	key->known_ds = known->ds;
+	key->notice = obj->notice;
+	key->known_notice = known->notice;
+	key->note = obj->note;
+	key->aware = object_flavor_is_aware(obj);
+	key->tried = object_flavor_was_tried(obj);
+	key->ignore = p && (mode & ODESC_EXTRA) && !(mode & ODESC_STORE)
+		&& ignore_item_ok(p, obj);
+	key->show_flavors = p && OPT(p, show_flavors);
+}
+
+static struct desc_entry *object_desc_entry(const struct object *obj,
+		uint32_t mode)
+{
+	uintptr_t h = (uintptr_t) obj;
+
+	if (!desc_cache)
+		desc_cache = mem_zalloc(DESC_CACHE_SIZE * sizeof(*desc_cache));
+	h = (h >> 4) ^ (h >> 12) ^ (mode * 0x9e3779b1U);
+	return &desc_cache[h % DESC_CACHE_SIZE];
+}
+
+/**
+ * Forget every remembered description, as after the player learns something
+ * about objects
+ */
+void object_desc_forget(void)
+{
+	desc_epoch++;
+}
+
+/**
+ * Report how often descriptions have been found remembered
+ */
+void object_desc_cache_counts(uint32_t *hits, uint32_t *misses)
+{
+	*hits = desc_hits;
+	*misses = desc_misses;
+}
+
+/**
+ * Release the remembered descriptions
+ */
+void object_desc_cache_free(void)
+{
+	mem_free(desc_cache);
+	desc_cache = NULL;
+}
+
+
+/**
+ * Describe an object from scratch; see object_desc() for the parameters
+ */
+static size_t object_desc_calc(char *buf, size_t max,
+		const struct object *obj, uint32_t mode, const struct player *p)
+{
+	bool prefix = mode & ODESC_PREFIX ? true : false;
+	bool terse = mode & ODESC_TERSE ? true : false;
+
+	size_t end = 0;
+
+	/** Construct the name **/
+
+	/* Copy the base name to the buffer */
+	end = obj_desc_name(buf, max, end, obj, prefix, mode, terse, p);
+
+	/* Combat properties */
+	if (mode & ODESC_COMBAT) {
+		if (tval_is_chest(obj))
+			end = obj_desc_chest(obj, buf, max, end);
+		else if (tval_is_light(obj))
+			end = obj_desc_light(obj, buf, max, end);
+
+		end = obj_desc_combat(obj->known, buf, max, end, mode, p);
+	}
+
+	/* Modifiers, charges, flavour details, inscriptions */
+	if (mode & ODESC_EXTRA) {
+		end = obj_desc_mods(obj->known, buf, max, end);
+
+		end = obj_desc_charges(obj, buf, max, end, mode);
+
+		if (mode & ODESC_STORE)
+			end = obj_desc_aware(obj, buf, max, end);
+		else
+			end = obj_desc_inscrip(obj, buf, max, end, p);
+	}
+
+	return end;
+}
+
+
 /**
  * Describes item `obj` into buffer `buf` of size `max`.
  *
@@ -609,9 +795,9 @@ size_t object_desc(char *buf, size_t max, const struct object *obj,
 {
 	bool prefix = mode & ODESC_PREFIX ? true : false;
 	bool spoil = mode & ODESC_SPOIL ? true : false;
-	bool terse = mode & ODESC_TERSE ? true : false;
-
-	size_t end = 0;
+	struct desc_key key;
+	struct desc_entry *entry;
+	size_t end;
 
 	/* Simple description for null item */
 	if (!obj || !obj->known)
@@ -636,32 +822,21 @@ size_t object_desc(char *buf, size_t max, const struct object *obj,
 	if (object_flavor_is_aware(obj) && !spoil)
 		obj->kind->everseen = true;
 
-	/** Construct the name **/
-
-	/* Copy the base name to the buffer */
-	end = obj_desc_name(buf, max, end, obj, prefix, mode, terse, p);
-
-	/* Combat properties */
-	if (mode & ODESC_COMBAT) {
-		if (tval_is_chest(obj))
-			end = obj_desc_chest(obj, buf, max, end);
-		else if (tval_is_light(obj))
-			end = obj_desc_light(obj, buf, max, end);
-
-		end = obj_desc_combat(obj->known, buf, max, end, mode, p);
+	/* Use a remembered description if nothing it depends on has changed */
+	object_desc_key(&key, max, obj, mode, p);
+	entry = object_desc_entry(obj, mode);
+	if (!memcmp(&entry->key, &key, sizeof(key))) {
+		desc_hits++;
+		memcpy(buf, entry->text, entry->end + 1);
+		return entry->end;
 	}
+	desc_misses++;
 
-	/* Modifiers, charges, flavour details, inscriptions */
-	if (mode & ODESC_EXTRA) {
-		end = obj_desc_mods(obj->known, buf, max, end);
-
-		end = obj_desc_charges(obj, buf, max, end, mode);
-
-		if (mode & ODESC_STORE)
-			end = obj_desc_aware(obj, buf, max, end);
-		else
-			end = obj_desc_inscrip(obj, buf, max, end, p);
+	end = object_desc_calc(buf, max, obj, mode, p);
+	if (end < DESC_CACHE_TEXT && end < max) {
+		entry->key = key;
+		entry->end = end;
+		memcpy(entry->text, buf, end + 1);
 	}
-
 	return end;
 }
@@ -1025,6 +1025,9 @@ void player_know_object(struct player *p, struct object *obj)
 	if (!obj->known) return;
 	if (obj->kind != obj->known->kind) return;
 
+	/* Names may change with what is learned */
+	object_desc_forget();
+
 	/* Distant objects just get base properties */
 	if (obj->kind && !(obj->known->notice & OBJ_NOTICE_ASSESSED)) {
 		object_set_base_known(p, obj);
@@ -1366,6 +1369,7 @@ static void player_learn_rune(struct player *p, size_t i, bool message)
 		msgt(MSG_RUNE, "You have learned the rune of %s.", rune_name(i));
 
 	/* Update knowledge */
+	object_desc_forget();
 	update_player_object_knowledge(p);
 }
 
@@ -2267,6 +2271,7 @@ void object_flavor_aware(struct player *p, struct object *obj)
 	assert(obj->known);
 	if (obj->kind->aware) return;
 	obj->kind->aware = true;
+	object_desc_forget();
 	obj->known->effect = obj->effect;
 
 	/* Fix ignore/autoinscribe */
@@ -2322,4 +2327,5 @@ void object_flavor_tried(struct object *obj)
 		return;
 	}
 	obj->kind->tried = true;
+	object_desc_forget();
 }
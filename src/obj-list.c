@@ -156,6 +156,7 @@ static bool object_list_should_ignore_object(const struct player *p,
 void object_list_collect(object_list_t *list)
 {
 	int i;
+	size_t used = 0;
 	struct loc pgrid = player->grid;
 
 	if (list == NULL || list->entries == NULL)
@@ -167,7 +168,6 @@ void object_list_collect(object_list_t *list)
 	/* Scan each object in the dungeon. */
 	for (i = 1; i < player->cave->obj_max; i++) {
 		object_list_entry_t *entry = NULL;
-		int entry_index;
 		int current_distance;
 		int entry_distance;
 		struct loc grid;
@@ -183,29 +183,19 @@ void object_list_collect(object_list_t *list)
 			grid = obj->grid;
 		}
 
+		if (object_list_should_ignore_object(player, obj)) continue;
+
 		/* Determine which section of the list the object entry is in */
 		los = projectable(cave, pgrid, grid, PROJECT_NONE) ||
 			loc_eq(grid, pgrid);
 		field = (los) ? OBJECT_LIST_SECTION_LOS : OBJECT_LIST_SECTION_NO_LOS;
 
-		if (object_list_should_ignore_object(player, obj)) continue;
-
-		/* Find or add a list entry. */
-		for (entry_index = 0; entry_index < (int)list->entries_size;
-			 entry_index++) {
-			int j;
-			struct object *list_obj = list->entries[entry_index].object;
-
-			if (list_obj == NULL) {
-				/* We found an empty slot, so add this object here. */
-				list->entries[entry_index].object = obj;
-				for (j = 0; j < OBJECT_LIST_SECTION_MAX; j++)
-					list->entries[entry_index].count[j] = 0;
-				list->entries[entry_index].dy = grid.y - pgrid.y;
-				list->entries[entry_index].dx = grid.x - pgrid.x;
-				entry = &list->entries[entry_index];
-				break;
-			}
+		/* Every object gets its own entry; add it at the next free slot. */
+		if (used < list->entries_size) {
+			entry = &list->entries[used++];
+			entry->object = obj;
+			entry->dy = grid.y - pgrid.y;
+			entry->dx = grid.x - pgrid.x;
 		}
 
 		if (entry == NULL)
@@ -230,10 +220,7 @@ void object_list_collect(object_list_t *list)
 	}
 
 	/* Collect totals for easier calculations of the list. */
-	for (i = 0; i < (int)list->entries_size; i++) {
-		if (list->entries[i].object == NULL)
-			continue;
-
+	for (i = 0; i < (int)used; i++) {
 		if (list->entries[i].count[OBJECT_LIST_SECTION_LOS] > 0)
 			list->total_entries[OBJECT_LIST_SECTION_LOS]++;
 
@@ -288,6 +275,11 @@ int object_list_standard_compare(const void *a, const void *b)
 	if (result == 0)
 		result = object_list_distance_compare(a, b);
 
+	/* Then keep the order they were collected in, so that equal entries
+	 * don't shuffle between redraws. */
+	if (result == 0)
+		result = (ao->oidx < bo->oidx) ? -1 : ((ao->oidx > bo->oidx) ? 1 : 0);
+
 	return result;
 }
 
@@ -368,18 +360,14 @@ void object_list_format_name(const object_list_entry_t *entry,
 	const char *chunk;
 	char *source;
 	bool has_singular_prefix;
-	bool los = false;
 	int field;
-	struct loc pgrid = player->grid;
 	struct object *base_obj;
-	struct loc grid;
 	bool object_is_recognized_artifact;
 
 	if (entry == NULL || entry->object == NULL || entry->object->kind == NULL)
 		return;
 
 	base_obj = cave->objects[entry->object->oidx];
-	grid = entry->object->grid;
 	object_is_recognized_artifact = object_is_known_artifact(base_obj);
 
 	/* Hack - these don't have a prefix when there is only one, so just pad
@@ -408,9 +396,10 @@ void object_list_format_name(const object_list_entry_t *entry,
 	if (entry->object->kind != base_obj->kind)
 		has_singular_prefix = true;
 
-	/* Work out if the object is in view */
-	los = projectable(cave, pgrid, grid, PROJECT_NONE) || loc_eq(grid, pgrid);
-	field = los ? OBJECT_LIST_SECTION_LOS : OBJECT_LIST_SECTION_NO_LOS;
+	/* Each entry is a single grid, so collection already worked out whether
+	 * the object is in view. */
+	field = (entry->count[OBJECT_LIST_SECTION_LOS] > 0) ?
+		OBJECT_LIST_SECTION_LOS : OBJECT_LIST_SECTION_NO_LOS;
 
 	/*
 	 * Pass the accumulated number via object_desc()'s ODESC_ALTNUM
@@ -278,12 +278,125 @@ bool pile_contains(const struct object *top, const struct object *obj)
 	return false;
 }
 
+/**
+ * Most blocks an object cache keeps for reuse
+ */
+#define OBJECT_CACHE_MAX 2048
+
+/**
+ * A cache of freed blocks of one size, kept for reuse.
+ *
+ * Levels, stores and monster drops create and destroy objects (and their
+ * known versions) by the thousand, each with its own slay, brand and curse
+ * arrays. Rather than handing those back to the allocator, freed ones are
+ * threaded onto a free list and reused. Every block is an ordinary
+ * mem_zalloc() block, so code that frees one directly is still correct.
+ */
+struct object_cache_block {
+	struct object_cache_block *next;
+};
+
+struct object_cache {
+	struct object_cache_block *head;
+	size_t size;
+	int count;
+};
+
+static struct object_cache object_cache;
+static struct object_cache slay_cache;
+static struct object_cache brand_cache;
+static struct object_cache curse_cache;
+
+/**
+ * Free every block held by a cache.
+ */
+static void object_cache_wipe(struct object_cache *oc)
+{
+	while (oc->head) {
+		struct object_cache_block *block = oc->head;
+
+		oc->head = block->next;
+		mem_free(block);
+	}
+	oc->count = 0;
+}
+
+/**
+ * Get a zeroed block of the given size, from the cache if possible.
+ */
+static void *object_cache_get(struct object_cache *oc, size_t size)
+{
+	struct object_cache_block *block = oc->head;
+
+	if (!block || oc->size != size) return mem_zalloc(size);
+
+	oc->head = block->next;
+	oc->count--;
+	memset(block, 0, size);
+	return block;
+}
+
+/**
+ * Hand a block of the given size back to the cache, or free it if the cache
+ * is full.
+ */
+static void object_cache_put(struct object_cache *oc, void *p, size_t size)
+{
+	struct object_cache_block *block = p;
+
+	/* Too small to thread, or the cache is full */
+	if (size < sizeof(*block) || oc->count >= OBJECT_CACHE_MAX) {
+		mem_free(block);
+		return;
+	}
+
+	/* Sizes change when game data is reloaded */
+	if (oc->size != size) {
+		object_cache_wipe(oc);
+		oc->size = size;
+	}
+
+	block->next = oc->head;
+	oc->head = block;
+	oc->count++;
+}
+
+/**
+ * Free the slay, brand and curse arrays of an object.
+ */
+static void object_free_arrays(struct object *obj)
+{
+	if (obj->slays) {
+		object_cache_put(&slay_cache, obj->slays,
+			z_info->slay_max * sizeof(bool));
+	}
+	if (obj->brands) {
+		object_cache_put(&brand_cache, obj->brands,
+			z_info->brand_max * sizeof(bool));
+	}
+	if (obj->curses) {
+		object_cache_put(&curse_cache, obj->curses,
+			z_info->curse_max * sizeof(struct curse_data));
+	}
+}
+
+/**
+ * Release everything held for reuse by object_new() and object_copy().
+ */
+void object_cache_free(void)
+{
+	object_cache_wipe(&object_cache);
+	object_cache_wipe(&slay_cache);
+	object_cache_wipe(&brand_cache);
+	object_cache_wipe(&curse_cache);
+}
+
 /**
  * Create a new object and return it
  */
 struct object *object_new(void)
 {
-	return mem_zalloc(sizeof(struct object));
+	return object_cache_get(&object_cache, sizeof(struct object));
 }
 
 /**
@@ -293,10 +406,8 @@ struct object *object_new(void)
  */
 void object_free(struct object *obj)
 {
-	mem_free(obj->slays);
-	mem_free(obj->brands);
-	mem_free(obj->curses);
-	mem_free(obj);
+	object_free_arrays(obj);
+	object_cache_put(&object_cache, obj, sizeof(struct object));
 }
 
 /**
@@ -697,10 +808,8 @@ void object_absorb(struct object *obj1, struct object *obj2)
  */
 void object_wipe(struct object *obj)
 {
-	/* Free slays and brands */
-	mem_free(obj->slays);
-	mem_free(obj->brands);
-	mem_free(obj->curses);
+	/* Free slays, brands and curses */
+	object_free_arrays(obj);
 
 	/* Wipe the structure */
 	memset(obj, 0, sizeof(*obj));
@@ -716,16 +825,18 @@ void object_copy(struct object *dest, const struct object *src)
 	memcpy(dest, src, sizeof(struct object));
 
 	if (src->slays) {
-		dest->slays = mem_zalloc(z_info->slay_max * sizeof(bool));
-		memcpy(dest->slays, src->slays, z_info->slay_max * sizeof(bool));
+		size_t array_size = z_info->slay_max * sizeof(bool);
+		dest->slays = object_cache_get(&slay_cache, array_size);
+		memcpy(dest->slays, src->slays, array_size);
 	}
 	if (src->brands) {
-		dest->brands = mem_zalloc(z_info->brand_max * sizeof(bool));
-		memcpy(dest->brands, src->brands, z_info->brand_max * sizeof(bool));
+		size_t array_size = z_info->brand_max * sizeof(bool);
+		dest->brands = object_cache_get(&brand_cache, array_size);
+		memcpy(dest->brands, src->brands, array_size);
 	}
 	if (src->curses) {
 		size_t array_size = z_info->curse_max * sizeof(struct curse_data);
-		dest->curses = mem_zalloc(array_size);
+		dest->curses = object_cache_get(&curse_cache, array_size);
 		memcpy(dest->curses, src->curses, array_size);
 	}
 
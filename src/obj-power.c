@@ -136,6 +136,26 @@ static int16_t ability_power[25] =
 /* Log file declared here for simplicity */
 static ang_file *object_log;
 
+/**
+ * The property records behind each modifier and flag, looked up once for the
+ * loaded object_property data rather than by a search per object
+ */
+static struct obj_property *mod_property[OBJ_MOD_MAX];
+static struct obj_property *flag_property[OF_MAX];
+static const struct obj_property *property_tables_for;
+
+static void build_property_tables(void)
+{
+	int i;
+
+	if (property_tables_for == obj_properties) return;
+	for (i = 0; i < OBJ_MOD_MAX; i++)
+		mod_property[i] = lookup_obj_property(OBJ_PROPERTY_MOD, i);
+	for (i = 0; i < OF_MAX; i++)
+		flag_property[i] = lookup_obj_property(OBJ_PROPERTY_FLAG, i);
+	property_tables_for = obj_properties;
+}
+
 /**
  * Log progress info to the object log
  */
@@ -546,7 +566,7 @@ static int modifier_power(const struct object *obj, int p)
 
 	for (i = 0; i < OBJ_MOD_MAX; i++) {
 		/* Get the modifier details */
-		struct obj_property *mod = lookup_obj_property(OBJ_PROPERTY_MOD, i);
+		struct obj_property *mod = mod_property[i];
 		assert(mod);
 
 		k = obj->modifiers[i];
@@ -595,7 +615,7 @@ static int flags_power(const struct object *obj, int p, int verbose,
 	for (i = of_next(flags, FLAG_START); i != FLAG_END; 
 		 i = of_next(flags, i + 1)) {
 		/* Get the flag details */
-		struct obj_property *flag = lookup_obj_property(OBJ_PROPERTY_FLAG, i);
+		struct obj_property *flag = flag_property[i];
 		assert(flag);
 
 		if (flag->power) {
@@ -1000,15 +1020,17 @@ static int nonstandard_weight_power(const struct object *obj, int p)
 
 
 /**
- * Evaluate the object's overall power level.
+ * Evaluate the object's overall power level from scratch.
  */
-int32_t object_power(const struct object* obj, bool verbose, ang_file *log_file)
+static int32_t object_power_calc(const struct object* obj, bool verbose,
+		ang_file *log_file)
 {
 	int32_t p = 0, dice_pwr = 0;
 	int mult;
 
 	/* Set the log file */
 	object_log = log_file;
+	build_property_tables();
 
 	/* Get all the attack power */
 	p = to_damage_power(obj);
@@ -1048,6 +1070,92 @@ int32_t object_power(const struct object* obj, bool verbose, ang_file *log_file)
 	return p;
 }
 
+static uint64_t hash_bytes(uint64_t h, const void *data, size_t len)
+{
+	const uint8_t *b = data;
+	size_t i;
+
+	/* FNV-1a */
+	for (i = 0; i < len; i++) {
+		h ^= b[i];
+		h *= 0x100000001b3ULL;
+	}
+	return h;
+}
+
+/**
+ * Fingerprint everything object_power_calc() reads from an object.  Objects
+ * are changed by direct assignment all over the game, so rather than rely on
+ * every one of those places marking the object, a cached power is reused
+ * only while its fingerprint still matches.
+ */
+static uint64_t object_power_key(const struct object *obj)
+{
+	uint64_t h = 0xcbf29ce484222325ULL;
+	uint8_t present = (obj->brands ? 1 : 0) | (obj->slays ? 2 : 0)
+		| (obj->curses ? 4 : 0);
+	int i;
+
+	h = hash_bytes(h, &obj->kind, sizeof(obj->kind));
+	h = hash_bytes(h, &obj->ego, sizeof(obj->ego));
+	h = hash_bytes(h, &obj->artifact, sizeof(obj->artifact));
+	h = hash_bytes(h, &obj->activation, sizeof(obj->activation));
+	h = hash_bytes(h, &obj->tval, sizeof(obj->tval));
+	h = hash_bytes(h, &obj->pval, sizeof(obj->pval));
+	h = hash_bytes(h, &obj->weight, sizeof(obj->weight));
+	h = hash_bytes(h, &obj->dd, sizeof(obj->dd));
+	h = hash_bytes(h, &obj->ds, sizeof(obj->ds));
+	h = hash_bytes(h, &obj->ac, sizeof(obj->ac));
+	h = hash_bytes(h, &obj->to_a, sizeof(obj->to_a));
+	h = hash_bytes(h, &obj->to_h, sizeof(obj->to_h));
+	h = hash_bytes(h, &obj->to_d, sizeof(obj->to_d));
+	h = hash_bytes(h, obj->flags, sizeof(obj->flags));
+	h = hash_bytes(h, obj->modifiers, sizeof(obj->modifiers));
+	for (i = 0; i < ELEM_MAX; i++) {
+		h = hash_bytes(h, &obj->el_info[i].res_level,
+			sizeof(obj->el_info[i].res_level));
+		h = hash_bytes(h, &obj->el_info[i].flags,
+			sizeof(obj->el_info[i].flags));
+	}
+
+	/* Mark which of the optional arrays are present */
+	h = hash_bytes(h, &present, sizeof(present));
+	if (obj->brands)
+		h = hash_bytes(h, obj->brands, z_info->brand_max * sizeof(bool));
+	if (obj->slays)
+		h = hash_bytes(h, obj->slays, z_info->slay_max * sizeof(bool));
+	if (obj->curses) {
+		for (i = 0; i < z_info->curse_max; i++)
+			h = hash_bytes(h, &obj->curses[i].power,
+				sizeof(obj->curses[i].power));
+	}
+
+	/* Zero means nothing is cached */
+	return h ? h : 1;
+}
+
+/**
+ * Evaluate the object's overall power level.
+ *
+ * The result is kept with the object and reused until something it depends
+ * on changes.  Verbose or logged evaluations always recompute so that the
+ * log is complete.
+ */
+int32_t object_power(const struct object* obj, bool verbose, ang_file *log_file)
+{
+	/* The cache fields are documented as mutable in struct object, so
+	 * updating them through a const pointer is intended; objects are never
+	 * in read-only storage */
+	struct object *cache = (struct object *) obj;
+	uint64_t key = object_power_key(obj);
+
+	if (verbose || log_file || obj->power_key != key) {
+		cache->power = object_power_calc(obj, verbose, log_file);
+		cache->power_key = key;
+	}
+	return obj->power;
+}
+
 
 /**
  * ------------------------------------------------------------------------
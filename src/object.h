@@ -470,6 +470,15 @@ struct object {
 	const struct monster_race *origin_race;	/**< Monster race that dropped it */
 
 	quark_t note; 			/**< Inscription index */
+
+	/*
+	 * Mutable cache, not part of the object's state: object_power() writes
+	 * it even through const pointers.  object_copy() copies it with the
+	 * rest, which is harmless as the key is rechecked on use, and the
+	 * savefile leaves it out, so it is rebuilt after loading.
+	 */
+	int32_t power;			/**< Cached object_power(), if power_key matches */
+	uint64_t power_key;		/**< Fingerprint of what power was computed from */
 };
 
 /**
@@ -513,6 +522,8 @@ static struct object const OBJECT_NULL = {
 	.origin_depth = 0,
 	.origin_race = NULL,
 	.note = 0,
+	.power = 0,
+	.power_key = 0,
 };
 
 struct flavor
@@ -1852,6 +1852,244 @@ static void calc_shapechange(struct player_state *state, bool vuln[ELEM_MAX],
 	}
 }
 
+/**
+ * Everything the object in an equipment slot contributes to calc_bonuses().
+ * The contributions of different slots combine by adding, taking the best
+ * resistance, or taking the union, so each slot can be worked out on its own
+ * and reused until that slot changes.
+ */
+struct slot_bonus_key {
+	const struct object_kind *kind;
+	const struct ego_item *ego;
+	uint8_t tval;
+	bool known_only;
+	bool combat;		/* to-hit and to-dam count towards the state */
+	bool aware;
+	bitflag flags[OF_SIZE];
+	bitflag known_flags[OF_SIZE];
+	int16_t modifiers[OBJ_MOD_MAX];
+	int16_t rune_modifiers[OBJ_MOD_MAX];
+	int16_t res_level[ELEM_MAX];
+	int16_t known_res_level[ELEM_MAX];
+	int16_t ac, to_a, to_h, to_d;
+	int16_t known_to_a, known_to_h, known_to_d;
+};
+
+struct slot_bonus {
+	struct slot_bonus_key key;
+	bool valid;
+
+	bitflag flags[OF_SIZE];
+	int stat_add[STAT_MAX];
+	int stealth, search, digging;
+	int see_infra, speed, dam_red;
+	int blows, shots, might, moves;
+	int16_t res_level[ELEM_MAX];
+	bool vuln[ELEM_MAX];
+	int ac, to_a, to_h, to_d;
+};
+
+/**
+ * Fill in the key for an uncursed object in a slot: every input that
+ * calc_slot_bonus() reads.  Unused parts are zeroed so keys compare with
+ * memcmp().
+ */
+static void slot_bonus_key(struct player *p, int slot, const struct object *obj,
+		bool known_only, struct slot_bonus_key *key)
+{
+	int i;
+
+	memset(key, 0, sizeof(*key));
+	key->kind = obj->kind;
+	key->ego = obj->ego;
+	key->tval = obj->tval;
+	key->known_only = known_only;
+	key->combat = !slot_type_is(p, slot, EQUIP_WEAPON)
+		&& !slot_type_is(p, slot, EQUIP_BOW);
+	of_copy(key->flags, obj->flags);
+	memcpy(key->modifiers, obj->modifiers, sizeof(key->modifiers));
+	memcpy(key->rune_modifiers, p->obj_k->modifiers,
+		sizeof(key->rune_modifiers));
+	for (i = 0; i < ELEM_MAX; i++) {
+		key->res_level[i] = obj->el_info[i].res_level;
+	}
+	key->ac = obj->ac;
+	key->to_a = obj->to_a;
+	key->to_h = obj->to_h;
+	key->to_d = obj->to_d;
+	if (known_only) {
+		key->aware = obj->kind && object_flavor_is_aware(obj);
+		of_copy(key->known_flags, obj->known->flags);
+		for (i = 0; i < ELEM_MAX; i++) {
+			key->known_res_level[i] = obj->known->el_info[i].res_level;
+		}
+		key->known_to_a = obj->known->to_a;
+		key->known_to_h = obj->known->to_h;
+		key->known_to_d = obj->known->to_d;
+	}
+}
+
+/**
+ * Work out what the object in a slot, and any curses on it, add to the
+ * player's state
+ */
+static void calc_slot_bonus(struct player *p, int slot, bool known_only,
+		struct slot_bonus *b)
+{
+	int index = 0, j;
+	struct object *obj = slot_object(p, slot);
+	struct curse_data *curse = obj ? obj->curses : NULL;
+	bitflag f[OF_SIZE];
+
+	memset(b, 0, sizeof(*b));
+	while (obj) {
+		int dig = 0;
+
+		/* Extract the item flags */
+		if (known_only) {
+			object_flags_known(obj, f);
+		} else {
+			object_flags(obj, f);
+		}
+		of_union(b->flags, f);
+
+		/* Apply modifiers */
+		b->stat_add[STAT_STR] += obj->modifiers[OBJ_MOD_STR]
+			* p->obj_k->modifiers[OBJ_MOD_STR];
+		b->stat_add[STAT_INT] += obj->modifiers[OBJ_MOD_INT]
+			* p->obj_k->modifiers[OBJ_MOD_INT];
+		b->stat_add[STAT_WIS] += obj->modifiers[OBJ_MOD_WIS]
+			* p->obj_k->modifiers[OBJ_MOD_WIS];
+		b->stat_add[STAT_DEX] += obj->modifiers[OBJ_MOD_DEX]
+			* p->obj_k->modifiers[OBJ_MOD_DEX];
+		b->stat_add[STAT_CON] += obj->modifiers[OBJ_MOD_CON]
+			* p->obj_k->modifiers[OBJ_MOD_CON];
+		b->stealth += obj->modifiers[OBJ_MOD_STEALTH]
+			* p->obj_k->modifiers[OBJ_MOD_STEALTH];
+		b->search += (obj->modifiers[OBJ_MOD_SEARCH] * 5)
+			* p->obj_k->modifiers[OBJ_MOD_SEARCH];
+
+		b->see_infra += obj->modifiers[OBJ_MOD_INFRA]
+			* p->obj_k->modifiers[OBJ_MOD_INFRA];
+		if (tval_is_digger(obj)) {
+			if (of_has(obj->flags, OF_DIG_1))
+				dig = 1;
+			else if (of_has(obj->flags, OF_DIG_2))
+				dig = 2;
+			else if (of_has(obj->flags, OF_DIG_3))
+				dig = 3;
+		}
+		dig += obj->modifiers[OBJ_MOD_TUNNEL]
+			* p->obj_k->modifiers[OBJ_MOD_TUNNEL];
+		b->digging += (dig * 20);
+		b->speed += obj->modifiers[OBJ_MOD_SPEED]
+			* p->obj_k->modifiers[OBJ_MOD_SPEED];
+		b->dam_red += obj->modifiers[OBJ_MOD_DAM_RED]
+			* p->obj_k->modifiers[OBJ_MOD_DAM_RED];
+		b->blows += obj->modifiers[OBJ_MOD_BLOWS]
+			* p->obj_k->modifiers[OBJ_MOD_BLOWS];
+		b->shots += obj->modifiers[OBJ_MOD_SHOTS]
+			* p->obj_k->modifiers[OBJ_MOD_SHOTS];
+		b->might += obj->modifiers[OBJ_MOD_MIGHT]
+			* p->obj_k->modifiers[OBJ_MOD_MIGHT];
+		b->moves += obj->modifiers[OBJ_MOD_MOVES]
+			* p->obj_k->modifiers[OBJ_MOD_MOVES];
+
+		/* Element info, noting vulnerabilites for later processing */
+		for (j = 0; j < ELEM_MAX; j++) {
+			if (!known_only || obj->known->el_info[j].res_level) {
+				if (obj->el_info[j].res_level == -1)
+					b->vuln[j] = true;
+
+				/* OK because res_level hasn't included vulnerability yet */
+				if (obj->el_info[j].res_level > b->res_level[j])
+					b->res_level[j] = obj->el_info[j].res_level;
+			}
+		}
+
+		/* Combat bonuses */
+		b->ac += obj->ac;
+		if (!known_only || obj->known->to_a)
+			b->to_a += obj->to_a;
+		if (!slot_type_is(p, slot, EQUIP_WEAPON)
+				&& !slot_type_is(p, slot, EQUIP_BOW)) {
+			if (!known_only || obj->known->to_h) {
+				b->to_h += obj->to_h;
+			}
+			if (!known_only || obj->known->to_d) {
+				b->to_d += obj->to_d;
+			}
+		}
+
+		/* Move to any unprocessed curse object */
+		if (curse) {
+			index++;
+			obj = NULL;
+			while (index < z_info->curse_max) {
+				if (curse[index].power) {
+					obj = curses[index].obj;
+					break;
+				} else {
+					index++;
+				}
+			}
+		} else {
+			obj = NULL;
+		}
+	}
+}
+
+/**
+ * Get the contribution of an equipment slot, reusing the one worked out last
+ * time if nothing it depends on has changed.  The known and full versions
+ * are kept separately, so that update_bonuses() doesn't thrash the cache.
+ *
+ * Curse objects are shared and their runes learnt separately, so cursed
+ * objects are always worked out afresh.
+ */
+static const struct slot_bonus *get_slot_bonus(struct player *p, int slot,
+		bool known_only, struct slot_bonus *scratch)
+{
+	const struct object *obj = slot_object(p, slot);
+	struct player_upkeep *upkeep = p->upkeep;
+	struct slot_bonus_key key;
+	struct slot_bonus *b;
+
+	if (!obj || obj->curses || !upkeep) {
+		calc_slot_bonus(p, slot, known_only, scratch);
+		return scratch;
+	}
+
+	/* The body isn't known until the race is, so size the cache here */
+	if (upkeep->slot_bonus_count != p->body.count) {
+		mem_free(upkeep->slot_bonus);
+		upkeep->slot_bonus = mem_zalloc(2 * p->body.count
+			* sizeof(*upkeep->slot_bonus));
+		upkeep->slot_bonus_count = p->body.count;
+	}
+	b = &upkeep->slot_bonus[2 * slot + (known_only ? 1 : 0)];
+
+	slot_bonus_key(p, slot, obj, known_only, &key);
+	if (!b->valid || memcmp(&key, &b->key, sizeof(key))) {
+		calc_slot_bonus(p, slot, known_only, b);
+		b->key = key;
+		b->valid = true;
+	}
+	return b;
+}
+
+/**
+ * Forget all the cached slot contributions, so the next calc_bonuses()
+ * works every slot out from scratch
+ */
+void reset_slot_bonuses(struct player *p)
+{
+	if (!p->upkeep) return;
+	mem_free(p->upkeep->slot_bonus);
+	p->upkeep->slot_bonus = NULL;
+	p->upkeep->slot_bonus_count = 0;
+}
+
 /**
  * Calculate the players current "state", taking into account
  * not only race/class intrinsics, but also objects being worn
@@ -1884,7 +2122,6 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 	int extra_moves = 0;
 	struct object *launcher = equipped_item_by_slot_name(p, "shooting");
 	struct object *weapon = equipped_item_by_slot_name(p, "weapon");
-	bitflag f[OF_SIZE];
 	bitflag collect_f[OF_SIZE];
 	bool vuln[ELEM_MAX];
 
@@ -1923,105 +2160,36 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 
 	/* Analyze equipment */
 	for (i = 0; i < p->body.count; i++) {
-		int index = 0;
-		struct object *obj = slot_object(p, i);
-		struct curse_data *curse = obj ? obj->curses : NULL;
+		struct slot_bonus scratch;
+		const struct slot_bonus *b;
 
-		while (obj) {
-			int dig = 0;
-
-			/* Extract the item flags */
-			if (known_only) {
-				object_flags_known(obj, f);
-			} else {
-				object_flags(obj, f);
-			}
-			of_union(collect_f, f);
-
-			/* Apply modifiers */
-			state->stat_add[STAT_STR] += obj->modifiers[OBJ_MOD_STR]
-				* p->obj_k->modifiers[OBJ_MOD_STR];
-			state->stat_add[STAT_INT] += obj->modifiers[OBJ_MOD_INT]
-				* p->obj_k->modifiers[OBJ_MOD_INT];
-			state->stat_add[STAT_WIS] += obj->modifiers[OBJ_MOD_WIS]
-				* p->obj_k->modifiers[OBJ_MOD_WIS];
-			state->stat_add[STAT_DEX] += obj->modifiers[OBJ_MOD_DEX]
-				* p->obj_k->modifiers[OBJ_MOD_DEX];
-			state->stat_add[STAT_CON] += obj->modifiers[OBJ_MOD_CON]
-				* p->obj_k->modifiers[OBJ_MOD_CON];
-			state->skills[SKILL_STEALTH] += obj->modifiers[OBJ_MOD_STEALTH]
-				* p->obj_k->modifiers[OBJ_MOD_STEALTH];
-			state->skills[SKILL_SEARCH] += (obj->modifiers[OBJ_MOD_SEARCH] * 5)
-				* p->obj_k->modifiers[OBJ_MOD_SEARCH];
-
-			state->see_infra += obj->modifiers[OBJ_MOD_INFRA]
-				* p->obj_k->modifiers[OBJ_MOD_INFRA];
-			if (tval_is_digger(obj)) {
-				if (of_has(obj->flags, OF_DIG_1))
-					dig = 1;
-				else if (of_has(obj->flags, OF_DIG_2))
-					dig = 2;
-				else if (of_has(obj->flags, OF_DIG_3))
-					dig = 3;
-			}
-			dig += obj->modifiers[OBJ_MOD_TUNNEL]
-				* p->obj_k->modifiers[OBJ_MOD_TUNNEL];
-			state->skills[SKILL_DIGGING] += (dig * 20);
-			state->speed += obj->modifiers[OBJ_MOD_SPEED]
-				* p->obj_k->modifiers[OBJ_MOD_SPEED];
-			state->dam_red += obj->modifiers[OBJ_MOD_DAM_RED]
-				* p->obj_k->modifiers[OBJ_MOD_DAM_RED];
-			extra_blows += obj->modifiers[OBJ_MOD_BLOWS]
-				* p->obj_k->modifiers[OBJ_MOD_BLOWS];
-			extra_shots += obj->modifiers[OBJ_MOD_SHOTS]
-				* p->obj_k->modifiers[OBJ_MOD_SHOTS];
-			extra_might += obj->modifiers[OBJ_MOD_MIGHT]
-				* p->obj_k->modifiers[OBJ_MOD_MIGHT];
-			extra_moves += obj->modifiers[OBJ_MOD_MOVES]
-				* p->obj_k->modifiers[OBJ_MOD_MOVES];
-
-			/* Apply element info, noting vulnerabilites for later processing */
-			for (j = 0; j < ELEM_MAX; j++) {
-				if (!known_only || obj->known->el_info[j].res_level) {
-					if (obj->el_info[j].res_level == -1)
-						vuln[j] = true;
-
-					/* OK because res_level hasn't included vulnerability yet */
-					if (obj->el_info[j].res_level > state->el_info[j].res_level)
-						state->el_info[j].res_level = obj->el_info[j].res_level;
-				}
-			}
+		if (!slot_object(p, i)) continue;
+		b = get_slot_bonus(p, i, known_only, &scratch);
 
-			/* Apply combat bonuses */
-			state->ac += obj->ac;
-			if (!known_only || obj->known->to_a)
-				state->to_a += obj->to_a;
-			if (!slot_type_is(p, i, EQUIP_WEAPON)
-					&& !slot_type_is(p, i, EQUIP_BOW)) {
-				if (!known_only || obj->known->to_h) {
-					state->to_h += obj->to_h;
-				}
-				if (!known_only || obj->known->to_d) {
-					state->to_d += obj->to_d;
-				}
-			}
-
-			/* Move to any unprocessed curse object */
-			if (curse) {
-				index++;
-				obj = NULL;
-				while (index < z_info->curse_max) {
-					if (curse[index].power) {
-						obj = curses[index].obj;
-						break;
-					} else {
-						index++;
-					}
-				}
-			} else {
-				obj = NULL;
-			}
+		of_union(collect_f, b->flags);
+		for (j = 0; j < STAT_MAX; j++) {
+			state->stat_add[j] += b->stat_add[j];
+		}
+		state->skills[SKILL_STEALTH] += b->stealth;
+		state->skills[SKILL_SEARCH] += b->search;
+		state->skills[SKILL_DIGGING] += b->digging;
+		state->see_infra += b->see_infra;
+		state->speed += b->speed;
+		state->dam_red += b->dam_red;
+		extra_blows += b->blows;
+		extra_shots += b->shots;
+		extra_might += b->might;
+		extra_moves += b->moves;
+		for (j = 0; j < ELEM_MAX; j++) {
+			if (b->vuln[j])
+				vuln[j] = true;
+			if (b->res_level[j] > state->el_info[j].res_level)
+				state->el_info[j].res_level = b->res_level[j];
 		}
+		state->ac += b->ac;
+		state->to_a += b->to_a;
+		state->to_h += b->to_h;
+		state->to_d += b->to_d;
 	}
 
 	/* Apply the collected flags */
@@ -492,6 +492,9 @@ struct player_upkeep {
 	int step_count;			/* Pathfinding: number of steps left */
 	int16_t *steps;			/* Pathfinding: steps in reverse order */
 	struct loc path_dest;		/* Pathfinding: destination grid */
+	struct slot_bonus *slot_bonus;	/* Cached equipment contributions to
+					 * the player state, two per slot */
+	int slot_bonus_count;		/* Body slots the cache was made for */
 };
 
 /**
@@ -393,6 +393,294 @@ bool projectable(struct chunk *c, struct loc grid1, struct loc grid2, int flg)
 
 
 
+/**
+ * ------------------------------------------------------------------------
+ * Projectability fields
+ * ------------------------------------------------------------------------ */
+/**
+ * Monsters keep asking whether they can project to, or see, the player (or
+ * the decoy the player has set up).  Between the player's moves the answers
+ * only change with the terrain, so they are remembered for every grid near
+ * each centre and worked out the first time they are asked for.  A field is
+ * started afresh when its centre moves, when the terrain of the level
+ * changes, or when a different level is current.
+ */
+struct proj_field {
+	const struct chunk *c;
+	uint32_t terrain_stamp;
+	struct loc centre;
+	bool covertracks;
+	uint8_t *grids;
+};
+
+#define FIELD_PROJ_KNOWN	0x01
+#define FIELD_PROJ			0x02
+#define FIELD_SHORT_KNOWN	0x04
+#define FIELD_SHORT			0x08
+#define FIELD_LOS_KNOWN		0x10
+#define FIELD_LOS			0x20
+
+/* One for the player and one for a decoy */
+static struct proj_field proj_fields[2];
+static int proj_field_next;
+static int proj_field_side;
+
+static void cleanup_proj_fields(void)
+{
+	size_t i;
+
+	for (i = 0; i < N_ELEMENTS(proj_fields); i++) {
+		mem_free(proj_fields[i].grids);
+		proj_fields[i].grids = NULL;
+		proj_fields[i].c = NULL;
+	}
+	proj_field_side = 0;
+}
+
+/**
+ * Get the field centred on a grid, if it is near enough to the grid asked
+ * about; otherwise return NULL
+ */
+static struct proj_field *proj_field_get(struct chunk *c, struct loc grid,
+		struct loc centre)
+{
+	int rad = z_info->max_range;
+	bool covertracks = player && player->timed[TMD_COVERTRACKS];
+	struct proj_field *field = NULL;
+	size_t i;
+
+	if (ABS(grid.y - centre.y) > rad || ABS(grid.x - centre.x) > rad)
+		return NULL;
+
+	for (i = 0; i < N_ELEMENTS(proj_fields); i++) {
+		if (proj_fields[i].c == c && loc_eq(proj_fields[i].centre, centre)) {
+			field = &proj_fields[i];
+			break;
+		}
+	}
+	if (!field) {
+		field = &proj_fields[proj_field_next];
+		proj_field_next = (proj_field_next + 1) % N_ELEMENTS(proj_fields);
+		field->c = NULL;
+	}
+
+	if (proj_field_side != 2 * rad + 1) {
+		cleanup_proj_fields();
+		proj_field_side = 2 * rad + 1;
+	}
+	if (!field->grids) {
+		field->grids = mem_alloc(proj_field_side * proj_field_side);
+		field->c = NULL;
+	}
+
+	/* Start again if anything the answers depend on has changed */
+	if (field->c != c || field->terrain_stamp != c->terrain_stamp
+			|| field->covertracks != covertracks) {
+		memset(field->grids, 0, proj_field_side * proj_field_side);
+		field->c = c;
+		field->terrain_stamp = c->terrain_stamp;
+		field->centre = centre;
+		field->covertracks = covertracks;
+	}
+	return field;
+}
+
+static uint8_t *proj_field_grid(struct proj_field *field, struct loc grid)
+{
+	int rad = proj_field_side / 2;
+
+	return &field->grids[(grid.y - field->centre.y + rad) * proj_field_side
+		+ grid.x - field->centre.x + rad];
+}
+
+/**
+ * Equivalent to projectable(c, grid, centre, flg) for flg of PROJECT_NONE or
+ * PROJECT_SHORT, but remembered for all the grids around the centre; see
+ * above.  Other flags may depend on where monsters are, so aren't allowed.
+ */
+bool field_projectable(struct chunk *c, struct loc grid, struct loc centre,
+		int flg)
+{
+	struct proj_field *field = proj_field_get(c, grid, centre);
+	uint8_t known = (flg & PROJECT_SHORT) ? FIELD_SHORT_KNOWN
+		: FIELD_PROJ_KNOWN;
+	uint8_t yes = (flg & PROJECT_SHORT) ? FIELD_SHORT : FIELD_PROJ;
+	uint8_t *bits;
+
+	assert(!(flg & ~PROJECT_SHORT));
+	if (!field) return projectable(c, grid, centre, flg);
+
+	bits = proj_field_grid(field, grid);
+	if (!(*bits & known)) {
+		*bits |= known;
+		if (projectable(c, grid, centre, flg)) *bits |= yes;
+	}
+	assert(!!(*bits & yes) == projectable(c, grid, centre, flg));
+	return (*bits & yes) ? true : false;
+}
+
+/**
+ * Equivalent to los(c, grid, centre), but remembered for all the grids
+ * around the centre
+ */
+bool field_los(struct chunk *c, struct loc grid, struct loc centre)
+{
+	struct proj_field *field = proj_field_get(c, grid, centre);
+	uint8_t *bits;
+
+	if (!field) return los(c, grid, centre);
+
+	bits = proj_field_grid(field, grid);
+	if (!(*bits & FIELD_LOS_KNOWN)) {
+		*bits |= FIELD_LOS_KNOWN;
+		if (los(c, grid, centre)) *bits |= FIELD_LOS;
+	}
+	assert(!!(*bits & FIELD_LOS) == los(c, grid, centre));
+	return (*bits & FIELD_LOS) ? true : false;
+}
+
+/**
+ * ------------------------------------------------------------------------
+ * Blast footprints
+ * ------------------------------------------------------------------------ */
+/**
+ * Distance from the centre only grows along a row, so the grids of a blast
+ * of radius r in the row dy away from the centre are a contiguous run;
+ * blast_width[r][dy + r] is the half-width of that run.  Radii up to
+ * z_info->max_range are tabulated once, larger ones worked out as needed.
+ */
+static int **blast_width;
+static int blast_width_max = -1;
+
+/**
+ * Scratch map of the blast area plus a one grid border, reused by every
+ * projection, remembering los() from the centre and the projection path
+ */
+static uint8_t *blast_scratch;
+static size_t blast_scratch_size;
+
+#define BLAST_LOS_KNOWN	0x01
+#define BLAST_LOS		0x02
+#define BLAST_ON_PATH	0x04
+
+static int blast_row_width(int rad, int dy)
+{
+	int ax = rad;
+
+	if (rad <= blast_width_max) return blast_width[rad][dy + rad];
+	while (ax > 0 && distance(loc(0, 0), loc(ax, dy)) > rad) ax--;
+	return ax;
+}
+
+static void init_blast_widths(void)
+{
+	int rad, dy;
+
+	blast_width_max = -1;
+	blast_width = mem_zalloc((z_info->max_range + 1) * sizeof(*blast_width));
+	for (rad = 0; rad <= z_info->max_range; rad++) {
+		blast_width[rad] = mem_zalloc((2 * rad + 1)
+			* sizeof(**blast_width));
+		for (dy = -rad; dy <= rad; dy++) {
+			blast_width[rad][dy + rad] = blast_row_width(rad, dy);
+		}
+	}
+	blast_width_max = z_info->max_range;
+}
+
+static void cleanup_project(void)
+{
+	int rad;
+
+	if (blast_width) {
+		for (rad = 0; rad <= blast_width_max; rad++) {
+			mem_free(blast_width[rad]);
+		}
+	}
+	mem_free(blast_width);
+	blast_width = NULL;
+	blast_width_max = -1;
+	mem_free(blast_scratch);
+	blast_scratch = NULL;
+	blast_scratch_size = 0;
+	cleanup_proj_fields();
+}
+
+struct init_module project_module = {
+	.name = "project",
+	.init = init_blast_widths,
+	.cleanup = cleanup_project
+};
+
+/**
+ * Clear the scratch map for a blast of the given radius
+ */
+static void blast_scratch_reset(int rad)
+{
+	size_t side = 2 * rad + 3;
+
+	if (side * side > blast_scratch_size) {
+		blast_scratch_size = side * side;
+		mem_free(blast_scratch);
+		blast_scratch = mem_alloc(blast_scratch_size);
+	}
+	memset(blast_scratch, 0, side * side);
+}
+
+/**
+ * The scratch map entry for a grid within one grid of the blast area
+ */
+static uint8_t *blast_cell(struct loc centre, int rad, struct loc grid)
+{
+	int side = 2 * rad + 3;
+
+	return &blast_scratch[(grid.y - centre.y + rad + 1) * side
+		+ grid.x - centre.x + rad + 1];
+}
+
+/**
+ * los() from the blast centre, working out each grid at most once
+ */
+static bool blast_los(struct loc centre, int rad, struct loc grid)
+{
+	uint8_t *cell = blast_cell(centre, rad, grid);
+
+	if (!(*cell & BLAST_LOS_KNOWN)) {
+		*cell |= BLAST_LOS_KNOWN;
+		if (los(cave, centre, grid)) *cell |= BLAST_LOS;
+	}
+	return (*cell & BLAST_LOS) ? true : false;
+}
+
+/**
+ * The damage done at a given distance from the centre of a projection.
+ * diameter_of_source controls how quickly explosions lose strength with
+ * distance; see project().
+ */
+static int project_dam_at_dist(int dam, int dist, int rad,
+		uint8_t diameter_of_source)
+{
+	uint32_t dam_temp;
+
+	if (dist > rad) {
+		/* No damage outside the radius. */
+		dam_temp = 0;
+	} else if ((!diameter_of_source) || (dist == 0)) {
+		/* Standard damage calc. for 10' source diameters, or at origin. */
+		dam_temp = (dam + dist) / (dist + 1);
+	} else {
+		/* If a particular diameter for the source of the explosion's
+		 * energy is given, it is full strength to that diameter and
+		 * then reduces */
+		dam_temp = (diameter_of_source * dam) / (dist + 1);
+		if (dam_temp > (uint32_t) dam) {
+			dam_temp = dam;
+		}
+	}
+	return dam_temp;
+}
+
+
 /**
  * ------------------------------------------------------------------------
  * The main project() function and its helpers
@@ -580,8 +868,6 @@ bool project(struct source origin, int rad, struct loc finish,
 {
 	int i, j, k, dist_from_centre;
 
-	uint32_t dam_temp;
-
 	struct loc centre;
 	struct loc start;
 
@@ -615,8 +901,8 @@ bool project(struct source origin, int rad, struct loc finish,
 	/* Player visibility of each of the affected grids. */
 	bool player_sees_grid[256];
 
-	/* Precalculated damage values for each distance. */
-	int *dam_at_dist = mem_alloc((z_info->max_range + 1) * sizeof(*dam_at_dist));
+	/* Damage done at each of the affected grids. */
+	int dam_at_grid[256];
 
 	/* Flush any pending output */
 	handle_stuff(player);
@@ -766,11 +1052,22 @@ bool project(struct source origin, int rad, struct loc finish,
 			num_grids++;
 		}
 
-		/* Scan every grid that might possibly be in the blast radius. */
+		/* Mark the projection path where it crosses the blast area */
+		blast_scratch_reset(rad);
+		for (i = 0; i < num_path_grids; i++) {
+			if (ABS(path_grid[i].y - centre.y) <= rad &&
+				ABS(path_grid[i].x - centre.x) <= rad) {
+				*blast_cell(centre, rad, path_grid[i]) |= BLAST_ON_PATH;
+			}
+		}
+
+		/* Scan every grid within the blast radius, in rows. */
 		for (y = centre.y - rad; y <= centre.y + rad; y++) {
-			for (x = centre.x - rad; x <= centre.x + rad; x++) {
+			int width = blast_row_width(rad, y - centre.y);
+
+			for (x = centre.x - width; x <= centre.x + width; x++) {
 				struct loc grid = loc(x, y);
-				bool on_path = false;
+				bool on_path;
 
 				/* Center grid has already been stored. */
 				if (loc_eq(grid, centre))
@@ -797,7 +1094,7 @@ bool project(struct source origin, int rad, struct loc finish,
 						/* Check neighbors */
 						for (i = 0; i < 8; i++) {
 							struct loc adj_grid = loc_sum(grid, ddgrid_ddd[i]);
-							if (los(cave, centre, adj_grid)) {
+							if (blast_los(centre, rad, adj_grid)) {
 								can_see_one = true;
 								break;
 							}
@@ -810,17 +1107,12 @@ bool project(struct source origin, int rad, struct loc finish,
 				} else if (!square_isprojectable(cave, grid))
 					continue;
 
-				/* Must be within maximum distance. */
+				/* Already known to be within maximum distance. */
 				dist_from_centre  = (distance(centre, grid));
-				if (dist_from_centre > rad)
-					continue;
 
 				/* Mark grids which are on the projection path */
-				for (i = 0; i < num_path_grids; i++) {
-					if (loc_eq(grid, path_grid[i])) {
-						on_path = true;
-					}
-				}
+				on_path = (*blast_cell(centre, rad, grid) & BLAST_ON_PATH)
+					? true : false;
 
 				/* Do we need to consider a restricted angle? */
 				if (flg & (PROJECT_ARC)) {
@@ -845,7 +1137,7 @@ bool project(struct source origin, int rad, struct loc finish,
 				}
 
 				/* Accept remaining grids if in LOS or on the projection path */
-				if (los(cave, centre, grid) || on_path) {
+				if (on_path || blast_los(centre, rad, grid)) {
 					blast_grid[num_grids].y = y;
 					blast_grid[num_grids].x = x;
 					distance_to_grid[num_grids] = dist_from_centre;
@@ -856,29 +1148,6 @@ bool project(struct source origin, int rad, struct loc finish,
 		}
 	}
 
-	/* Calculate and store the actual damage at each distance. */
-	for (i = 0; i <= z_info->max_range; i++) {
-		if (i > rad) {
-			/* No damage outside the radius. */
-			dam_temp = 0;
-		} else if ((!diameter_of_source) || (i == 0)) {
-			/* Standard damage calc. for 10' source diameters, or at origin. */
-			dam_temp = (dam + i) / (i + 1);
-		} else {
-			/* If a particular diameter for the source of the explosion's
-			 * energy is given, it is full strength to that diameter and
-			 * then reduces */
-			dam_temp = (diameter_of_source * dam) / (i + 1);
-			if (dam_temp > (uint32_t) dam) {
-				dam_temp = dam;
-			}
-		}
-
-		/* Store it. */
-		dam_at_dist[i] = dam_temp;
-	}
-
-
 	/* Sort the blast grids by distance from the centre. */
 	for (i = 0, k = 0; i <= rad; i++) {
 		/* Collect all the grids of a given distance together. */
@@ -900,7 +1169,8 @@ bool project(struct source origin, int rad, struct loc finish,
 		}
 	}
 
-	/* Establish which grids are visible - no blast visuals with PROJECT_HIDE */
+	/* Establish which grids are visible - no blast visuals with PROJECT_HIDE
+	 * - and the damage done at each */
 	for (i = 0; i < num_grids; i++) {
 		if (panel_contains(blast_grid[i].y, blast_grid[i].x) &&
 			square_isview(cave, blast_grid[i]) &&
@@ -909,6 +1179,8 @@ bool project(struct source origin, int rad, struct loc finish,
 		} else {
 			player_sees_grid[i] = false;
 		}
+		dam_at_grid[i] = project_dam_at_dist(dam, distance_to_grid[i], rad,
+			diameter_of_source);
 	}
 
 	/* Tell the UI to display the blast */
@@ -919,7 +1191,7 @@ bool project(struct source origin, int rad, struct loc finish,
 	if (flg & (PROJECT_ITEM)) {
 		for (i = 0; i < num_grids; i++) {
 			if (project_o(origin, distance_to_grid[i], blast_grid[i],
-						  dam_at_dist[distance_to_grid[i]], typ, obj)) {
+						  dam_at_grid[i], typ, obj)) {
 				notice = true;
 			}
 		}
@@ -947,7 +1219,7 @@ bool project(struct source origin, int rad, struct loc finish,
 
 			/* Affect the monster in the grid */
 			project_m(origin, distance_to_grid[i], blast_grid[i],
-			          dam_at_dist[distance_to_grid[i]], typ, flg,
+			          dam_at_grid[i], typ, flg,
 			          &did_hit, &was_obvious);
 			if (was_obvious) {
 				notice = true;
@@ -995,11 +1267,10 @@ bool project(struct source origin, int rad, struct loc finish,
 		}
 		for (i = 0; i < num_grids; i++) {
 			if (project_p(origin, distance_to_grid[i], blast_grid[i],
-						  dam_at_dist[distance_to_grid[i]], typ, power,
+						  dam_at_grid[i], typ, power,
 						  flg & PROJECT_SELF)) {
 				notice = true;
 				if (player->is_dead) {
-					mem_free(dam_at_dist);
 					return notice;
 				}
 				break;
@@ -1011,7 +1282,7 @@ bool project(struct source origin, int rad, struct loc finish,
 	if (flg & (PROJECT_GRID)) {
 		for (i = 0; i < num_grids; i++) {
 			if (project_f(origin, distance_to_grid[i], blast_grid[i],
-						  dam_at_dist[distance_to_grid[i]], typ)) {
+						  dam_at_grid[i], typ)) {
 				notice = true;
 			}
 		}
@@ -1026,8 +1297,6 @@ bool project(struct source origin, int rad, struct loc finish,
 	/* Update stuff if needed */
 	if (player->upkeep->update) update_stuff(player);
 
-	mem_free(dam_at_dist);
-
 	/* Return "something was noticed" */
 	return (notice);
 }
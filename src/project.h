@@ -119,6 +119,9 @@ bool project_p(struct source, int r, struct loc grid, int dam, int typ,
 int project_path(struct chunk *c, struct loc *gp, int range, struct loc grid1,
 	struct loc grid2, int flg);
 bool projectable(struct chunk *c, struct loc grid1, struct loc grid2, int flg);
+bool field_projectable(struct chunk *c, struct loc grid, struct loc centre,
+	int flg);
+bool field_los(struct chunk *c, struct loc grid, struct loc centre);
 int proj_name_to_idx(const char *name);
 const char *proj_idx_to_name(int type);
 
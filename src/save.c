@@ -19,6 +19,7 @@
 #include "angband.h"
 #include "cave.h"
 #include "game-world.h"
+#include "generate.h"
 #include "init.h"
 #include "mon-group.h"
 #include "mon-lore.h"
@@ -756,6 +757,9 @@ void wr_stores(void)
 		/* Save the stock size */
 		wr_byte(store->stock_num);
 
+		/* Save the maintenance not done yet */
+		wr_u16b(store->days_owed);
+
 		/* Save the stock */
 		for (obj = store->stock; obj; obj = obj->next) {
 			wr_item(obj->known);
@@ -995,8 +999,48 @@ void wr_traps(void)
 	wr_traps_aux(player->cave);
 }
 
+/*
+ * Write one stored chunk
+ */
+static void wr_chunk_aux(struct chunk *c)
+{
+	/* Write the terrain and info */
+	wr_dungeon_aux(c);
+
+	/* Write the objects */
+	wr_objects_aux(c);
+
+	/* Write the monsters */
+	wr_monsters_aux(c);
+
+	/* Write the traps */
+	wr_traps_aux(c);
+
+	/* Write other chunk info */
+	if (OPT(player, birth_levels_persist)) {
+		int i;
+
+		wr_string(c->name);
+		wr_s32b(c->turn);
+		wr_u16b(c->depth);
+		wr_byte(c->feeling);
+		wr_u32b(c->obj_rating);
+		wr_u32b(c->mon_rating);
+		wr_byte(c->good_item ? 1 : 0);
+		wr_u16b(c->height);
+		wr_u16b(c->width);
+		wr_u16b(c->feeling_squares);
+		for (i = 0; i < FEAT_MAX + 1; i++) {
+			wr_u16b(c->feat_count[i]);
+		}
+	}
+}
+
 /*
  * Write the chunk list
+ *
+ * A packed chunk cannot change until it is unpacked, so its record is kept
+ * the first time it is written and simply copied out on later saves.
  */
 void wr_chunks(void)
 {
@@ -1010,36 +1054,21 @@ void wr_chunks(void)
 	/* Now write each chunk */
 	for (j = 0; j < chunk_list_max; j++) {
 		struct chunk *c = chunk_list[j];
+		bool packed = chunk_is_packed(c);
+		uint32_t mark;
 
-		/* Write the terrain and info */
-		wr_dungeon_aux(c);
-
-		/* Write the objects */
-		wr_objects_aux(c);
-
-		/* Write the monsters */
-		wr_monsters_aux(c);
-
-		/* Write the traps */
-		wr_traps_aux(c);
-
-		/* Write other chunk info */
-		if (OPT(player, birth_levels_persist)) {
-			int i;
-
-			wr_string(c->name);
-			wr_s32b(c->turn);
-			wr_u16b(c->depth);
-			wr_byte(c->feeling);
-			wr_u32b(c->obj_rating);
-			wr_u32b(c->mon_rating);
-			wr_byte(c->good_item ? 1 : 0);
-			wr_u16b(c->height);
-			wr_u16b(c->width);
-			wr_u16b(c->feeling_squares);
-			for (i = 0; i < FEAT_MAX + 1; i++) {
-				wr_u16b(c->feat_count[i]);
-			}
+		if (c->save_image) {
+			assert(packed);
+			wr_bytes(c->save_image, c->save_image_len);
+			continue;
+		}
+
+		if (packed) chunk_unpack(c);
+		mark = wr_tell();
+		wr_chunk_aux(c);
+		if (packed) {
+			chunk_pack(c);
+			c->save_image = wr_copy_since(mark, &c->save_image_len);
 		}
 	}
 }
@@ -118,7 +118,7 @@ static const struct {
 	{ "player hp", wr_player_hp, 1 },
 	{ "player spells", wr_player_spells, 1 },
 	{ "gear", wr_gear, 1 },
-	{ "stores", wr_stores, 1 },
+	{ "stores", wr_stores, 2 },
 	{ "dungeon", wr_dungeon, 1 },
 	{ "objects", wr_objects, 1 },
 	{ "monsters", wr_monsters, 1 },
@@ -145,7 +145,8 @@ static const struct blockinfo loaders[] = {
 	{ "player hp", rd_player_hp, 1 },
 	{ "player spells", rd_player_spells, 1 },
 	{ "gear", rd_gear, 1 },	
-	{ "stores", rd_stores, 1 },	
+	{ "stores", rd_stores, 2 },
+	{ "stores", rd_stores_1, 1 },
 	{ "dungeon", rd_dungeon, 1 },
 	{ "objects", rd_objects, 1 },	
 	{ "monsters", rd_monsters, 1 },
@@ -315,6 +316,36 @@ void pad_bytes(int n)
 	while (n--) wr_byte(0);
 }
 
+/**
+ * Write a block of bytes previously copied with wr_copy_since()
+ */
+void wr_bytes(const uint8_t *data, uint32_t len)
+{
+	while (len--) sf_put(*data++);
+}
+
+/**
+ * Get the current write position, for use with wr_copy_since()
+ */
+uint32_t wr_tell(void)
+{
+	return buffer_pos;
+}
+
+/**
+ * Copy everything written since the position mark into a new allocation
+ */
+uint8_t *wr_copy_since(uint32_t mark, uint32_t *len)
+{
+	uint8_t *copy;
+
+	assert(mark <= buffer_pos);
+	*len = buffer_pos - mark;
+	copy = mem_alloc(*len ? *len : 1);
+	memcpy(copy, buffer + mark, *len);
+	return copy;
+}
+
 
 /**
  * ------------------------------------------------------------------------
@@ -70,6 +70,9 @@ void wr_u32b(uint32_t v);
 void wr_s32b(int32_t v);
 void wr_string(const char *str);
 void pad_bytes(int n);
+void wr_bytes(const uint8_t *data, uint32_t len);
+uint32_t wr_tell(void);
+uint8_t *wr_copy_since(uint32_t mark, uint32_t *len);
 
 /* Reading bits */
 void rd_byte(uint8_t *ip);
@@ -97,6 +100,7 @@ int rd_player_hp(void);
 int rd_player_spells(void);
 int rd_gear(void);
 int rd_stores(void);
+int rd_stores_1(void);
 int rd_dungeon(void);
 int rd_chunks(void);
 int rd_objects(void);
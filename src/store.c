@@ -44,7 +44,8 @@
 #include "debug.h"
 
 
-static void store_maint(struct store *s);
+static void store_maint(struct store *s, int days);
+static void store_owe_days(struct store *s, int days);
 
 /**
  * ------------------------------------------------------------------------
@@ -338,7 +339,7 @@ void store_init(void)
 }
 
 void store_reset(void) {
-	int i, j;
+	int i;
 	struct store *s;
 
 	for (i = 0; i < z_info->store_max; i++) {
@@ -349,10 +350,10 @@ void store_reset(void) {
 		object_pile_free(NULL, NULL, s->stock);
 		s->stock_k = NULL;
 		s->stock = NULL;
-		if (s->feat == FEAT_HOME)
-			continue;
-		for (j = 0; j < 10; j++)
-			store_maint(s);
+		s->days_owed = 0;
+
+		/* Stocked afresh when first visited */
+		store_owe_days(s, STORE_RESTOCK_DAYS);
 	}
 }
 
@@ -1285,10 +1286,20 @@ static struct object *store_create_item(struct store *store,
 }
 
 /**
- * Maintain the inventory at the stores.
+ * Maintain the inventory at a store for a number of days at once.
+ *
+ * Each day sells off a few items, replaces any missing staples and buys in
+ * a few new items, as the store has always done.  Anything bought in on one
+ * day may be sold off again on a later one, so rather than making items
+ * only to throw them away, the new items are counted as they would have been
+ * bought and sold, and only made once all the days are done.  A single day
+ * uses the random numbers exactly as it always has.
  */
-static void store_maint(struct store *s)
+static void store_maint(struct store *s, int days)
 {
+	/* Items bought in but not made yet */
+	int fresh = 0;
+
 	/* Ignore home */
 	if (s->feat == FEAT_HOME)
 		return;
@@ -1326,78 +1337,93 @@ static void store_maint(struct store *s)
 	 * has two tests for s->turnover, but simplifies everything else
 	 * dramatically.
 	 */
+	while (days--) {
+		if (s->turnover) {
+			int restock_attempts = 100000;
+			int stock = s->stock_num + fresh - randint1(s->turnover);
+
+			/* We'll end up adding staples for sure, maybe plus
+			 * other items. It's fine if we sell out completely,
+			 * though, if turnover is high. The cap doesn't include
+			 * always_num, because otherwise the addition of missing
+			 * staples could put us over (if the store was full of
+			 * player-sold loot).
+			 */
+			int min = 0;
+			int max = s->normal_stock_max;
+
+			if (stock < min) stock = min;
+			if (stock > max) stock = max;
+
+			/* Destroy random objects until only "stock" slots are
+			 * left, choosing among the unmade ones too */
+			while (s->stock_num + fresh > stock && --restock_attempts) {
+				if (fresh && randint0(s->stock_num + fresh) < fresh)
+					fresh--;
+				else
+					store_delete_random(s);
+			}
 
-	if (s->turnover) {
-		int restock_attempts = 100000;
-		int stock = s->stock_num - randint1(s->turnover);
-
-		/* We'll end up adding staples for sure, maybe plus other
-		 * items. It's fine if we sell out completely, though, if
-		 * turnover is high. The cap doesn't include always_num,
-		 * because otherwise the addition of missing staples could
-		 * put us over (if the store was full of player-sold loot).
-		 */
-		int min = 0;
-		int max = s->normal_stock_max;
-
-		if (stock < min) stock = min;
-		if (stock > max) stock = max;
+			if (!restock_attempts)
+				quit_fmt("Unable to (de-)stock %s. Please report this bug",
+					(f_info[s->feat].name) ? f_info[s->feat].name :
+					format("store %d", f_info[s->feat].shopnum));
+		} else {
+			/* For the Bookseller, occasionally sell a book */
+			if (s->always_num && s->stock_num) {
+				int sales = randint1(s->stock_num);
+				while (sales--) {
+					store_delete_random(s);
+				}
+			}
+		}
 
-		/* Destroy random objects until only "stock" slots are left */
-		while (s->stock_num > stock && --restock_attempts)
-			store_delete_random(s);
+		/* Ensure staples are created */
+		if (s->always_num) {
+			size_t i;
+			for (i = 0; i < s->always_num; i++) {
+				struct object_kind *kind = s->always_table[i];
+				struct object *obj = store_find_kind(s, kind,
+					store_sale_should_reduce_stock);
+
+				/* Create the item if it doesn't exist */
+				if (!obj) {
+					obj = store_create_item(s, kind);
+					if (!obj) continue;
+				}
 
-		if (!restock_attempts)
-			quit_fmt("Unable to (de-)stock %s. Please report this bug",
-				(f_info[s->feat].name) ? f_info[s->feat].name :
-				format("store %d", f_info[s->feat].shopnum));
-	} else {
-		/* For the Bookseller, occasionally sell a book */
-		if (s->always_num && s->stock_num) {
-			int sales = randint1(s->stock_num);
-			while (sales--) {
-				store_delete_random(s);
+				/* Ensure a full stack */
+				obj->number = obj->kind->base->max_stack;
+				obj->known->number = obj->kind->base->max_stack;
 			}
 		}
-	}
 
-	/* Ensure staples are created */
-	if (s->always_num) {
-		size_t i;
-		for (i = 0; i < s->always_num; i++) {
-			struct object_kind *kind = s->always_table[i];
-			struct object *obj = store_find_kind(s, kind,
-				store_sale_should_reduce_stock);
-
-			/* Create the item if it doesn't exist */
-			if (!obj) {
-				obj = store_create_item(s, kind);
-				if (!obj) continue;
-			}
+		if (s->turnover) {
+			int stock = s->stock_num + fresh + randint1(s->turnover);
 
-			/* Ensure a full stack */
-			obj->number = obj->kind->base->max_stack;
-			obj->known->number = obj->kind->base->max_stack;
-		}
-	}
+			/* Now that the staples exist, we want to add more
+			 * items, at least enough to get us to normal_stock_min
+			 * items that aren't necessarily staples.
+			 */
 
-	if (s->turnover) {
-		int restock_attempts = 100000;
-		int stock = s->stock_num + randint1(s->turnover);
+			int min = s->normal_stock_min + s->always_num;
+			int max = s->normal_stock_max + s->always_num;
 
-		/* Now that the staples exist, we want to add more
-		 * items, at least enough to get us to normal_stock_min
-		 * items that aren't necessarily staples.
-		 */
+			/* Buy a few items */
 
-		int min = s->normal_stock_min + s->always_num;
-		int max = s->normal_stock_max + s->always_num;
+			/* Keep stock between specified min and max slots */
+			if (stock > max) stock = max;
+			if (stock < min) stock = min;
 
-		/* Buy a few items */
+			/* Made once the last day is done */
+			if (stock > s->stock_num + fresh)
+				fresh = stock - s->stock_num;
+		}
+	}
 
-		/* Keep stock between specified min and max slots */
-		if (stock > max) stock = max;
-		if (stock < min) stock = min;
+	if (fresh) {
+		int restock_attempts = 100000;
+		int stock = s->stock_num + fresh;
 
 		/* For the rest, we just choose items randomlyish */
 		/* The (huge) restock_attempts will only go to zero (otherwise
@@ -1413,47 +1439,58 @@ static void store_maint(struct store *s)
 }
 
 /**
- * Update the stores on the return to town.
+ * Bring a store up to date with the days it has been left unattended,
+ * before its stock is looked at
  */
-void store_update(void)
+void store_catch_up(struct store *s)
 {
-	if (OPT(player, cheat_xtra)) msg("Updating Shops...");
-	while (daycount--) {
-		int n;
+	if (!s || !s->days_owed) return;
+	store_maint(s, s->days_owed);
+	s->days_owed = 0;
+}
 
-		/* Maintain each shop (except home) */
-		for (n = 0; n < z_info->store_max; n++) {
-			/* Skip the home */
-			if (stores[n].feat == FEAT_HOME) continue;
+/**
+ * Owe a store some days of maintenance
+ */
+static void store_owe_days(struct store *s, int days)
+{
+	if (s->feat == FEAT_HOME) return;
+	s->days_owed = MIN(s->days_owed + days, UINT16_MAX);
+}
 
-			/* Maintain */
-			store_maint(&stores[n]);
-		}
+/**
+ * Update the stores on the return to town.
+ *
+ * Each store only notes the days that have passed; the maintenance itself
+ * waits until the store is entered or its stock inspected.
+ */
+void store_update(void)
+{
+	int *non_home_inds = mem_zalloc(z_info->store_max
+		* sizeof(*non_home_inds));
+	int n_without_home = 0;
+	int n;
 
-		/* Sometimes, shuffle the shop-keepers */
-		if (one_in_(z_info->store_shuffle)) {
-			int *non_home_inds = mem_zalloc(z_info->store_max
-				* sizeof(*non_home_inds));
-			int n_without_home = 0;
+	if (OPT(player, cheat_xtra)) msg("Updating Shops...");
+	for (n = 0; n < z_info->store_max; n++) {
+		if (stores[n].feat == FEAT_HOME) continue;
+		store_owe_days(&stores[n], daycount);
+		non_home_inds[n_without_home] = n;
+		++n_without_home;
+	}
 
+	/* Sometimes, shuffle the shop-keepers */
+	while (daycount--) {
+		if (one_in_(z_info->store_shuffle) && n_without_home > 0) {
 			/* Message */
 			if (OPT(player, cheat_xtra)) msg("Shuffling a Shopkeeper...");
 
-			/* Pick a random shop (except home) */
-			for (n = 0; n < z_info->store_max; n++) {
-				if (stores[n].feat != FEAT_HOME) {
-					non_home_inds[n_without_home] = n;
-					++n_without_home;
-				}
-			}
-			if (n_without_home > 0) {
-				n = randint0(n_without_home);
-				/* Then suffle it. */
-				store_shuffle(&stores[non_home_inds[n]]);
-			}
-			mem_free(non_home_inds);
+			/* Pick a random shop (except home) and shuffle it */
+			n = randint0(n_without_home);
+			store_shuffle(&stores[non_home_inds[n]]);
 		}
 	}
+	mem_free(non_home_inds);
 	daycount = 0;
 	if (OPT(player, cheat_xtra)) msg("Done.");
 }
@@ -1751,8 +1788,6 @@ void do_cmd_buy(struct command *cmd)
 
 		/* Store is empty */
 		if (store->stock_num == 0) {
-			int i;
-
 			/* Sometimes shuffle the shopkeeper */
 			if (one_in_(z_info->store_shuffle)) {
 				/* Shuffle */
@@ -1763,8 +1798,8 @@ void do_cmd_buy(struct command *cmd)
 				msg("The shopkeeper brings out some new stock.");
 
 			/* New inventory */
-			for (i = 0; i < 10; ++i)
-				store_maint(store);
+			store_owe_days(store, STORE_RESTOCK_DAYS);
+			store_catch_up(store);
 		}
 	}
 
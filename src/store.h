@@ -25,6 +25,11 @@
 #include "datafile.h"
 #include "object.h"
 
+/**
+ * Days of maintenance that stock a store from empty
+ */
+#define STORE_RESTOCK_DAYS 10
+
 struct object_buy {
 	struct object_buy *next;
 	size_t tval;
@@ -64,6 +69,8 @@ struct store {
 	int turnover;
 	int normal_stock_min;
 	int normal_stock_max;
+
+	uint16_t days_owed;		/* Days of maintenance not done yet */
 };
 
 extern struct store *stores;
@@ -77,6 +84,7 @@ struct object *store_carry(struct store *store, struct object *obj);
 void store_reset(void);
 void store_shuffle(struct store *store);
 void store_update(void);
+void store_catch_up(struct store *s);
 int price_item(struct store *store, const struct object *obj,
 			   bool store_buying, int qty);
 
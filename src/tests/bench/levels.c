@@ -0,0 +1,114 @@
+/* bench/levels
+ *
+ * Benchmark for generating levels across the dungeon, counting how many
+ * attempts at levels and rooms fail on the way and checking the report on
+ * each attempt agrees.  Run with -b (or run-tests --bench) to time it;
+ * otherwise it runs once.
+ */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "game-event.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "player-birth.h"
+#include "z-rand.h"
+
+#define TEST_SEED 0x1e7e15ee
+
+struct gen_counts {
+	int levels, failed_levels;
+	int rooms, failed_rooms;
+	int attempts, failed_attempts, bad_reports;
+	long usec, grids;
+};
+
+static struct gen_counts counts;
+
+static void count_level(game_event_type type, game_event_data *data,
+		void *user)
+{
+	if (data->flag) counts.levels++; else counts.failed_levels++;
+}
+
+static void count_room(game_event_type type, game_event_data *data,
+		void *user)
+{
+	if (data->flag) counts.rooms++; else counts.failed_rooms++;
+}
+
+static void count_attempt(game_event_type type, game_event_data *data,
+		void *user)
+{
+	counts.attempts++;
+	if (data->attempt.reason) counts.failed_attempts++;
+	if (!data->attempt.profile || data->attempt.number < 0
+			|| data->attempt.usec < 0 || data->attempt.grids <= 0)
+		counts.bad_reports++;
+	counts.usec += data->attempt.usec;
+	counts.grids += data->attempt.grids;
+}
+
+int setup_tests(void **state) {
+	set_file_paths();
+	if (!init_angband()) {
+		return 1;
+	}
+#ifdef UNIX
+	create_needed_dirs();
+#endif
+	if (!player_make_simple(NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+	event_add_handler(EVENT_GEN_LEVEL_END, count_level, NULL);
+	event_add_handler(EVENT_GEN_ROOM_END, count_room, NULL);
+	event_add_handler(EVENT_GEN_LEVEL_ATTEMPT, count_attempt, NULL);
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	event_remove_handler(EVENT_GEN_LEVEL_END, count_level, NULL);
+	event_remove_handler(EVENT_GEN_ROOM_END, count_room, NULL);
+	event_remove_handler(EVENT_GEN_LEVEL_ATTEMPT, count_attempt, NULL);
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	return 0;
+}
+
+static int test_generate(void *state) {
+	/* Seeding depends on where the table index was left */
+	state_i = 0;
+	Rand_state_init(TEST_SEED);
+	memset(&counts, 0, sizeof(counts));
+	bench("generate levels", 1) {
+		int depth;
+
+		for (depth = 1; depth <= 100; depth++) {
+			player->depth = depth;
+			prepare_next_level(player);
+			on_new_level();
+		}
+	}
+	if (verbose) {
+		printf("levels %d (%d failed), rooms %d (%d failed), "
+			"%ld us and %ld grids over %d attempts\n",
+			counts.levels, counts.failed_levels, counts.rooms,
+			counts.failed_rooms, counts.usec, counts.grids,
+			counts.attempts);
+	}
+	require(counts.levels > 0);
+	eq(counts.attempts, counts.levels + counts.failed_levels);
+	eq(counts.failed_attempts, counts.failed_levels);
+	eq(counts.bad_reports, 0);
+	ok;
+}
+
+const char *suite_name = "bench/levels";
+struct test tests[] = {
+	{ "generate", test_generate },
+	{ NULL, NULL }
+};
@@ -0,0 +1,115 @@
+/* bench/parse
+ *
+ * Benchmark for parser_parse() on lines shaped like the game data files.
+ * Run with -b (or run-tests --bench) to time it; otherwise it runs once.
+ */
+
+#include "unit-test.h"
+#include "parser.h"
+
+static const char *lines[] = {
+	"# The grey mold",
+	"name:grey mold",
+	"base:mold",
+	"color:s",
+	"speed:110",
+	"hit-points:28",
+	"hearing:2",
+	"armour:1",
+	"sleepiness:0",
+	"depth:1",
+	"rarity:1",
+	"experience:3",
+	"blow:HIT:HURT:1d4",
+	"blow:HIT:HURT:1d4",
+	"flags:NEVER_MOVE",
+	"flags:IM_POIS | NO_FEAR | NO_CONF | NO_SLEEP | NO_HOLD",
+	"desc:A small strange grey growth.",
+	"",
+};
+
+static enum parser_error parse_str(struct parser *p) {
+	int *count = parser_priv(p);
+
+	if (!parser_getstr(p, "value")) return PARSE_ERROR_GENERIC;
+	(*count)++;
+	return PARSE_ERROR_NONE;
+}
+
+static enum parser_error parse_sym(struct parser *p) {
+	int *count = parser_priv(p);
+
+	if (!parser_getsym(p, "value")) return PARSE_ERROR_GENERIC;
+	(*count)++;
+	return PARSE_ERROR_NONE;
+}
+
+static enum parser_error parse_int(struct parser *p) {
+	int *count = parser_priv(p);
+
+	*count += (parser_getint(p, "value") >= 0);
+	return PARSE_ERROR_NONE;
+}
+
+static enum parser_error parse_blow(struct parser *p) {
+	int *count = parser_priv(p);
+
+	if (!parser_getsym(p, "method") || !parser_getsym(p, "effect")
+			|| !parser_getrand(p, "damage").dice)
+		return PARSE_ERROR_GENERIC;
+	(*count)++;
+	return PARSE_ERROR_NONE;
+}
+
+int setup_tests(void **state) {
+	struct parser *p = parser_new();
+	const char *ints[] = { "speed", "hit-points", "hearing", "armour",
+		"sleepiness", "depth", "rarity", "experience" };
+	size_t i;
+
+	if (!p)
+		return 1;
+	parser_reg(p, "name str value", parse_str);
+	parser_reg(p, "base sym value", parse_sym);
+	parser_reg(p, "color sym value", parse_sym);
+	for (i = 0; i < N_ELEMENTS(ints); i++) {
+		char fmt[32];
+
+		strnfmt(fmt, sizeof(fmt), "%s int value", ints[i]);
+		parser_reg(p, fmt, parse_int);
+	}
+	parser_reg(p, "blow sym method sym effect rand damage", parse_blow);
+	parser_reg(p, "flags ?str value", parse_str);
+	parser_reg(p, "desc str value", parse_str);
+
+	*state = p;
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	parser_destroy(state);
+	return 0;
+}
+
+static int test_parse_monster(void *state) {
+	int count = 0;
+	bool okay = true;
+
+	parser_setpriv(state, &count);
+	bench("parser_parse", 20000) {
+		size_t i;
+
+		for (i = 0; i < N_ELEMENTS(lines); i++)
+			okay = (parser_parse(state, lines[i]) == PARSE_ERROR_NONE)
+				&& okay;
+	}
+	require(okay);
+	require(count >= 16);
+	ok;
+}
+
+const char *suite_name = "bench/parse";
+struct test tests[] = {
+	{ "parse monster", test_parse_monster },
+	{ NULL, NULL }
+};
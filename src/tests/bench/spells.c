@@ -0,0 +1,73 @@
+/* bench/spells
+ *
+ * Benchmark for working out the values of every class spell's effects, as
+ * casting and spell descriptions do, without the random rolls.  Run with -b
+ * (or run-tests --bench) to time it; otherwise it runs once.
+ */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "effects.h"
+#include "effects-info.h"
+#include "init.h"
+#include "player.h"
+#include "player-birth.h"
+#include "z-dice.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+	if (!player_make_simple(NULL, "Mage", "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+	player->lev = 30;
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cleanup_angband();
+	return 0;
+}
+
+static int test_spell_values(void *state) {
+	long total = 0;
+	int rolled = 0;
+
+	bench("spell values", 2000) {
+		struct player_class *c;
+
+		for (c = classes; c; c = c->next) {
+			int i, j;
+
+			for (i = 0; i < c->magic.num_books; i++) {
+				const struct class_book *book = &c->magic.books[i];
+
+				for (j = 0; j < book->num_spells; j++) {
+					struct effect *e;
+
+					for (e = book->spells[j].effect; e; e = e->next) {
+						random_value rv;
+
+						if (!e->dice) continue;
+						dice_random_value(e->dice, &rv);
+						total += rv.base + rv.dice * rv.sides;
+						total += dice_evaluate(e->dice, player->lev,
+							AVERAGE, NULL);
+						total += effect_avg_damage(e, NULL);
+						rolled++;
+					}
+				}
+			}
+		}
+	}
+	require(rolled > 0);
+	require(total != 0);
+	ok;
+}
+
+const char *suite_name = "bench/spells";
+struct test tests[] = {
+	{ "spell values", test_spell_values },
+	{ NULL, NULL }
+};
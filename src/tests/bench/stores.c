@@ -0,0 +1,143 @@
+/* bench/stores
+ *
+ * Benchmark for bringing the stores up to date after days away from town,
+ * one day at a time and all at once, and checks that the days are only
+ * owed until a store is looked at.  Run with -b (or run-tests --bench) to
+ * time it; otherwise it runs once.
+ */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "game-world.h"
+#include "init.h"
+#include "player.h"
+#include "player-birth.h"
+#include "store.h"
+#include "z-rand.h"
+
+#define TEST_SEED 0x5709e5
+#define TEST_DAYS 30
+
+int setup_tests(void **state) {
+	set_file_paths();
+	if (!init_angband()) {
+		return 1;
+	}
+	if (!player_make_simple(NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+	state_i = 0;
+	Rand_state_init(TEST_SEED);
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cleanup_angband();
+	return 0;
+}
+
+/**
+ * True if the stock of a store that has just been maintained is as
+ * maintenance leaves it: within its limits, with full stacks of staples
+ */
+static bool stock_ok(const struct store *s) {
+	const struct object *obj;
+	int num = 0;
+	size_t i;
+
+	for (obj = s->stock; obj; obj = obj->next) num++;
+	if (num != s->stock_num) return false;
+	if (s->turnover && (s->stock_num < s->normal_stock_min
+			|| s->stock_num > s->normal_stock_max + s->always_num))
+		return false;
+	for (i = 0; i < s->always_num; i++) {
+		for (obj = s->stock; obj; obj = obj->next)
+			if (obj->kind == s->always_table[i]) break;
+		if (!obj || obj->number != obj->kind->base->max_stack)
+			return false;
+	}
+	return true;
+}
+
+static int test_owed(void *state) {
+	uint8_t stock[256];
+	int i;
+
+	require(z_info->store_max <= 256);
+
+	/* A reset leaves every store to be stocked when first seen */
+	store_reset();
+	for (i = 0; i < z_info->store_max; i++) {
+		struct store *s = &stores[i];
+
+		eq(s->stock_num, 0);
+		if (s->feat == FEAT_HOME) {
+			eq(s->days_owed, 0);
+			continue;
+		}
+		eq(s->days_owed, STORE_RESTOCK_DAYS);
+		store_catch_up(s);
+		eq(s->days_owed, 0);
+		require(stock_ok(s));
+	}
+
+	/* Coming back to town only notes the days */
+	for (i = 0; i < z_info->store_max; i++)
+		stock[i] = stores[i].stock_num;
+	daycount = 3;
+	store_update();
+	eq(daycount, 0);
+	for (i = 0; i < z_info->store_max; i++) {
+		struct store *s = &stores[i];
+
+		eq(s->days_owed, (s->feat == FEAT_HOME) ? 0 : 3);
+		eq(s->stock_num, stock[i]);
+		s->days_owed = 0;
+	}
+	ok;
+}
+
+static int test_catch_up(void *state) {
+	int checked = 0, bad = 0;
+
+	bench("catch up daily", 20) {
+		int i, day;
+
+		for (i = 0; i < z_info->store_max; i++) {
+			struct store *s = &stores[i];
+
+			if (s->feat == FEAT_HOME) continue;
+			for (day = 0; day < TEST_DAYS; day++) {
+				s->days_owed = 1;
+				store_catch_up(s);
+			}
+			if (!stock_ok(s)) bad++;
+			checked++;
+		}
+	}
+	bench("catch up owed", 20) {
+		int i;
+
+		for (i = 0; i < z_info->store_max; i++) {
+			struct store *s = &stores[i];
+
+			if (s->feat == FEAT_HOME) continue;
+			s->days_owed = TEST_DAYS;
+			store_catch_up(s);
+			eq(s->days_owed, 0);
+			if (!stock_ok(s)) bad++;
+			checked++;
+		}
+	}
+	require(checked > 0);
+	eq(bad, 0);
+	ok;
+}
+
+const char *suite_name = "bench/stores";
+struct test tests[] = {
+	{ "owed", test_owed },
+	{ "catch up", test_catch_up },
+	{ NULL, NULL }
+};
@@ -0,0 +1,6 @@
+TESTPROGS += bench/levels \
+	bench/parse \
+	bench/spells \
+	bench/stores \
+	bench/vaults \
+	bench/world
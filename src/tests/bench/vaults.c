@@ -0,0 +1,146 @@
+/* bench/vaults
+ *
+ * Benchmark for building every vault from its compiled layout, and a check
+ * that picking vaults from the index makes the same choices, with the same
+ * random numbers, as searching the whole list.  Run with -b (or run-tests
+ * --bench) to time it; otherwise it runs once.
+ */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "player-birth.h"
+#include "z-rand.h"
+
+#define TEST_SEED 0x7a017e57
+
+int setup_tests(void **state) {
+	set_file_paths();
+	if (!init_angband()) {
+		return 1;
+	}
+	if (!player_make_simple(NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cleanup_angband();
+	return 0;
+}
+
+/**
+ * Pick a vault by searching the whole list, as was always done
+ */
+static struct vault *search_vaults(int depth, const char *typ) {
+	struct vault *v, *r = NULL;
+	int n = 1;
+
+	for (v = vaults; v; v = v->next) {
+		if (streq(v->typ, typ) && v->min_lev <= depth
+				&& v->max_lev >= depth) {
+			if (one_in_(n)) r = v;
+			n++;
+		}
+	}
+	return r;
+}
+
+static int test_selection(void *state) {
+	struct vault *v;
+	int checked = 0;
+
+	/* The simple generator is fully set by its seed */
+	Rand_quick = true;
+	for (v = vaults; v; v = v->next) {
+		struct vault *first = vaults;
+		int depth;
+
+		/* Each type once */
+		while (!streq(first->typ, v->typ)) first = first->next;
+		if (first != v) continue;
+		for (depth = -1; depth <= 128; depth++) {
+			struct vault *expect, *got;
+			uint32_t expect_next;
+
+			Rand_value = TEST_SEED + depth;
+			expect = search_vaults(depth, v->typ);
+			expect_next = Rand_div(1000000);
+			Rand_value = TEST_SEED + depth;
+			got = random_vault(depth, v->typ);
+			ptreq(got, expect);
+			eq(Rand_div(1000000), expect_next);
+			checked++;
+		}
+	}
+	Rand_quick = false;
+	require(checked > 0);
+	eq(random_vault(1, "No such vault"), NULL);
+	ok;
+}
+
+static int test_stamps(void *state) {
+	struct vault *v;
+
+	for (v = vaults; v; v = v->next) {
+		struct room_stamp *stamp = room_stamp_new(v->text, v->hgt, v->wid);
+		const char *t = v->text;
+		int i = 0, x, y;
+
+		/* The grids which are not blank, in the order of the text */
+		for (y = 0; y < v->hgt && *t; y++) {
+			for (x = 0; x < v->wid && *t; x++, t++) {
+				if (*t == ' ') continue;
+				require(i < stamp->num);
+				eq(stamp->grids[i].x, x);
+				eq(stamp->grids[i].y, y);
+				eq(stamp->grids[i].sym, *t);
+				i++;
+			}
+		}
+		eq(i, stamp->num);
+		room_stamp_free(stamp);
+	}
+	ok;
+}
+
+static int test_build(void *state) {
+	struct dun_data *old_dun = dun;
+	struct dun_data test_dun;
+	int built = 0;
+
+	memset(&test_dun, 0, sizeof(test_dun));
+	dun = &test_dun;
+	Rand_state_init(TEST_SEED);
+	bench("build vaults", 20) {
+		struct vault *v;
+
+		for (v = vaults; v; v = v->next) {
+			struct chunk *c = cave_new(v->hgt + 4, v->wid + 4);
+
+			c->depth = v->min_lev;
+			fill_rectangle(c, 0, 0, c->height - 1, c->width - 1,
+				FEAT_GRANITE, SQUARE_NONE);
+			if (build_vault(c, loc(c->width / 2, c->height / 2), v))
+				built++;
+			wipe_mon_list(c, player);
+			cave_free(c);
+		}
+	}
+	dun = old_dun;
+	require(built > 0);
+	ok;
+}
+
+const char *suite_name = "bench/vaults";
+struct test tests[] = {
+	{ "selection", test_selection },
+	{ "stamps", test_stamps },
+	{ "build", test_build },
+	{ NULL, NULL }
+};
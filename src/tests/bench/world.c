@@ -0,0 +1,171 @@
+/* bench/world
+ *
+ * Benchmarks for the per-turn work done on a generated level.  Run with -b
+ * (or run-tests --bench) to time them; otherwise each body runs once.
+ */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "monster.h"
+#include "obj-make.h"
+#include "player.h"
+#include "player-birth.h"
+#include "project.h"
+#include "savefile.h"
+#include "z-file.h"
+#include "z-rand.h"
+
+#define BENCH_SEED 0x2a2a2a2a
+#define BENCH_DEPTH 15
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+#ifdef UNIX
+	/* Necessary for creating the randart file. */
+	create_needed_dirs();
+#endif
+	if (!player_make_simple(NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+
+	/* Always time the same level */
+	Rand_state_init(BENCH_SEED);
+	player->depth = BENCH_DEPTH;
+	prepare_next_level(player);
+	on_new_level();
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	file_delete("Bench1");
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	return 0;
+}
+
+/**
+ * Fill `grids` with up to `n` passable grids spread over the level, returning
+ * how many were found
+ */
+static int spread_grids(struct chunk *c, struct loc *grids, int n) {
+	int found = 0, step = MAX(1, (c->height * c->width) / (n * 7));
+	int i;
+
+	for (i = 0; found < n && i < c->height * c->width; i += step) {
+		struct loc grid = loc(i % c->width, i / c->width);
+
+		if (square_ispassable(c, grid)) grids[found++] = grid;
+	}
+	return found;
+}
+
+static int test_los(void *state) {
+	struct loc grids[64];
+	int n = spread_grids(cave, grids, 64);
+	int seen = 0;
+
+	require(n > 1);
+	bench("los", 50) {
+		int i, j;
+
+		for (i = 0; i < n; i++)
+			for (j = 0; j < n; j++)
+				if (los(cave, grids[i], grids[j])) seen++;
+	}
+	require(seen > 0);
+	ok;
+}
+
+static int test_project_path(void *state) {
+	struct loc grids[64], path[256];
+	int n = spread_grids(cave, grids, 64);
+	int steps = 0;
+
+	require(n > 1);
+	bench("project_path", 50) {
+		int i, j;
+
+		for (i = 0; i < n; i++)
+			for (j = 0; j < n; j++)
+				steps += project_path(cave, path, z_info->max_range,
+					grids[i], grids[j], PROJECT_NONE);
+	}
+	require(steps > 0);
+	ok;
+}
+
+static int test_update_view(void *state) {
+	bench("update_view", 50) {
+		update_view(cave, player);
+	}
+	require(square_isview(cave, player->grid));
+	ok;
+}
+
+static int test_make_noise(void *state) {
+	bench("make_noise", 200) {
+		make_noise(player);
+	}
+	eq(cave->noise.grids[player->grid.y][player->grid.x], 0);
+	ok;
+}
+
+static int test_monster_sweep(void *state) {
+	long awake = 0;
+
+	/* Touch the fields a turn's monster processing reads first */
+	bench("monster sweep", 100000) {
+		int i;
+
+		for (i = 1; i < cave_monster_max(cave); i++) {
+			const struct monster *mon = cave_monster(cave, i);
+
+			if (!mon->race) continue;
+			if (!mon->m_timed[MON_TMD_SLEEP] && mon->hp > 0
+					&& mon->cdis <= z_info->max_sight)
+				awake += mon->energy;
+		}
+	}
+	require(awake >= 0);
+	ok;
+}
+
+static int test_get_obj_num(void *state) {
+	int found = 0;
+
+	bench("get_obj_num", 100000) {
+		if (get_obj_num(BENCH_DEPTH, false, 0)) found++;
+	}
+	require(found > 0);
+	ok;
+}
+
+static int test_savefile_save(void *state) {
+	bool saved = true;
+
+	bench("savefile_save", 10) {
+		saved = savefile_save("Bench1") && saved;
+	}
+	require(saved);
+	require(file_exists("Bench1"));
+	ok;
+}
+
+const char *suite_name = "bench/world";
+struct test tests[] = {
+	{ "los", test_los },
+	{ "project_path", test_project_path },
+	{ "update_view", test_update_view },
+	{ "make_noise", test_make_noise },
+	{ "monster sweep", test_monster_sweep },
+	{ "get_obj_num", test_get_obj_num },
+	{ "savefile_save", test_savefile_save },
+	{ NULL, NULL }
+};
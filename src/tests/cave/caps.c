@@ -0,0 +1,127 @@
+/* cave/caps */
+/* Check that the per-grid FEAT_CAP_ bits follow the terrain. */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "player-birth.h"
+#include "z-rand.h"
+
+#define TEST_SEED 0x0ca95eed
+#define TEST_DEPTH 9
+
+int setup_tests(void **state) {
+	set_file_paths();
+	if (!init_angband()) {
+		return 1;
+	}
+#ifdef UNIX
+	create_needed_dirs();
+#endif
+	if (!player_make_simple(NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+
+	Rand_state_init(TEST_SEED);
+	player->depth = TEST_DEPTH;
+	prepare_next_level(player);
+	on_new_level();
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	return 0;
+}
+
+/**
+ * True if every grid of the chunk has the bits of its terrain
+ */
+static bool caps_match(struct chunk *c) {
+	struct loc grid;
+
+	for (grid.y = 0; grid.y < c->height; grid.y++) {
+		for (grid.x = 0; grid.x < c->width; grid.x++) {
+			if (c->caps[grid.y][grid.x]
+					!= f_info[square(c, grid)->feat].caps)
+				return false;
+		}
+	}
+	return true;
+}
+
+static int test_features(void *state) {
+	int feat;
+
+	for (feat = 0; feat < FEAT_MAX; feat++) {
+		uint8_t caps = f_info[feat].caps;
+
+		eq(caps, feat_caps(feat));
+		eq(!!(caps & FEAT_CAP_PASSABLE), feat_is_passable(feat));
+		eq(!!(caps & FEAT_CAP_PROJECT), feat_is_projectable(feat));
+		eq(!!(caps & FEAT_CAP_LOS), feat_is_los(feat));
+		eq(!!(caps & FEAT_CAP_NO_FLOW), feat_is_no_flow(feat));
+		eq(!!(caps & FEAT_CAP_NO_SCENT), feat_is_no_scent(feat));
+		eq(!!(caps & FEAT_CAP_BRIGHT), feat_is_bright(feat));
+		eq(!!(caps & FEAT_CAP_FIERY), feat_is_fiery(feat));
+	}
+	ok;
+}
+
+static int test_level(void *state) {
+	require(caps_match(cave));
+	require(caps_match(player->cave));
+	ok;
+}
+
+static int test_set_feat(void *state) {
+	struct loc grid = player->grid;
+	int old = square(cave, grid)->feat, feat;
+
+	for (feat = 1; feat < FEAT_MAX; feat++) {
+		square_set_feat(cave, grid, feat);
+		eq(square_ispassable(cave, grid), feat_is_passable(feat));
+		eq(square_isprojectable(cave, grid), feat_is_projectable(feat));
+		eq(square_allowslos(cave, grid), feat_is_los(feat));
+		eq(square_isnoflow(cave, grid), feat_is_no_flow(feat));
+		eq(square_isnoscent(cave, grid), feat_is_no_scent(feat));
+		eq(square_isfiery(cave, grid), feat_is_fiery(feat));
+	}
+	square_set_feat(cave, grid, old);
+	require(caps_match(cave));
+	require(caps_match(player->cave));
+	ok;
+}
+
+static int test_copies(void *state) {
+	struct chunk *copy = chunk_write(cave);
+	struct chunk *dest = cave_new(cave->height, cave->width);
+
+	require(caps_match(copy));
+	chunk_pack(copy);
+	chunk_unpack(copy);
+	require(caps_match(copy));
+
+	/* Turned over, as vaults and persistent levels may be */
+	require(chunk_copy(dest, player, copy, 0, 0, 2, false));
+	require(caps_match(dest));
+
+	cave_free(dest);
+	cave_free(copy);
+	ok;
+}
+
+const char *suite_name = "cave/caps";
+struct test tests[] = {
+	{ "features", test_features },
+	{ "level", test_level },
+	{ "set feat", test_set_feat },
+	{ "copies", test_copies },
+	{ NULL, NULL }
+};
@@ -0,0 +1,126 @@
+/* cave/pack */
+
+#include "unit-test.h"
+#include "unit-test-data.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "generate.h"
+#include "z-rand.h"
+#include "z-virt.h"
+
+struct pack_snapshot {
+	uint8_t feat;
+	bitflag info[SQUARE_SIZE];
+	int light;
+	int16_t mon;
+	uint16_t noise;
+	uint16_t scent;
+};
+
+int setup_tests(void **state) {
+	Rand_init();
+	z_info = &test_z_info;
+	*state = NULL;
+	return 0;
+}
+
+NOTEARDOWN
+
+static struct pack_snapshot *fill_chunk(struct chunk *c) {
+	struct pack_snapshot *snap =
+		mem_zalloc(c->height * c->width * sizeof(*snap));
+	struct loc grid;
+
+	for (grid.y = 0; grid.y < c->height; grid.y++) {
+		for (grid.x = 0; grid.x < c->width; grid.x++) {
+			struct square *sq = &c->squares[grid.y][grid.x];
+			struct pack_snapshot *s = &snap[grid.y * c->width + grid.x];
+
+			/* Mostly long runs, with the odd break */
+			sq->feat = (grid.x < c->width / 2) ? 1 : 2;
+			if (one_in_(7)) sq->feat = randint0(256);
+			sqinfo_wipe(sq->info);
+			if (one_in_(3)) sqinfo_on(sq->info, SQUARE_ROOM);
+			if (one_in_(5)) sqinfo_on(sq->info, SQUARE_GLOW);
+			sq->light = one_in_(4) ? randint0(5) - 2 : 1;
+			c->noise.grids[grid.y][grid.x] = one_in_(2) ? randint0(300) : 0;
+			c->scent.grids[grid.y][grid.x] = one_in_(9) ? randint0(70) : 0;
+
+			s->feat = sq->feat;
+			sqinfo_copy(s->info, sq->info);
+			s->light = sq->light;
+			s->noise = c->noise.grids[grid.y][grid.x];
+			s->scent = c->scent.grids[grid.y][grid.x];
+		}
+	}
+
+	/* A player marker, to check the grid list */
+	c->squares[c->height / 2][c->width / 3].mon = -1;
+	snap[(c->height / 2) * c->width + c->width / 3].mon = -1;
+
+	return snap;
+}
+
+static bool matches(struct chunk *c, const struct pack_snapshot *snap) {
+	struct loc grid;
+
+	for (grid.y = 0; grid.y < c->height; grid.y++) {
+		for (grid.x = 0; grid.x < c->width; grid.x++) {
+			const struct square *sq = &c->squares[grid.y][grid.x];
+			const struct pack_snapshot *s =
+				&snap[grid.y * c->width + grid.x];
+
+			if (sq->feat != s->feat
+					|| !sqinfo_is_equal(sq->info, s->info)
+					|| sq->light != s->light || sq->mon != s->mon
+					|| c->noise.grids[grid.y][grid.x] != s->noise
+					|| c->scent.grids[grid.y][grid.x] != s->scent) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static int test_pack_round_trip(void *state) {
+	/* Wider than a run can be, so runs have to be split */
+	struct chunk *c = cave_new(13, 600);
+	struct pack_snapshot *snap = fill_chunk(c);
+
+	require(!chunk_is_packed(c));
+	chunk_pack(c);
+	require(chunk_is_packed(c));
+	null(c->squares);
+	null(c->noise.grids);
+	null(c->scent.grids);
+
+	/* Packing twice is harmless */
+	chunk_pack(c);
+
+	chunk_unpack(c);
+	require(!chunk_is_packed(c));
+	notnull(c->squares);
+	require(matches(c, snap));
+
+	mem_free(snap);
+	cave_free(c);
+	ok;
+}
+
+static int test_pack_free(void *state) {
+	struct chunk *c = cave_new(5, 7);
+	struct pack_snapshot *snap = fill_chunk(c);
+
+	/* Freeing a packed chunk must not leak or crash */
+	chunk_pack(c);
+	cave_free(c);
+	mem_free(snap);
+	ok;
+}
+
+const char *suite_name = "cave/pack";
+struct test tests[] = {
+	{ "pack round trip", test_pack_round_trip },
+	{ "pack free", test_pack_free },
+	{ NULL, NULL }
+};
@@ -1,3 +1,5 @@
 TESTPROGS += \
+	cave/caps \
 	cave/find \
+	cave/pack \
 	cave/scatter
@@ -0,0 +1,274 @@
+/*
+ * effects/project
+ * Check the grids project() affects against a direct scan of the blast area,
+ * and the remembered projectability fields against projectable() and los().
+ */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "game-event.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "player-birth.h"
+#include "project.h"
+#include "source.h"
+#include "z-rand.h"
+
+#define TEST_SEED 0x5eed1e55
+#define TEST_DEPTH 12
+
+struct blast {
+	int num_grids;
+	struct loc grids[256];
+	int dist[256];
+};
+
+static struct blast seen;
+
+static void record_blast(game_event_type type, game_event_data *data,
+		void *user)
+{
+	int i;
+
+	seen.num_grids = data->explosion.num_grids;
+	for (i = 0; i < seen.num_grids; i++) {
+		seen.grids[i] = data->explosion.blast_grid[i];
+		seen.dist[i] = data->explosion.distance_to_grid[i];
+	}
+}
+
+int setup_tests(void **state) {
+	set_file_paths();
+	if (!init_angband()) {
+		return 1;
+	}
+#ifdef UNIX
+	create_needed_dirs();
+#endif
+	if (!player_make_simple(NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+
+	Rand_state_init(TEST_SEED);
+	player->depth = TEST_DEPTH;
+	prepare_next_level(player);
+	on_new_level();
+	event_add_handler(EVENT_EXPLOSION, record_blast, NULL);
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	event_remove_handler(EVENT_EXPLOSION, record_blast, NULL);
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	return 0;
+}
+
+static void add_grid(struct blast *b, struct loc grid, int dist) {
+	b->grids[b->num_grids] = grid;
+	b->dist[b->num_grids] = dist;
+	b->num_grids++;
+}
+
+/**
+ * The blast area of a non-beam projection worked out grid by grid, with
+ * los() for every candidate, as project() has always defined it
+ */
+static void reference_blast(struct blast *b, struct loc start,
+		struct loc finish, int rad, int flg, int degrees) {
+	struct loc path[512], centre = start;
+	int n_path = 0, i, j, k, n1y = 0, n1x = 0;
+	struct loc grid;
+
+	b->num_grids = 0;
+	if (loc_eq(start, finish)) {
+		add_grid(b, finish, 0);
+		centre = finish;
+	} else {
+		n_path = project_path(cave, path, z_info->max_range, start,
+			finish, flg);
+		if (!(flg & PROJECT_ARC)) {
+			for (i = 0; i < n_path; i++) {
+				if (!square_ispassable(cave, path[i])) break;
+				centre = path[i];
+				if (i == n_path - 1) add_grid(b, centre, 0);
+			}
+		}
+	}
+
+	if ((flg & PROJECT_ARC) && n_path) {
+		centre = start;
+		if (rad > 20) rad = 20;
+		i = (n_path < 21) ? n_path - 1 : 20;
+		n1y = path[i].y - centre.y + 20;
+		n1x = path[i].x - centre.x + 20;
+	}
+	if (!b->num_grids) add_grid(b, centre, 0);
+
+	for (grid.y = centre.y - rad; grid.y <= centre.y + rad; grid.y++) {
+		for (grid.x = centre.x - rad; grid.x <= centre.x + rad; grid.x++) {
+			bool on_path = false;
+			int d = distance(centre, grid);
+
+			if (loc_eq(grid, centre) || b->num_grids >= 255) continue;
+			if (!square_in_bounds(cave, grid) || d > rad) continue;
+			if ((flg & PROJECT_THRU) || square_ispassable(cave, grid)) {
+				if (!square_isprojectable(cave, grid)) {
+					bool can_see_one = false;
+
+					for (i = 0; i < 8; i++) {
+						if (los(cave, centre,
+								loc_sum(grid, ddgrid_ddd[i])))
+							can_see_one = true;
+					}
+					if (!can_see_one) continue;
+				}
+			} else if (!square_isprojectable(cave, grid)) {
+				continue;
+			}
+			for (i = 0; i < n_path; i++) {
+				if (loc_eq(grid, path[i])) on_path = true;
+			}
+			if (flg & PROJECT_ARC) {
+				int rotate = 90 - get_angle_to_grid[n1y][n1x];
+				int tmp = ABS(get_angle_to_grid[grid.y - start.y + 20]
+					[grid.x - start.x + 20] + rotate) % 180;
+
+				if (ABS(90 - tmp) >= (degrees + 6) / 4 && !on_path)
+					continue;
+			}
+			if (los(cave, centre, grid) || on_path) add_grid(b, grid, d);
+		}
+	}
+
+	/* The same grouping by distance as project() */
+	for (i = 0, k = 0; i <= rad; i++) {
+		for (j = k; j < b->num_grids; j++) {
+			if (b->dist[j] == i) {
+				struct loc tmp = b->grids[k];
+				int tmp_d = b->dist[k];
+
+				b->grids[k] = b->grids[j];
+				b->dist[k] = b->dist[j];
+				b->grids[j] = tmp;
+				b->dist[j] = tmp_d;
+				k++;
+			}
+		}
+	}
+}
+
+static bool same_blast(const struct blast *a, const struct blast *b) {
+	int i;
+
+	if (a->num_grids != b->num_grids) return false;
+	for (i = 0; i < a->num_grids; i++) {
+		if (!loc_eq(a->grids[i], b->grids[i]) || a->dist[i] != b->dist[i])
+			return false;
+	}
+	return true;
+}
+
+static int test_balls(void *state) {
+	struct blast expect;
+	int tried = 0, rad;
+
+	for (rad = 1; rad <= 10; rad += 3) {
+		int n;
+
+		for (n = 0; n < 60; n++) {
+			struct loc grid = loc(randint0(cave->width),
+				randint0(cave->height));
+			int flg = PROJECT_JUMP | PROJECT_HIDE
+				| (one_in_(3) ? PROJECT_THRU : 0);
+
+			if (!square_in_bounds_fully(cave, grid)) continue;
+			reference_blast(&expect, grid, grid, rad,
+				flg & ~PROJECT_JUMP, 0);
+			seen.num_grids = -1;
+			project(source_none(), rad, grid, 0, PROJ_LIGHT_WEAK, flg,
+				0, 0, NULL);
+			require(same_blast(&seen, &expect));
+			tried++;
+		}
+	}
+	require(tried > 100);
+	ok;
+}
+
+static int test_thrown_balls_and_arcs(void *state) {
+	struct blast expect;
+	struct loc home = player->grid;
+	int tried = 0, n;
+
+	for (n = 0; n < 20000 && tried < 300; n++) {
+		struct loc from = loc(randint0(cave->width),
+			randint0(cave->height));
+		struct loc to = loc_sum(from, loc(randint0(31) - 15,
+			randint0(31) - 15));
+		bool arc = one_in_(2);
+		int rad = arc ? randint1(20) : randint1(6);
+		int degrees = arc ? randint1(9) * 10 : 0;
+		int flg = PROJECT_HIDE | (arc ? PROJECT_ARC : 0);
+
+		if (!square_ispassable(cave, from) || loc_eq(from, to)) continue;
+		if (!square_in_bounds_fully(cave, to)) continue;
+
+		/* Fire from wherever the player is standing */
+		player->grid = from;
+		reference_blast(&expect, from, to, rad, flg, degrees);
+		seen.num_grids = -1;
+		project(source_player(), rad, to, 0, PROJ_LIGHT_WEAK, flg,
+			degrees, 20, NULL);
+		player->grid = home;
+		require(same_blast(&seen, &expect));
+		tried++;
+	}
+	eq(tried, 300);
+	ok;
+}
+
+static int test_fields(void *state) {
+	struct loc home = player->grid, centre = home;
+	int n, checked = 0;
+
+	for (n = 0; n < 4000; n++) {
+		struct loc grid = loc_sum(centre, loc(randint0(41) - 20,
+			randint0(41) - 20));
+
+		/* Now and then the player moves or the terrain changes */
+		if (one_in_(500)) {
+			centre = loc(randint0(cave->width), randint0(cave->height));
+			if (!square_in_bounds_fully(cave, centre)) centre = home;
+		}
+		if (one_in_(300) && square_in_bounds_fully(cave, grid)
+				&& !square_isperm(cave, grid)
+				&& !square(cave, grid)->mon) {
+			square_set_feat(cave, grid,
+				square_isprojectable(cave, grid) ?
+				FEAT_GRANITE : FEAT_FLOOR);
+		}
+		if (!square_in_bounds(cave, grid)) continue;
+
+		eq(field_projectable(cave, grid, centre, PROJECT_NONE),
+			projectable(cave, grid, centre, PROJECT_NONE));
+		eq(field_projectable(cave, grid, centre, PROJECT_SHORT),
+			projectable(cave, grid, centre, PROJECT_SHORT));
+		eq(field_los(cave, grid, centre), los(cave, grid, centre));
+		checked++;
+	}
+	require(checked > 1000);
+	ok;
+}
+
+const char *suite_name = "effects/project";
+struct test tests[] = {
+	{ "balls", test_balls },
+	{ "thrown balls and arcs", test_thrown_balls_and_arcs },
+	{ "fields", test_fields },
+	{ NULL, NULL }
+};
@@ -178,6 +178,29 @@ static int test_stairs2(void *state) {
 	ok;
 }
 
+static int map_redraws;
+
+static void count_map(game_event_type type, game_event_data *data, void *user) {
+	map_redraws++;
+}
+
+static int test_redraw(void *state) {
+	event_add_handler(EVENT_MAP, count_map, NULL);
+
+	/* Let the monsters and the world have some turns */
+	cmdq_push(CMD_HOLD);
+	run_game_loop();
+
+	/* A redraw the UI raises before drawing over the map is drawn now,
+	 * not held back until the next key and drawn on top */
+	map_redraws = 0;
+	event_signal_point(EVENT_MAP, player->grid.x, player->grid.y);
+	eq(map_redraws, 1);
+
+	event_remove_handler(EVENT_MAP, count_map, NULL);
+	ok;
+}
+
 static int test_drop_pickup(void *state) {
 	int dir;
 
@@ -250,13 +273,65 @@ static int test_drop_eat(void *state) {
 	ok;
 }
 
+static int test_persist(void *state) {
+	struct chunk *town;
+
+	reset_before_load();
+
+	/* Load the saved game and switch on persistent levels */
+	eq(savefile_load("Test1", false), true);
+	OPT(player, birth_levels_persist) = true;
+	require(character_dungeon);
+	on_new_level();
+
+	/* Leaving the town stores it, compressed */
+	cmdq_push(CMD_GO_DOWN);
+	run_game_loop();
+	eq(player->depth, 1);
+	town = chunk_find_name("Town");
+	notnull(town);
+	require(chunk_is_packed(town));
+	null(town->save_image);
+
+	/* The first save keeps the stored record, the second reuses it */
+	eq(savefile_save("Test2"), true);
+	notnull(town->save_image);
+	eq(savefile_save("Test2"), true);
+	require(chunk_is_packed(town));
+
+	/* Load it back; the stored town comes back as it was */
+	reset_before_load();
+	eq(savefile_load("Test2", false), true);
+	require(OPT(player, birth_levels_persist));
+	eq(player->depth, 1);
+	town = chunk_find_name("Town");
+	notnull(town);
+	notnull(chunk_find_name("Town known"));
+
+	/* Returning to the town unpacks it */
+	on_new_level();
+	chunk_list_pack(cave, player->cave);
+	require(chunk_is_packed(town));
+	cmdq_push(CMD_GO_UP);
+	run_game_loop();
+	eq(player->depth, 0);
+	require(!chunk_is_packed(cave));
+	null(chunk_find_name("Town"));
+	require(square_in_bounds_fully(cave, player->grid));
+
+	file_delete("Test2");
+	ok;
+}
+
 const char *suite_name = "game/basic";
 struct test tests[] = {
 	{ "newgame", test_newgame },
 	{ "loadgame", test_loadgame },
 	{ "stairs1", test_stairs1 },
 	{ "stairs2", test_stairs2 },
+	{ "redraw", test_redraw },
 	{ "droppickup", test_drop_pickup },
 	{ "dropeat", test_drop_eat },
+	{ "persist", test_persist },
 	{ NULL, NULL }
 };
@@ -0,0 +1,181 @@
+/* game/event.c */
+
+#include "unit-test.h"
+#include "game-event.h"
+
+struct seen_event {
+	game_event_type type;
+	int tag;
+	struct loc point;
+};
+
+static struct seen_event seen[32];
+static int n_seen;
+
+static void record(game_event_type type, game_event_data *data, void *user) {
+	if (n_seen == (int) N_ELEMENTS(seen)) return;
+	seen[n_seen].type = type;
+	seen[n_seen].tag = user ? *(int *) user : 0;
+	seen[n_seen].point = data ? data->point : loc(-2, -2);
+	n_seen++;
+}
+
+static void signal_hp(game_event_type type, game_event_data *data, void *user) {
+	record(type, data, user);
+	event_signal(EVENT_HP);
+}
+
+int setup_tests(void **state) {
+	*state = NULL;
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	event_remove_all_handlers();
+	return 0;
+}
+
+static int test_order(void *state) {
+	int first = 1, second = 2;
+
+	n_seen = 0;
+	event_add_handler(EVENT_GOLD, record, &first);
+	event_add_handler(EVENT_GOLD, record, &second);
+	event_signal(EVENT_GOLD);
+
+	/* Most recently registered goes first */
+	eq(n_seen, 2);
+	eq(seen[0].tag, 2);
+	eq(seen[1].tag, 1);
+
+	event_remove_handler(EVENT_GOLD, record, &second);
+	event_signal(EVENT_GOLD);
+	eq(n_seen, 3);
+	eq(seen[2].tag, 1);
+
+	event_remove_handler_type(EVENT_GOLD);
+	event_signal(EVENT_GOLD);
+	eq(n_seen, 3);
+	ok;
+}
+
+static int test_deferred(void *state) {
+	uint32_t hp = event_coalesced_count(EVENT_HP);
+	uint32_t map = event_coalesced_count(EVENT_MAP);
+
+	n_seen = 0;
+	event_add_handler(EVENT_HP, record, NULL);
+	event_add_handler(EVENT_MAP, record, NULL);
+	event_add_handler(EVENT_MESSAGE, record, NULL);
+	event_add_handler(EVENT_REFRESH, record, NULL);
+	event_set_deferred(true);
+
+	event_signal(EVENT_HP);
+	event_signal(EVENT_HP);
+	event_signal_point(EVENT_MAP, 1, 2);
+	event_signal_point(EVENT_MAP, 1, 2);
+	event_signal_point(EVENT_MAP, 3, 4);
+	event_signal(EVENT_HP);
+	eq(n_seen, 0);
+	eq(event_coalesced_count(EVENT_HP) - hp, 2);
+	eq(event_coalesced_count(EVENT_MAP) - map, 1);
+
+	/* Events which are not redraws are not held back */
+	event_signal_message(EVENT_MESSAGE, 0, "hello");
+	eq(n_seen, 1);
+	eq(seen[0].type, EVENT_MESSAGE);
+
+	/* The refresh delivers the rest, each where it was last signalled */
+	event_signal(EVENT_REFRESH);
+	eq(n_seen, 5);
+	eq(seen[1].type, EVENT_MAP);
+	require(loc_eq(seen[1].point, loc(1, 2)));
+	eq(seen[2].type, EVENT_MAP);
+	require(loc_eq(seen[2].point, loc(3, 4)));
+	eq(seen[3].type, EVENT_HP);
+	require(loc_eq(seen[3].point, loc(-2, -2)));
+	eq(seen[4].type, EVENT_REFRESH);
+
+	/* Nothing is left over */
+	event_signal(EVENT_REFRESH);
+	eq(n_seen, 6);
+
+	/* Leaving deferred mode delivers anything still queued */
+	event_signal(EVENT_HP);
+	eq(n_seen, 6);
+	event_set_deferred(false);
+	eq(n_seen, 7);
+	eq(seen[6].type, EVENT_HP);
+	event_signal(EVENT_HP);
+	eq(n_seen, 8);
+
+	event_remove_all_handlers();
+	ok;
+}
+
+static int test_nested(void *state) {
+	int i;
+
+	n_seen = 0;
+	event_add_handler(EVENT_HP, record, NULL);
+	event_add_handler(EVENT_REFRESH, signal_hp, NULL);
+	event_set_deferred(true);
+
+	/* Handlers signalling as they run are not deferred */
+	event_signal(EVENT_REFRESH);
+	eq(n_seen, 2);
+	eq(seen[0].type, EVENT_REFRESH);
+	eq(seen[1].type, EVENT_HP);
+
+	/* Enough distinct grids to grow the queue */
+	for (i = 0; i < 100; i++)
+		event_signal_point(EVENT_MAP, i, i);
+	event_add_handler(EVENT_MAP, record, NULL);
+	for (i = 0; i < 100; i++)
+		event_signal_point(EVENT_MAP, i % 10, i % 10);
+	eq(n_seen, 2);
+	event_flush_deferred();
+	eq(n_seen, 12);
+	require(loc_eq(seen[11].point, loc(9, 9)));
+
+	event_remove_all_handlers();
+	ok;
+}
+
+static int test_overlay(void *state) {
+	int overlay = 3;
+
+	n_seen = 0;
+	event_add_handler(EVENT_MAP, record, NULL);
+
+	/* Monsters moving: their redraws are held back until they are done */
+	event_set_deferred(true);
+	event_signal_point(EVENT_MAP, 1, 2);
+	eq(n_seen, 0);
+	event_set_deferred(false);
+	eq(n_seen, 1);
+
+	/* The UI updates the display and then draws over it, as targeting
+	 * does; the redraw goes to the map before the overlay is drawn */
+	event_signal_point(EVENT_MAP, 3, 4);
+	record(EVENT_END, NULL, &overlay);
+	eq(n_seen, 3);
+	eq(seen[1].type, EVENT_MAP);
+	eq(seen[2].tag, overlay);
+
+	/* Waiting for a key then has nothing left to draw over it */
+	event_flush_deferred();
+	eq(n_seen, 3);
+
+	event_remove_all_handlers();
+	ok;
+}
+
+const char *suite_name = "game/event";
+struct test tests[] = {
+	{ "order", test_order },
+	{ "deferred", test_deferred },
+	{ "nested", test_nested },
+	{ "overlay", test_overlay },
+	{ NULL, NULL }
+};
@@ -0,0 +1,113 @@
+/* monster/list */
+
+#include "mon-list.h"
+#include "mon-make.h"
+#include "mon-util.h"
+#include "player-birth.h"
+#include "test-utils.h"
+#include "unit-test.h"
+#include "unit-test-data.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+	*state = 0;
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	mem_free(state);
+	cleanup_angband();
+	return 0;
+}
+
+static struct monster *add_visible(struct chunk *c, struct loc g,
+		const char *race) {
+	struct monster *mon = t_add_monster(c, g, race);
+
+	mflag_on(mon->mflag, MFLAG_VISIBLE);
+	return mon;
+}
+
+static void refresh(monster_list_t *list) {
+	monster_list_reset(list);
+	monster_list_collect(list);
+	monster_list_sort(list, monster_list_standard_compare);
+}
+
+static int test_collect_and_order(void *state) {
+	struct chunk *c = t_build_arena(20, 20);
+	monster_list_t *list;
+	struct monster *wolf0, *panther;
+
+	player_make_simple(NULL, NULL, "Tester");
+	player->grid = loc(10, 10);
+	cave = c;
+
+	/* Wolves and panthers are equally deep; wolves arrive first. */
+	wolf0 = add_visible(c, loc(5, 5), "wolf");
+	add_visible(c, loc(4, 5), "wolf");
+	panther = add_visible(c, loc(12, 12), "panther");
+	add_visible(c, loc(6, 6), "wolf");
+
+	list = monster_list_new();
+	refresh(list);
+	eq(list->distinct_entries, 2);
+	eq(list->total_monsters[MONSTER_LIST_SECTION_LOS], 4);
+	ptreq(list->entries[0].race, wolf0->race);
+	eq(list->entries[0].count[MONSTER_LIST_SECTION_LOS], 3);
+	ptreq(list->entries[1].race, panther->race);
+	eq(list->entries[1].dx[MONSTER_LIST_SECTION_LOS], 2);
+
+	/* Nothing has changed, so there is nothing to redraw */
+	require(monster_list_changed(list, c, 10, 40));
+	refresh(list);
+	require(!monster_list_changed(list, c, 10, 40));
+	require(monster_list_changed(list, c, 11, 40));
+
+	/* A lone monster moving changes its row */
+	panther->grid = loc(13, 12);
+	refresh(list);
+	require(monster_list_changed(list, c, 11, 40));
+
+	/* Wolves drop out of view and come back; they now queue behind the
+	 * panther even though they are earlier in the monster list. */
+	mflag_off(wolf0->mflag, MFLAG_VISIBLE);
+	refresh(list);
+	eq(list->distinct_entries, 2);
+	ptreq(list->entries[0].race, wolf0->race);
+	eq(list->entries[0].count[MONSTER_LIST_SECTION_LOS], 2);
+	for (int i = 1; i < cave_monster_max(c); i++) {
+		struct monster *mon = cave_monster(c, i);
+
+		if (mon->race == wolf0->race)
+			mflag_off(mon->mflag, MFLAG_VISIBLE);
+	}
+	refresh(list);
+	eq(list->distinct_entries, 1);
+	ptreq(list->entries[0].race, panther->race);
+	mflag_on(wolf0->mflag, MFLAG_VISIBLE);
+	refresh(list);
+	eq(list->distinct_entries, 2);
+	ptreq(list->entries[0].race, panther->race);
+	ptreq(list->entries[1].race, wolf0->race);
+
+	/* Something deeper still goes to the top */
+	add_visible(c, loc(3, 3), "warg");
+	refresh(list);
+	eq(list->distinct_entries, 3);
+	ptreq(list->entries[0].race, lookup_monster("warg"));
+	ptreq(list->entries[1].race, panther->race);
+
+	monster_list_free(list);
+	cave = NULL;
+	wipe_mon_list(c, player);
+	cave_free(c);
+	ok;
+}
+
+const char *suite_name = "monster/list";
+struct test tests[] = {
+	{ "collect and order", test_collect_and_order },
+	{ NULL, NULL }
+};
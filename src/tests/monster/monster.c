@@ -128,9 +128,18 @@ static int test_nearby_kin(void *state) {
 	ok;
 }
 
+/* The per-turn sweeps over cave->monsters want this to stay small */
+static int test_monster_size(void *state) {
+	require(sizeof(struct monster) <= 256);
+	require(sizeof(struct monster_known_pstate)
+		< sizeof(struct player_state));
+	ok;
+}
+
 const char *suite_name = "monster/monster";
 struct test tests[] = {
 	{ "match_monster_bases", test_match_monster_bases },
 	{ "nearby_kin", test_nearby_kin },
+	{ "monster_size", test_monster_size },
 	{ NULL, NULL }
 };
@@ -0,0 +1,165 @@
+/* monster/recall */
+/* Check that remembered monster recalls follow changes to the lore and to
+ * the player. */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "init.h"
+#include "mon-lore.h"
+#include "mon-util.h"
+#include "player-birth.h"
+#include "player-timed.h"
+#include "ui-mon-lore.h"
+#include "ui-prefs.h"
+#include "z-textblock.h"
+#include "z-virt.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+	if (!player_make_simple(NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+	textui_prefs_init();
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	lore_description_cache_free();
+	textui_prefs_free();
+	cleanup_angband();
+	return 0;
+}
+
+/**
+ * True if two textblocks hold the same text in the same colours, as they
+ * would be laid out on screen
+ */
+static bool same_text(textblock *a, textblock *b) {
+	size_t *a_starts = NULL, *a_lengths = NULL;
+	size_t *b_starts = NULL, *b_lengths = NULL;
+	size_t a_lines = textblock_calculate_lines(a, &a_starts, &a_lengths, 80);
+	size_t b_lines = textblock_calculate_lines(b, &b_starts, &b_lengths, 80);
+	bool same = a_lines == b_lines;
+
+	if (same && a_lines) {
+		size_t len = a_starts[a_lines - 1] + a_lengths[a_lines - 1];
+
+		same = !memcmp(a_starts, b_starts, a_lines * sizeof(*a_starts))
+			&& !memcmp(a_lengths, b_lengths,
+			a_lines * sizeof(*a_lengths))
+			&& !memcmp(textblock_text(a), textblock_text(b),
+			len * sizeof(wchar_t))
+			&& !memcmp(textblock_attrs(a), textblock_attrs(b), len);
+	}
+	mem_free(a_starts);
+	mem_free(a_lengths);
+	mem_free(b_starts);
+	mem_free(b_lengths);
+	return same;
+}
+
+/**
+ * Recall the race as it is now, once as remembered (if at all) and once
+ * from scratch, and check both ways agree
+ */
+static bool recall_is_current(const struct monster_race *race) {
+	textblock *cached = textblock_new(), *fresh = textblock_new();
+	bool same;
+
+	lore_description(cached, race, get_lore(race), false);
+	lore_description_cache_free();
+	lore_description(fresh, race, get_lore(race), false);
+	same = same_text(cached, fresh);
+	textblock_free(cached);
+	textblock_free(fresh);
+	return same;
+}
+
+static int test_hits(void *state) {
+	struct monster_race *race = lookup_monster("cutpurse");
+	uint32_t hits, misses, old_hits, old_misses;
+	textblock *tb = textblock_new();
+
+	notnull(race);
+	lore_description(tb, race, get_lore(race), false);
+	lore_description_cache_counts(&old_hits, &old_misses);
+	lore_description(tb, race, get_lore(race), false);
+	lore_description_cache_counts(&hits, &misses);
+	eq(hits, old_hits + 1);
+	eq(misses, old_misses);
+
+	/* Spoilers are never remembered */
+	lore_description(tb, race, get_lore(race), true);
+	lore_description_cache_counts(&hits, &misses);
+	eq(hits, old_hits + 1);
+	eq(misses, old_misses);
+
+	textblock_free(tb);
+	ok;
+}
+
+static int test_lore_changes(void *state) {
+	struct monster_race *race = lookup_monster("Grip, Farmer Maggot's Dog");
+	struct monster_lore *lore;
+
+	notnull(race);
+	lore = get_lore(race);
+	require(recall_is_current(race));
+
+	/* Sightings, kills and blows, learned the usual ways and not */
+	lore->sights = 5;
+	require(recall_is_current(race));
+	lore->tkills = 1;
+	lore->pkills = 1;
+	require(recall_is_current(race));
+	lore_update(race, lore);
+	require(recall_is_current(race));
+	lore->blows[0].times_seen = 3;
+	require(recall_is_current(race));
+	lore_update(race, lore);
+	require(recall_is_current(race));
+	lore->wake = 20;
+	lore_update(race, lore);
+	require(recall_is_current(race));
+	cheat_monster_lore(race, lore);
+	require(recall_is_current(race));
+
+	wipe_monster_lore(race, lore);
+	require(recall_is_current(race));
+	ok;
+}
+
+static int test_player_changes(void *state) {
+	struct monster_race *race = lookup_monster("cutpurse");
+	struct monster_lore *lore;
+
+	notnull(race);
+	lore = get_lore(race);
+	cheat_monster_lore(race, lore);
+	require(recall_is_current(race));
+
+	/* Experience, speed, armour and what the player resists */
+	player->lev = 7;
+	require(recall_is_current(race));
+	player->state.speed += 10;
+	require(recall_is_current(race));
+	player->state.ac += 30;
+	require(recall_is_current(race));
+	player->known_state.stat_ind[STAT_DEX] = 37;
+	require(recall_is_current(race));
+	player->timed[TMD_FAST] = 10;
+	require(recall_is_current(race));
+
+	wipe_monster_lore(race, lore);
+	ok;
+}
+
+const char *suite_name = "monster/recall";
+struct test tests[] = {
+	{ "hits", test_hits },
+	{ "lore changes", test_lore_changes },
+	{ "player changes", test_player_changes },
+	{ NULL, NULL }
+};
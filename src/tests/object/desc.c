@@ -0,0 +1,151 @@
+/* object/desc */
+/* Check that remembered object descriptions follow changes to the object
+ * and to what the player knows. */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "init.h"
+#include "player.h"
+#include "obj-desc.h"
+#include "obj-knowledge.h"
+#include "obj-make.h"
+#include "obj-pile.h"
+#include "obj-tval.h"
+#include "obj-util.h"
+#include "player-birth.h"
+#include "z-quark.h"
+#include "z-virt.h"
+
+static struct object *setup_object(int tval, const char *name) {
+	struct object *obj = object_new();
+
+	object_prep(obj, lookup_kind(tval, lookup_sval(tval, name)), 0,
+		MINIMISE);
+	obj->known = object_new();
+	object_set_base_known(player, obj);
+	return obj;
+}
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+	if (!player_make_simple(NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cleanup_angband();
+	return 0;
+}
+
+/**
+ * Describe the object as it is now, once as remembered (if at all) and once
+ * from scratch, and check both ways agree
+ */
+static bool desc_is_current(const struct object *obj, uint32_t mode) {
+	char cached[80], fresh[80];
+	size_t cached_end, fresh_end;
+
+	cached_end = object_desc(cached, sizeof(cached), obj, mode, player);
+	object_desc_forget();
+	fresh_end = object_desc(fresh, sizeof(fresh), obj, mode, player);
+	return cached_end == fresh_end && streq(cached, fresh);
+}
+
+static bool descs_are_current(const struct object *obj) {
+	return desc_is_current(obj, ODESC_PREFIX | ODESC_FULL)
+		&& desc_is_current(obj, ODESC_PREFIX | ODESC_BASE)
+		&& desc_is_current(obj, ODESC_FULL | ODESC_STORE)
+		&& desc_is_current(obj, ODESC_PREFIX | ODESC_FULL | ODESC_TERSE);
+}
+
+static int test_hits(void *state) {
+	struct object *obj = setup_object(TV_SWORD, "Dagger");
+	uint32_t hits, misses, old_hits, old_misses;
+	char buf[80];
+
+	object_desc(buf, sizeof(buf), obj, ODESC_PREFIX | ODESC_FULL, player);
+	object_desc_cache_counts(&old_hits, &old_misses);
+	object_desc(buf, sizeof(buf), obj, ODESC_PREFIX | ODESC_FULL, player);
+	object_desc_cache_counts(&hits, &misses);
+	eq(hits, old_hits + 1);
+	eq(misses, old_misses);
+
+	/* Another mode or buffer size is a separate description */
+	object_desc(buf, 40, obj, ODESC_PREFIX | ODESC_FULL, player);
+	object_desc_cache_counts(&hits, &misses);
+	eq(misses, old_misses + 1);
+
+	object_free(obj->known);
+	object_free(obj);
+	ok;
+}
+
+static int test_object_changes(void *state) {
+	struct object *obj = setup_object(TV_SWORD, "Dagger");
+
+	require(descs_are_current(obj));
+
+	/* Number, inscription, and bonuses known and unknown */
+	obj->number = 3;
+	obj->known->number = 3;
+	require(descs_are_current(obj));
+	obj->note = quark_add("@w1");
+	require(descs_are_current(obj));
+	obj->to_h = 4;
+	obj->to_d = 5;
+	require(descs_are_current(obj));
+	obj->known->notice |= OBJ_NOTICE_ASSESSED;
+	require(descs_are_current(obj));
+	obj->known->to_h = 4;
+	obj->known->to_d = 5;
+	require(descs_are_current(obj));
+	obj->known->modifiers[OBJ_MOD_STEALTH] = 2;
+	require(descs_are_current(obj));
+
+	object_free(obj->known);
+	object_free(obj);
+	ok;
+}
+
+static int test_knowledge_changes(void *state) {
+	struct object *obj = setup_object(TV_POTION, "Cure Light Wounds");
+	struct object *known;
+	char before[80], after[80];
+
+	require(descs_are_current(obj));
+	object_desc(before, sizeof(before), obj, ODESC_PREFIX | ODESC_FULL,
+		player);
+
+	/* Trying and then learning the flavour changes the name */
+	object_flavor_tried(obj);
+	require(descs_are_current(obj));
+	object_flavor_aware(player, obj);
+	require(descs_are_current(obj));
+	object_desc(after, sizeof(after), obj, ODESC_PREFIX | ODESC_FULL,
+		player);
+	require(!streq(before, after));
+
+	/* A reused object gets its own description */
+	known = obj->known;
+	object_prep(obj, lookup_kind(TV_SWORD,
+		lookup_sval(TV_SWORD, "Dagger")), 0, MINIMISE);
+	obj->known = known;
+	object_set_base_known(player, obj);
+	require(descs_are_current(obj));
+
+	object_free(obj->known);
+	object_free(obj);
+	ok;
+}
+
+const char *suite_name = "object/desc";
+struct test tests[] = {
+	{ "hits", test_hits },
+	{ "object changes", test_object_changes },
+	{ "knowledge changes", test_knowledge_changes },
+	{ NULL, NULL }
+};
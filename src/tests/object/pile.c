@@ -91,8 +91,44 @@ static int test_obj_piles(void *state) {
 	ok;
 }
 
+/* Freed objects and their arrays are reused, and come back clean */
+static int test_obj_reuse(void *state) {
+	struct object *o1 = object_new();
+	struct object *o2 = object_new();
+	struct object *o3;
+	struct angband_constants constants = test_z_info;
+
+	constants.brand_max = 12;
+	z_info = &constants;
+	o1->number = 3;
+	o1->brands = mem_zalloc(z_info->brand_max * sizeof(bool));
+	o1->brands[1] = true;
+	object_copy(o2, o1);
+	notnull(o2->brands);
+	require(o2->brands != o1->brands);
+	eq(o2->brands[1], true);
+	eq(o2->number, 3);
+
+	object_free(o1);
+	object_wipe(o2);
+	null(o2->brands);
+	eq(o2->number, 0);
+	object_free(o2);
+
+	o3 = object_new();
+	eq(o3->number, 0);
+	null(o3->brands);
+	null(o3->next);
+	object_free(o3);
+
+	object_cache_free();
+	z_info = NULL;
+	ok;
+}
+
 const char *suite_name = "object/pile";
 struct test tests[] = {
 	{ "pile checking", test_obj_piles },
+	{ "object reuse", test_obj_reuse },
 	{ NULL, NULL }
 };
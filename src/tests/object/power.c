@@ -0,0 +1,120 @@
+/* object/power */
+/* Check that cached object power follows changes to the object. */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "init.h"
+#include "obj-make.h"
+#include "obj-pile.h"
+#include "obj-power.h"
+#include "obj-tval.h"
+#include "obj-util.h"
+#include "player-birth.h"
+#include "z-virt.h"
+
+int setup_tests(void **state) {
+	struct object *obj;
+
+	set_file_paths();
+	init_angband();
+	if (!player_make_simple(NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+
+	obj = object_new();
+	object_prep(obj, lookup_kind(TV_SWORD,
+		lookup_sval(TV_SWORD, "Long Sword")), 0, AVERAGE);
+	*state = obj;
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	object_free(state);
+	cleanup_angband();
+	return 0;
+}
+
+/**
+ * Verbose evaluation never uses the cache, so compare against that
+ */
+static bool power_is_current(struct object *obj) {
+	int32_t cached = object_power(obj, false, NULL);
+
+	return cached == object_power(obj, true, NULL)
+		&& cached == object_power(obj, false, NULL);
+}
+
+static int test_cache_follows_changes(void *state) {
+	struct object *obj = state;
+	int32_t base = object_power(obj, false, NULL);
+	int value = object_value_real(obj, 1);
+
+	require(obj->power_key != 0);
+	eq(object_power(obj, false, NULL), base);
+
+	/* Enchantment */
+	obj->to_h += 10;
+	obj->to_d += 10;
+	require(power_is_current(obj));
+	require(object_power(obj, false, NULL) > base);
+	require(object_value_real(obj, 1) > value);
+
+	/* Modifiers, flags and elements */
+	obj->modifiers[OBJ_MOD_STR] = 3;
+	require(power_is_current(obj));
+	of_on(obj->flags, OF_FREE_ACT);
+	require(power_is_current(obj));
+	obj->el_info[ELEM_FIRE].res_level = 1;
+	require(power_is_current(obj));
+
+	/* Slays and brands */
+	obj->slays = mem_zalloc(z_info->slay_max * sizeof(bool));
+	require(power_is_current(obj));
+	obj->slays[1] = true;
+	require(power_is_current(obj));
+	obj->brands = mem_zalloc(z_info->brand_max * sizeof(bool));
+	obj->brands[1] = true;
+	require(power_is_current(obj));
+
+	/* Curses, including a change of strength */
+	obj->curses = mem_zalloc(z_info->curse_max * sizeof(*obj->curses));
+	obj->curses[1].power = 40;
+	require(power_is_current(obj));
+	obj->curses[1].power = 90;
+	require(power_is_current(obj));
+
+	/* Copies carry a valid cache */
+	{
+		struct object *copy = object_new();
+
+		object_copy(copy, obj);
+		eq(copy->power_key, obj->power_key);
+		eq(object_power(copy, false, NULL), obj->power);
+		copy->to_a = 5;
+		require(power_is_current(copy));
+		object_free(copy);
+	}
+
+	/* Back to the plain sword */
+	mem_free(obj->curses);
+	obj->curses = NULL;
+	mem_free(obj->brands);
+	obj->brands = NULL;
+	mem_free(obj->slays);
+	obj->slays = NULL;
+	obj->el_info[ELEM_FIRE].res_level = 0;
+	of_off(obj->flags, OF_FREE_ACT);
+	obj->modifiers[OBJ_MOD_STR] = 0;
+	obj->to_h -= 10;
+	obj->to_d -= 10;
+	eq(object_power(obj, false, NULL), base);
+	eq(object_value_real(obj, 1), value);
+	ok;
+}
+
+const char *suite_name = "object/power";
+struct test tests[] = {
+	{ "cache follows changes", test_cache_follows_changes },
+	{ NULL, NULL }
+};
@@ -1,7 +1,9 @@
 TESTPROGS += \
 	object/alloc \
 	object/attack \
+	object/desc \
 	object/info \
 	object/pile \
+	object/power \
 	object/slays \
 	object/util
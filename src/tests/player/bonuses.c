@@ -0,0 +1,171 @@
+/* player/bonuses.c */
+/* Check that calc_bonuses() with cached slot contributions matches working
+ * everything out afresh. */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "init.h"
+#include "obj-gear.h"
+#include "obj-knowledge.h"
+#include "obj-make.h"
+#include "obj-pile.h"
+#include "obj-tval.h"
+#include "obj-util.h"
+#include "player.h"
+#include "player-birth.h"
+#include "player-calcs.h"
+#include "z-virt.h"
+
+static struct object *setup_object(int tval, const char *name) {
+	struct object *obj = object_new();
+
+	object_prep(obj, lookup_kind(tval, lookup_sval(tval, name)), 0,
+		MINIMISE);
+	obj->known = object_new();
+	object_set_base_known(player, obj);
+	object_touch(player, obj);
+	return obj;
+}
+
+static void wield(struct object *obj) {
+	int slot = wield_slot(obj);
+
+	player->body.slots[slot].obj = obj;
+	player->upkeep->equip_cnt++;
+	object_learn_on_wield(player, obj);
+	pile_insert_end(&player->gear, obj);
+	pile_insert_end(&player->gear_k, obj->known);
+}
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+	if (!player_make_simple(NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+
+	wield(setup_object(TV_SWORD, "Long Sword"));
+	wield(setup_object(TV_SOFT_ARMOR, "Soft Leather Armour"));
+	wield(setup_object(TV_RING, "Protection"));
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cleanup_angband();
+	return 0;
+}
+
+/**
+ * Work out the state as the UI does for comparisons, once with whatever is
+ * cached and once from scratch, and check both ways agree
+ */
+static bool cache_agrees(bool known_only) {
+	struct player_state cached, fresh;
+
+	memset(&cached, 0, sizeof(cached));
+	memset(&fresh, 0, sizeof(fresh));
+	calc_bonuses(player, &cached, known_only, false);
+	reset_slot_bonuses(player);
+	calc_bonuses(player, &fresh, known_only, false);
+	return !memcmp(&cached, &fresh, sizeof(cached));
+}
+
+/**
+ * Warm the cache, then check both the known and the full state
+ */
+static bool states_agree(void) {
+	struct player_state warm;
+
+	memset(&warm, 0, sizeof(warm));
+	calc_bonuses(player, &warm, true, false);
+	calc_bonuses(player, &warm, false, false);
+	return cache_agrees(true) && cache_agrees(false);
+}
+
+static int test_changes(void *state) {
+	struct object *ring = equipped_item_by_slot_name(player, "right hand");
+	struct object *body = equipped_item_by_slot_name(player, "body");
+	struct object *weapon = equipped_item_by_slot_name(player, "weapon");
+
+	notnull(ring);
+	notnull(body);
+	notnull(weapon);
+	require(states_agree());
+
+	/* Enchantment, known and unknown */
+	ring->to_a = 12;
+	ring->to_h = 4;
+	require(states_agree());
+	ring->known->to_a = ring->to_a;
+	require(states_agree());
+	weapon->to_h = 9;
+	weapon->known->to_h = 9;
+	require(states_agree());
+
+	/* Modifiers, and learning the runes for them */
+	body->modifiers[OBJ_MOD_STR] = 3;
+	body->modifiers[OBJ_MOD_SPEED] = 5;
+	require(states_agree());
+	player->obj_k->modifiers[OBJ_MOD_STR] = 1;
+	require(states_agree());
+	player->obj_k->modifiers[OBJ_MOD_SPEED] = 1;
+	require(states_agree());
+
+	/* Flags and elements */
+	of_on(body->flags, OF_FREE_ACT);
+	require(states_agree());
+	of_on(body->known->flags, OF_FREE_ACT);
+	require(states_agree());
+	body->el_info[ELEM_FIRE].res_level = 1;
+	body->el_info[ELEM_COLD].res_level = -1;
+	require(states_agree());
+	body->known->el_info[ELEM_FIRE].res_level = 1;
+	body->known->el_info[ELEM_COLD].res_level = 1;
+	require(states_agree());
+
+	/* A curse */
+	weapon->curses = mem_zalloc(z_info->curse_max * sizeof(*weapon->curses));
+	weapon->curses[1].power = 50;
+	require(states_agree());
+	mem_free(weapon->curses);
+	weapon->curses = NULL;
+	require(states_agree());
+	ok;
+}
+
+static int test_what_if(void *state) {
+	int slot = slot_by_name(player, "body");
+	struct object *current = slot_object(player, slot);
+	struct object *other = setup_object(TV_SOFT_ARMOR, "Soft Leather Armour");
+	struct player_state before, during, after;
+
+	memset(&before, 0, sizeof(before));
+	memset(&during, 0, sizeof(during));
+	memset(&after, 0, sizeof(after));
+	other->to_a = 20;
+	other->known->to_a = 20;
+	calc_bonuses(player, &before, true, false);
+
+	/* Pretend to wear the other armour, as the object info code does */
+	player->body.slots[slot].obj = other;
+	require(states_agree());
+	calc_bonuses(player, &during, true, false);
+	require(during.to_a > before.to_a);
+	player->body.slots[slot].obj = current;
+
+	require(states_agree());
+	calc_bonuses(player, &after, true, false);
+	require(!memcmp(&before, &after, sizeof(before)));
+
+	object_free(other->known);
+	object_free(other);
+	ok;
+}
+
+const char *suite_name = "player/bonuses";
+struct test tests[] = {
+	{ "changes", test_changes },
+	{ "what if", test_what_if },
+	{ NULL, NULL }
+};
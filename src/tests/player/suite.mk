@@ -1,4 +1,5 @@
 TESTPROGS += player/birth \
+             player/bonuses \
              player/calc-inventory \
              player/combine-pack \
              player/digging \
@@ -6,11 +6,16 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #include "unit-test.h"
 #include "z-util.h"
+#include "z-virt.h"
 
 int verbose = 0;
 int forcepath = 0;
+int benchmark = 0;
+
+static unsigned long bench_allocs;
 
 int main(int argc, char *argv[]) {
 	void *state;
@@ -26,6 +31,10 @@ int main(int argc, char *argv[]) {
 	if (s && s[0]) {
 		forcepath = 1;
 	}
+	s = getenv("BENCH");
+	if (s && s[0]) {
+		benchmark = 1;
+	}
 	for (i = 1; i < argc; ++i) {
 		if (argv[i][0] == '-') {
 			if (strchr(argv[i] + 1, 'v')) {
@@ -34,6 +43,9 @@ int main(int argc, char *argv[]) {
 			if (strchr(argv[i] + 1, 'f')) {
 				forcepath = 1;
 			}
+			if (strchr(argv[i] + 1, 'b')) {
+				benchmark = 1;
+			}
 		}
 	}
 
@@ -72,3 +84,79 @@ int showfail(void) {
 	if (verbose) printf("\033[01;31mFailed\033[00m\n");
 	return 1;
 }
+
+/**
+ * Wall clock time in nanoseconds, from an arbitrary origin
+ */
+static double bench_now(void) {
+#if defined(CLOCK_MONOTONIC) && !defined(WINDOWS)
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+#else
+	return clock() * (1e9 / CLOCKS_PER_SEC);
+#endif
+}
+
+static void bench_count_alloc(size_t len) {
+	bench_allocs++;
+}
+
+struct bench_run bench_begin(const char *name, long iterations) {
+	struct bench_run run;
+
+	memset(&run, 0, sizeof(run));
+	run.name = name;
+	run.iterations = (benchmark && iterations > 0) ? iterations : 1;
+	return run;
+}
+
+/**
+ * Called before each round of a bench() loop; returns false once the
+ * measurement is done.
+ */
+bool bench_next(struct bench_run *run) {
+	if (run->round) {
+		double ns = (bench_now() - run->start) / run->iterations;
+		double allocs = (double) (bench_allocs - run->allocs)
+			/ run->iterations;
+
+		mem_alloc_hook = NULL;
+		if (!benchmark) return false;
+
+		/* The first round only warms up caches and the allocator */
+		if (run->round > 1) {
+			if (run->round == 2 || ns < run->best_ns) {
+				run->best_ns = ns;
+				run->best_allocs = allocs;
+			}
+			if (run->round > 2 && ns * 100 <= run->last_ns
+					* (100 + BENCH_TOLERANCE) && ns * 100
+					>= run->last_ns * (100 - BENCH_TOLERANCE)) {
+				run->stable++;
+			} else {
+				run->stable = 0;
+			}
+			run->last_ns = ns;
+		}
+
+		if (run->stable || run->round >= BENCH_MAX_ROUNDS) {
+			printf("bench: {\"suite\": \"%s\", \"name\": \"%s\", "
+				"\"iterations\": %ld, \"rounds\": %d, "
+				"\"stable\": %s, \"ns_per_op\": %.1f, "
+				"\"allocs_per_op\": %.2f}\n", suite_name, run->name,
+				run->iterations, run->round - 1,
+				run->stable ? "true" : "false", run->best_ns,
+				run->best_allocs);
+			fflush(stdout);
+			return false;
+		}
+	}
+
+	run->round++;
+	run->allocs = bench_allocs;
+	mem_alloc_hook = bench_count_alloc;
+	run->start = bench_now();
+	return true;
+}
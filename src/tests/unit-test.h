@@ -10,6 +10,7 @@
 
 extern int verbose;
 extern int forcepath;
+extern int benchmark;
 
 extern int showpass(void);
 extern int showfail(void);
@@ -143,6 +144,48 @@ extern int teardown_tests(void *data);
 
 #endif
 
+/*
+ * Benchmarks.  Inside a test function,
+ *
+ *	bench("los", 10000) {
+ *		los(c, a, b);
+ *	}
+ *
+ * runs the body in rounds of the given number of iterations.  The first round
+ * warms up; rounds then repeat until two in a row agree on the time per
+ * iteration to within BENCH_TOLERANCE percent or BENCH_MAX_ROUNDS is reached.
+ * The fastest round is reported as one line of JSON, prefixed by "bench: ",
+ * with the wall time per iteration and the number of mem_alloc() and
+ * mem_realloc() calls per iteration.
+ *
+ * Unless the suite was run with -b (or BENCH set in the environment), the
+ * body runs exactly once and nothing is reported, so benchmarks double as
+ * quick smoke tests in normal runs.
+ */
+#define BENCH_TOLERANCE 5
+#define BENCH_MAX_ROUNDS 20
+
+struct bench_run {
+	const char *name;
+	long iterations;
+	int round;
+	int stable;	/* Rounds in a row that agreed with the one before */
+	double start;
+	unsigned long allocs;
+	double last_ns;
+	double best_ns;
+	double best_allocs;
+};
+
+extern struct bench_run bench_begin(const char *name, long iterations);
+extern bool bench_next(struct bench_run *run);
+
+#define bench(n, count) \
+	for (struct bench_run bench_run_ = bench_begin((n), (count)); \
+			bench_next(&bench_run_); ) \
+		for (long bench_i_ = 0; bench_i_ < bench_run_.iterations; \
+				bench_i_++)
+
 /*
  * Test cases that use set_file_paths() will use TEST_DEFAULT_PATH for each
  * of the path arguments to init_file_paths() if TEST_DEFAULT_PATH is set
@@ -150,11 +150,65 @@ static int test_evaluate(void *state)
 	ok;
 }
 
+static int32_t base_value_var = 0;
+
+static int32_t base_value_variable(void)
+{
+	return base_value_var;
+}
+
+static int test_compile(void *state)
+{
+	static const char *strings[] = {
+		"+ 1 2 3",
+		"* 2 3 n + 4 - 5",
+		"/ 2 3 * 4",
+		"n n + 0 * 1 / 1",
+		"+ 7 / 2 -2 * -3 / 5",
+		"- 10 * 3 / 4 2 n + 1",
+		"* 100 100 / 7",
+		"",
+	};
+	static const int32_t bases[] = { 0, 1, -1, 7, -13, 250, -32768, 99999 };
+	size_t i, j;
+
+	for (i = 0; i < N_ELEMENTS(strings); i++) {
+		expression_t *plain = expression_new();
+		expression_t *compiled;
+
+		require(expression_add_operations_string(plain, strings[i]) >= 0);
+
+		/* With no base value function the result is a constant */
+		compiled = expression_copy(plain);
+		expression_compile(compiled);
+		eq(expression_evaluate(compiled), expression_evaluate(plain));
+
+		/* Otherwise the steps must agree for any base value */
+		expression_set_base_value(plain, base_value_variable);
+		expression_set_base_value(compiled, base_value_variable);
+		expression_compile(compiled);
+		for (j = 0; j < N_ELEMENTS(bases); j++) {
+			base_value_var = bases[j];
+			eq(expression_evaluate(compiled), expression_evaluate(plain));
+		}
+
+		/* Adding operations drops the compiled form */
+		expression_add_operations_string(plain, "+ 5");
+		expression_add_operations_string(compiled, "+ 5");
+		eq(expression_evaluate(compiled), expression_evaluate(plain));
+
+		expression_free(plain);
+		expression_free(compiled);
+	}
+	ok;
+}
+
 const char *suite_name = "z-expression/expression";
 struct test tests[] = {
 	{ "alloc", test_alloc },
 	{ "parse-success", test_parse_success },
 	{ "parse-failure", test_parse_failure },
 	{ "evaluate", test_evaluate },
+	{ "compile", test_compile },
 	{ NULL, NULL },
 };
@@ -41,6 +41,7 @@
 #include "ui-keymap.h"
 #include "ui-map.h"
 #include "ui-menu.h"
+#include "ui-mon-list.h"
 #include "ui-options.h"
 #include "ui-output.h"
 #include "ui-player.h"
@@ -92,6 +93,9 @@ void do_cmd_redraw(void)
 		player->upkeep->redraw |= (PR_BASIC | PR_EXTRA | PR_MAP | PR_INVEN |
 								   PR_EQUIP | PR_MESSAGE | PR_MONSTER |
 								   PR_OBJECT | PR_MONLIST | PR_ITEMLIST);
+
+		/* Tile sizes may have changed under the monster list */
+		monster_list_force_subwindow_update();
 	}
 
 	/* Clear screen */
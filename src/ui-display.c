@@ -1464,7 +1464,8 @@ static void do_animation(void)
 			continue;
 
 		mon->attr = attr;
-		player->upkeep->redraw |= (PR_MAP | PR_MONLIST);
+		event_signal_point(EVENT_MAP, mon->grid.x, mon->grid.y);
+		player->upkeep->redraw |= PR_MONLIST;
 	}
 
 	flicker++;
@@ -1833,7 +1834,6 @@ static void update_monlist_subwindow(game_event_type type,
 	/* Activate */
 	Term_activate(inv_term);
 
-	clear_from(0);
 	monster_list_show_subwindow(Term->hgt, Term->wid);
 	Term_fresh();
 	
@@ -1941,10 +1941,22 @@ static void update_messages_subwindow(game_event_type type,
 	Term_activate(old);
 }
 
+/**
+ * Number of changed grids a small-scale map remembers before it gives up and
+ * redraws the lot
+ */
+#define MINIMAP_DIRTY_MAX 256
+
 static struct minimap_flags
 {
 	int win_idx;
 	bool needs_redraw;
+	bool needs_full;
+	int wid, hgt;
+	int tile_wid, tile_hgt;
+	struct loc player_grid;
+	int n_dirty;
+	struct loc dirty[MINIMAP_DIRTY_MAX + 1];
 } minimap_data[ANGBAND_TERM_MAX];
 
 static void update_minimap_subwindow(game_event_type type,
@@ -1952,6 +1964,21 @@ static void update_minimap_subwindow(game_event_type type,
 {
 	struct minimap_flags *flags = user;
 
+	/* Remember changed grids, even when not drawing */
+	if (type == EVENT_MAP) {
+		if (data->point.x == -1 && data->point.y == -1) {
+			flags->needs_full = true;
+		} else if (!flags->needs_full) {
+			if (flags->n_dirty < MINIMAP_DIRTY_MAX) {
+				flags->dirty[flags->n_dirty++] =
+					loc(data->point.x, data->point.y);
+			} else {
+				flags->needs_full = true;
+			}
+		}
+		return;
+	}
+
 	if (player_resting_count(player) || player->upkeep->running) return;
 
 	if (type == EVENT_END) {
@@ -1961,18 +1988,38 @@ static void update_minimap_subwindow(game_event_type type,
 		/* Activate */
 		Term_activate(t);
 
+		/* A new size or tileset means a new layout */
+		if (t->wid != flags->wid || t->hgt != flags->hgt
+				|| tile_width != flags->tile_wid
+				|| tile_height != flags->tile_hgt) {
+			flags->needs_full = true;
+		}
+
 		/* If whole-map redraw, clear window first. */
 		if (flags->needs_redraw)
 			Term_clear();
 
-		/* Redraw map */
-		display_map(NULL, NULL);
+		/* Redraw map, or just the bits that have changed */
+		if (flags->needs_redraw || flags->needs_full) {
+			display_map(NULL, NULL);
+		} else {
+			/* Uncover wherever the player was last drawn */
+			flags->dirty[flags->n_dirty++] = flags->player_grid;
+			display_map_grids(flags->dirty, flags->n_dirty);
+		}
 		Term_fresh();
 
 		/* Restore */
 		Term_activate(old);
 
 		flags->needs_redraw = false;
+		flags->needs_full = false;
+		flags->n_dirty = 0;
+		flags->player_grid = player->grid;
+		flags->wid = t->wid;
+		flags->hgt = t->hgt;
+		flags->tile_wid = tile_width;
+		flags->tile_hgt = tile_height;
 	} else if (type == EVENT_DUNGEONLEVEL) {
 		/* XXX map_height and map_width need to be kept in sync with
 		 * display_map() */
@@ -1985,6 +2032,7 @@ static void update_minimap_subwindow(game_event_type type,
 		if (cave->height <= map_height || cave->width <= map_width) {
 			flags->needs_redraw = true;
 		}
+		flags->needs_full = true;
 	}
 }
 
@@ -2256,6 +2304,8 @@ static void subwindow_flag_changed(int win_idx, uint32_t flag, bool new_state)
 		case PW_MAP:
 		{
 			minimap_data[win_idx].win_idx = win_idx;
+			minimap_data[win_idx].needs_full = true;
+			minimap_data[win_idx].n_dirty = 0;
 
 			register_or_deregister(EVENT_MAP,
 					       update_minimap_subwindow,
@@ -2311,6 +2361,10 @@ static void subwindow_flag_changed(int win_idx, uint32_t flag, bool new_state)
 			register_or_deregister(EVENT_MONSTERLIST,
 					       update_monlist_subwindow,
 					       angband_term[win_idx]);
+
+			/* The term is about to be cleared */
+			if (new_state && cave)
+				monster_list_force_subwindow_update();
 			break;
 		}
 
@@ -2603,6 +2603,7 @@ static int initialize_summary(struct player *p,
 		if (stores[i].feat == FEAT_HOME) {
 			continue;
 		}
+		store_catch_up(&stores[i]);
 		apply_visitor_to_pile(stores[i].stock, &visitor);
 	}
 
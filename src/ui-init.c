@@ -27,12 +27,14 @@
 #include "game-input.h"
 #include "game-event.h"
 #include "init.h"
+#include "mon-lore.h"
 #include "ui-display.h"
 #include "ui-game.h"
 #include "ui-init.h"
 #include "ui-input.h"
 #include "ui-keymap.h"
 #include "ui-knowledge.h"
+#include "ui-mon-lore.h"
 #include "ui-options.h"
 #include "ui-output.h"
 #include "ui-prefs.h"
@@ -86,6 +88,7 @@ void textui_init(void)
 		/* Redo knowledge initialization. */
 		textui_knowledge_cleanup();
 		textui_knowledge_init();
+		lore_description_cache_free();
 	}
 
 	/* initialize window options that will be overridden by the savefile */
@@ -118,4 +121,5 @@ void textui_cleanup(void)
 	keymap_free();
 	textui_prefs_free();
 	textui_knowledge_cleanup();
+	lore_description_cache_free();
 }
@@ -174,6 +174,9 @@ ui_event inkey_ex(void)
 
 	term *old = Term;
 
+	/* Show any redraws held back before waiting for a key */
+	event_flush_deferred();
+
 	/* Delayed flush */
 	if (inkey_xtra) {
 		Term_flush();
@@ -1502,14 +1502,10 @@ static struct object *find_artifact(struct artifact *artifact)
 		int j;
 		if (strstr(c->name, "known")) continue;
 
-		/* Ground objects */
-		for (y = 1; y < c->height; y++) {
-			for (x = 1; x < c->width; x++) {
-				struct loc grid = loc(x, y);
-				for (obj = square_object(c, grid); obj; obj = obj->next) {
-					if (obj->artifact == artifact) return obj;
-				}
-			}
+		/* Ground objects; use the object list, as the grids may be packed */
+		for (j = 1; j < c->obj_max; j++) {
+			obj = c->objects[j];
+			if (obj && obj->artifact == artifact) return obj;
 		}
 
 		/* Monster objects */
@@ -632,17 +632,9 @@ static void prt_map_aux(void)
 		/* No window */
 		if (!t) continue;
 
-		/* No relevant flags */
+		/* No relevant flags; small-scale maps look after themselves */
 		if (!(window_flag[j] & (PW_MAPS))) continue;
-
-		if (window_flag[j] & PW_MAP) {
-			term *old = Term;
-
-			Term_activate(t);
-			display_map(NULL, NULL);
-			Term_activate(old);
-			continue;
-		}
+		if (window_flag[j] & PW_MAP) continue;
 
 		/* Assume screen */
 		ty = t->offset_y + (t->hgt / tile_height);
@@ -743,6 +735,102 @@ void prt_map(void)
 		}
 }
 
+/**
+ * Return the row of the small-scale map that shows grids in dungeon row y.
+ */
+static int minimap_row(int y, int map_hgt)
+{
+	int row = (y * map_hgt) / cave->height;
+
+	if (tile_height > 1) row = row - (row % tile_height);
+	return row;
+}
+
+/**
+ * Return the column of the small-scale map that shows grids in dungeon
+ * column x.
+ */
+static int minimap_col(int x, int map_wid)
+{
+	int col = (x * map_wid) / cave->width;
+
+	if (tile_width > 1) col = col - (col % tile_width);
+	return col;
+}
+
+/**
+ * Work out the priority of a grid for the small-scale map.
+ */
+static uint8_t minimap_priority(struct loc grid, struct grid_data *g)
+{
+	int a, ta;
+	wchar_t c, tc;
+
+	/* Get the attr/char at that map location */
+	map_info(grid, g);
+	grid_data_as_text(g, &a, &c, &ta, &tc);
+
+	/* Stuff on top of terrain gets higher priority */
+	if ((a != ta) || (c != tc)) return 20;
+
+	return f_info[g->f_idx].priority;
+}
+
+/**
+ * Draw one grid on the small-scale map, at the given map row and column.
+ */
+static void minimap_draw(struct grid_data *g, int row, int col)
+{
+	int a, ta;
+	wchar_t c, tc;
+
+	/* Hack - make every grid on the map lit */
+	g->lighting = LIGHTING_LIT;
+	grid_data_as_text(g, &a, &c, &ta, &tc);
+
+	Term_queue_char(Term, col + 1, row + 1, a, c, ta, tc);
+
+	if ((tile_width > 1) || (tile_height > 1))
+		Term_big_queue_char(Term, col + 1, row + 1, Term->hgt - 1,
+			255, -1, 0, 0);
+}
+
+/**
+ * Draw the player on the small-scale map, returning the screen location.
+ */
+static void minimap_draw_player(int map_hgt, int map_wid, int *cy, int *cx)
+{
+	struct monster_race *race = &r_info[0];
+	struct grid_data g;
+	int row, col;
+	int a, ta;
+	wchar_t c, tc;
+
+	/* Player location */
+	row = minimap_row(player->grid.y, map_hgt);
+	col = minimap_col(player->grid.x, map_wid);
+
+	/* Get the terrain at the player's spot. */
+	map_info(player->grid, &g);
+	g.lighting = LIGHTING_LIT;
+	grid_data_as_text(&g, &a, &c, &ta, &tc);
+
+	/* Get the "player" tile */
+	a = monster_x_attr[race->ridx];
+	c = monster_x_char[race->ridx];
+
+	/* Draw the player */
+	Term_queue_char(Term, col + 1, row + 1, a, c, ta, tc);
+
+	if ((tile_width > 1) || (tile_height > 1))
+		Term_big_queue_char(Term, col + 1, row + 1, Term->hgt - 1,
+			255, -1, 0, 0);
+
+	/* Return player location */
+	if (cy != NULL) (*cy) = row + 1;
+	if (cx != NULL) (*cx) = col + 1;
+}
+
 /**
  * Display a "small-scale" map of the dungeon in the active Term.
  *
@@ -766,35 +854,21 @@ void display_map(int *cy, int *cx)
 	int x, y;
 	struct grid_data g;
 
-	int a, ta;
-	wchar_t c, tc;
-
 	uint8_t tp;
 
-	struct monster_race *race = &r_info[0];
-
 	/* Priority array */
-	uint8_t **mp = mem_zalloc(cave->height * sizeof(uint8_t*));
-	for (y = 0; y < cave->height; y++)
-		mp[y] = mem_zalloc(cave->width * sizeof(uint8_t));
+	uint8_t **mp;
 
 	/* Desired map height */
 	get_minimap_dimensions(Term, cave, tile_width, tile_height,
 		&map_wid, &map_hgt);
 
 	/* Prevent accidents */
-	if ((map_wid < 1) || (map_hgt < 1)) {
-		for (y = 0; y < cave->height; y++)
-			mem_free(mp[y]);
-		mem_free(mp);
-		return;
-	}
+	if ((map_wid < 1) || (map_hgt < 1)) return;
 
-	/* Nothing here */
-	a = COLOUR_WHITE;
-    c = L' ';
-	ta = COLOUR_WHITE;
-	tc = L' ';
+	mp = mem_zalloc(cave->height * sizeof(uint8_t*));
+	for (y = 0; y < cave->height; y++)
+		mp[y] = mem_zalloc(cave->width * sizeof(uint8_t));
 
 	/* Draw a box around the edge of the term */
 	window_make(0, 0, map_wid + 1, map_hgt + 1);
@@ -813,35 +887,17 @@ void display_map(int *cy, int *cx)
 
 	/* Analyze the actual map */
 	for (y = 0; y < cave->height; y++) {
-		row = (y * map_hgt) / cave->height;
-		if (tile_height > 1) row = row - (row % tile_height);
+		row = minimap_row(y, map_hgt);
 
 		for (x = 0; x < cave->width; x++) {
-			col = (x * map_wid) / cave->width;
-			if (tile_width > 1) col = col - (col % tile_width);
-
-			/* Get the attr/char at that map location */
-			map_info(loc(x, y), &g);
-			grid_data_as_text(&g, &a, &c, &ta, &tc);
+			col = minimap_col(x, map_wid);
 
 			/* Get the priority of that attr/char */
-			tp = f_info[g.f_idx].priority;
-
-			/* Stuff on top of terrain gets higher priority */
-			if ((a != ta) || (c != tc)) tp = 20;
+			tp = minimap_priority(loc(x, y), &g);
 
 			/* Save "best" */
 			if (mp[row][col] < tp) {
-				/* Hack - make every grid on the map lit */
-				g.lighting = LIGHTING_LIT;
-				grid_data_as_text(&g, &a, &c, &ta, &tc);
-
-				Term_queue_char(Term, col + 1, row + 1, a, c, ta, tc);
-
-				if ((tile_width > 1) || (tile_height > 1))
-					Term_big_queue_char(Term, col + 1,
-						row + 1, Term->hgt - 1,
-						255, -1, 0, 0);
+				minimap_draw(&g, row, col);
 
 				/* Save priority */
 				mp[row][col] = tp;
@@ -850,41 +906,74 @@ void display_map(int *cy, int *cx)
 	}
 
 	/*** Display the player ***/
-
-	/* Player location */
-	row = (player->grid.y * map_hgt / cave->height);
-	col = (player->grid.x * map_wid / cave->width);
-
-	if (tile_width > 1)
-		col = col - (col % tile_width);
-	if (tile_height > 1)
-		row = row - (row % tile_height);
-
-	/* Get the terrain at the player's spot. */
-	map_info(player->grid, &g);
-	g.lighting = LIGHTING_LIT;
-	grid_data_as_text(&g, &a, &c, &ta, &tc);
-
-	/* Get the "player" tile */
-	a = monster_x_attr[race->ridx];
-	c = monster_x_char[race->ridx];
-
-	/* Draw the player */
-	Term_queue_char(Term, col + 1, row + 1, a, c, ta, tc);
-
-	if ((tile_width > 1) || (tile_height > 1))
-		Term_big_queue_char(Term, col + 1, row + 1, Term->hgt - 1,
-			255, -1, 0, 0);
-  
-	/* Return player location */
-	if (cy != NULL) (*cy) = row + 1;
-	if (cx != NULL) (*cx) = col + 1;
+	minimap_draw_player(map_hgt, map_wid, cy, cx);
 
 	for (y = 0; y < cave->height; y++)
 		mem_free(mp[y]);
 	mem_free(mp);
 }
 
+/**
+ * Redraw only the parts of a "small-scale" map, already shown in the active
+ * Term by display_map(), that cover the given grids.
+ *
+ * Each map cell covers a block of grids; the whole block is looked at again
+ * so the cell ends up exactly as display_map() would draw it.
+ *
+ * \param grids are the grids that have changed since the map was drawn.
+ * \param n is the number of grids.
+ */
+void display_map_grids(const struct loc *grids, int n)
+{
+	int map_hgt, map_wid;
+	uint8_t *done;
+	int i;
+
+	get_minimap_dimensions(Term, cave, tile_width, tile_height,
+		&map_wid, &map_hgt);
+	if ((map_wid < 1) || (map_hgt < 1)) return;
+
+	done = mem_zalloc(map_hgt * map_wid * sizeof(*done));
+	for (i = 0; i < n; i++) {
+		struct grid_data g, best_g;
+		uint8_t tp, best = 0;
+		int row, col, y0, y1, x0, x1, x, y;
+
+		if (!square_in_bounds(cave, grids[i])) continue;
+
+		row = minimap_row(grids[i].y, map_hgt);
+		col = minimap_col(grids[i].x, map_wid);
+		if (done[row * map_wid + col]) continue;
+		done[row * map_wid + col] = 1;
+
+		/* Find the block of grids shown in this cell */
+		y0 = y1 = grids[i].y;
+		while (y0 > 0 && minimap_row(y0 - 1, map_hgt) == row) y0--;
+		while (y1 < cave->height - 1 && minimap_row(y1 + 1, map_hgt) == row)
+			y1++;
+		x0 = x1 = grids[i].x;
+		while (x0 > 0 && minimap_col(x0 - 1, map_wid) == col) x0--;
+		while (x1 < cave->width - 1 && minimap_col(x1 + 1, map_wid) == col)
+			x1++;
+
+		/* The first grid of the highest priority wins, as above */
+		for (y = y0; y <= y1; y++) {
+			for (x = x0; x <= x1; x++) {
+				tp = minimap_priority(loc(x, y), &g);
+				if (best < tp) {
+					best = tp;
+					best_g = g;
+				}
+			}
+		}
+		if (best) minimap_draw(&best_g, row, col);
+	}
+	mem_free(done);
+
+	/* The player always goes on top */
+	minimap_draw_player(map_hgt, map_wid, NULL, NULL);
+}
+
 
 /*
  * Display a "small-scale" map of the dungeon.
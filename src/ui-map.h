@@ -22,4 +22,5 @@ extern void move_cursor_relative(int y, int x);
 extern void print_rel(wchar_t c, uint8_t a, int y, int x);
 extern void prt_map(void);
 extern void display_map(int *cy, int *cx);
+extern void display_map_grids(const struct loc *grids, int n);
 extern void do_cmd_view_map(void);
@@ -22,6 +22,7 @@
 #include "mon-lore.h"
 #include "mon-util.h"
 #include "player-timed.h"
+#include "ui-input.h"
 #include "ui-mon-list.h"
 #include "ui-output.h"
 #include "ui-prefs.h"
@@ -341,7 +342,8 @@ static void monster_list_get_glyphs(monster_list_t *list)
  *
  * In order to support more efficient monster flicker animations, this function
  * uses a shared list object so that it's not constantly allocating and freeing
- * the list.
+ * the list. The term is only cleared and redrawn when the list differs from
+ * what was last shown.
  *
  * \param height is the height of the list.
  * \param width is the width of the list.
@@ -350,28 +352,23 @@ void monster_list_show_subwindow(int height, int width)
 {
 	textblock *tb;
 	monster_list_t *list;
-	int i;
 
 	if (height < 1 || width < 1)
 		return;
 
-	tb = textblock_new();
 	list = monster_list_shared_instance();
 
-	/* Force an update if detected monsters */
-	for (i = 1; i < cave_monster_max(cave); i++) {
-		if (mflag_has(cave_monster(cave, i)->mflag, MFLAG_MARK)) {
-			list->creation_turn = -1;
-			break;
-		}
-	}
-
 	monster_list_reset(list);
 	monster_list_collect(list);
 	monster_list_get_glyphs(list);
 	monster_list_sort(list, monster_list_standard_compare);
 
+	if (!monster_list_changed(list, Term, height, width))
+		return;
+
 	/* Draw the list to exactly fit the subwindow. */
+	tb = textblock_new();
+	clear_from(0);
 	monster_list_format_textblock(list, tb, height, width, NULL, NULL);
 	textui_textblock_place(tb, SCREEN_REGION, NULL);
 
@@ -459,11 +456,11 @@ void monster_list_show_interactive(int height, int width)
 /**
  * Force an update to the monster list subwindow.
  *
- * There are conditions that monster_list_reset() can't catch, so we set the
- * turn an invalid value to force the list to update.
+ * There are conditions that monster_list_changed() can't catch, so we mark
+ * what was last shown as stale to force the list to redraw.
  */
 void monster_list_force_subwindow_update(void)
 {
 	monster_list_t *list = monster_list_shared_instance();
-	list->creation_turn = -1;
+	list->shown_stale = true;
 }
@@ -19,6 +19,10 @@
 #include "angband.h"
 #include "init.h"
 #include "mon-lore.h"
+#include "obj-gear.h"
+#include "obj-tval.h"
+#include "player-attack.h"
+#include "player-timed.h"
 #include "ui-mon-lore.h"
 #include "ui-output.h"
 #include "ui-prefs.h"
@@ -76,8 +80,154 @@ void lore_title(textblock *tb, const struct monster_race *race)
 }
 
 /**
- * Place a full monster recall description (with title) into a textblock, with
- * or without spoilers.
+ * ------------------------------------------------------------------------
+ * Remembered recalls
+ *
+ * Formatting a recall is slow, and the same one is wanted over and over while
+ * a monster is tracked in a subwindow or browsed in the knowledge menu.  Lore
+ * is changed by direct assignment all over the game, and the text also
+ * depends on the player, so a remembered recall is reused only while a
+ * fingerprint of everything it was made from still matches.
+ * ------------------------------------------------------------------------ */
+#define LORE_CACHE_SIZE 16
+
+struct lore_cache_entry {
+	const struct monster_race *race;
+	uint64_t key;
+	textblock *tb;
+};
+
+static struct lore_cache_entry lore_cache[LORE_CACHE_SIZE];
+static uint32_t lore_cache_hits, lore_cache_misses;
+
+static uint64_t hash_bytes(uint64_t h, const void *data, size_t len)
+{
+	const uint8_t *b = data;
+	size_t i;
+
+	/* FNV-1a */
+	for (i = 0; i < len; i++) {
+		h ^= b[i];
+		h *= 0x100000001b3ULL;
+	}
+	return h;
+}
+
+/**
+ * Fingerprint the lore and the parts of the player a recall reads
+ */
+static uint64_t lore_description_key(const struct monster_race *race,
+		const struct monster_lore *lore)
+{
+	struct player_state *state = &player->known_state;
+	struct object *weapon = equipped_item_by_slot_name(player, "weapon");
+	struct object *light = equipped_item_by_slot_name(player, "light");
+	uint64_t h = 0xcbf29ce484222325ULL;
+	uint8_t extra = (lore_is_fully_known(race) ? 1 : 0)
+		| (OPT(player, purple_uniques) ? 2 : 0)
+		| (OPT(player, effective_speed) ? 4 : 0)
+		| ((light && light->timeout && !of_has(light->flags, OF_NO_FUEL)) ?
+		8 : 0);
+	int i, chance = chance_of_melee_hit_base(player, weapon);
+
+	/* The lore */
+	h = hash_bytes(h, &race, sizeof(race));
+	h = hash_bytes(h, &lore->sights, sizeof(lore->sights));
+	h = hash_bytes(h, &lore->deaths, sizeof(lore->deaths));
+	h = hash_bytes(h, &lore->pkills, sizeof(lore->pkills));
+	h = hash_bytes(h, &lore->thefts, sizeof(lore->thefts));
+	h = hash_bytes(h, &lore->tkills, sizeof(lore->tkills));
+	h = hash_bytes(h, &lore->wake, sizeof(lore->wake));
+	h = hash_bytes(h, &lore->ignore, sizeof(lore->ignore));
+	h = hash_bytes(h, &lore->drop_gold, sizeof(lore->drop_gold));
+	h = hash_bytes(h, &lore->drop_item, sizeof(lore->drop_item));
+	h = hash_bytes(h, &lore->cast_innate, sizeof(lore->cast_innate));
+	h = hash_bytes(h, &lore->cast_spell, sizeof(lore->cast_spell));
+	h = hash_bytes(h, lore->flags, sizeof(lore->flags));
+	h = hash_bytes(h, lore->spell_flags, sizeof(lore->spell_flags));
+	h = hash_bytes(h, &lore->all_known, sizeof(lore->all_known));
+	h = hash_bytes(h, &lore->armour_known, sizeof(lore->armour_known));
+	h = hash_bytes(h, &lore->drop_known, sizeof(lore->drop_known));
+	h = hash_bytes(h, &lore->sleep_known, sizeof(lore->sleep_known));
+	h = hash_bytes(h, &lore->spell_freq_known,
+		sizeof(lore->spell_freq_known));
+	h = hash_bytes(h, &lore->innate_freq_known,
+		sizeof(lore->innate_freq_known));
+	for (i = 0; i < z_info->mon_blows_max; i++) {
+		const struct monster_blow *blow = &lore->blows[i];
+
+		h = hash_bytes(h, &blow->method, sizeof(blow->method));
+		h = hash_bytes(h, &blow->effect, sizeof(blow->effect));
+		h = hash_bytes(h, &blow->dice.base, sizeof(blow->dice.base));
+		h = hash_bytes(h, &blow->dice.dice, sizeof(blow->dice.dice));
+		h = hash_bytes(h, &blow->dice.sides, sizeof(blow->dice.sides));
+		h = hash_bytes(h, &blow->dice.m_bonus, sizeof(blow->dice.m_bonus));
+		h = hash_bytes(h, &blow->times_seen, sizeof(blow->times_seen));
+		h = hash_bytes(h, &lore->blow_known[i], sizeof(bool));
+	}
+
+	/* The player, and how the monster is drawn */
+	h = hash_bytes(h, &player->lev, sizeof(player->lev));
+	h = hash_bytes(h, &player->max_depth, sizeof(player->max_depth));
+	h = hash_bytes(h, &player->state.speed, sizeof(player->state.speed));
+	h = hash_bytes(h, &player->state.ac, sizeof(player->state.ac));
+	h = hash_bytes(h, &player->state.to_a, sizeof(player->state.to_a));
+	h = hash_bytes(h, &chance, sizeof(chance));
+	h = hash_bytes(h, state->stat_ind, sizeof(state->stat_ind));
+	h = hash_bytes(h, state->skills, sizeof(state->skills));
+	h = hash_bytes(h, state->flags, sizeof(state->flags));
+	for (i = 0; i < ELEM_MAX; i++)
+		h = hash_bytes(h, &state->el_info[i].res_level,
+			sizeof(state->el_info[i].res_level));
+	for (i = 0; i < TMD_MAX; i++) {
+		bool on = player->timed[i] > 0;
+
+		h = hash_bytes(h, &on, sizeof(on));
+	}
+	for (i = 0; i < z_info->pack_size; i++) {
+		struct object *obj = player->upkeep->inven[i];
+		uint8_t has = 0;
+
+		if (!obj) continue;
+		if (tval_can_have_charges(obj) && obj->pval) has |= 1;
+		if (tval_is_edible(obj)) has |= 2;
+		h = hash_bytes(h, &has, sizeof(has));
+	}
+	h = hash_bytes(h, &extra, sizeof(extra));
+	h = hash_bytes(h, &monster_x_attr[race->ridx],
+		sizeof(monster_x_attr[race->ridx]));
+	h = hash_bytes(h, &monster_x_char[race->ridx],
+		sizeof(monster_x_char[race->ridx]));
+	h = hash_bytes(h, &tile_width, sizeof(tile_width));
+	h = hash_bytes(h, &tile_height, sizeof(tile_height));
+	return h;
+}
+
+/**
+ * Report how often a remembered recall was used
+ */
+void lore_description_cache_counts(uint32_t *hits, uint32_t *misses)
+{
+	*hits = lore_cache_hits;
+	*misses = lore_cache_misses;
+}
+
+/**
+ * Let go of all remembered recalls
+ */
+void lore_description_cache_free(void)
+{
+	int i;
+
+	for (i = 0; i < LORE_CACHE_SIZE; i++) {
+		if (lore_cache[i].tb) textblock_free(lore_cache[i].tb);
+	}
+	memset(lore_cache, 0, sizeof(lore_cache));
+}
+
+/**
+ * Format a full monster recall description (with title) into a textblock,
+ * with or without spoilers.
  *
  * \param tb is the textblock we are placing the description into.
  * \param race is the monster race we are describing.
@@ -86,8 +236,9 @@ void lore_title(textblock *tb, const struct monster_race *race)
  *        information without subjective information and monster flavor,
  *        while `false` only shows what the player knows.
  */
-void lore_description(textblock *tb, const struct monster_race *race,
-					  const struct monster_lore *original_lore, bool spoilers)
+static void lore_description_calc(textblock *tb,
+		const struct monster_race *race,
+		const struct monster_lore *original_lore, bool spoilers)
 {
 	struct monster_lore mutable_lore;
 	struct monster_lore *lore = &mutable_lore;
@@ -150,6 +301,48 @@ void lore_description(textblock *tb, const struct monster_race *race,
 	textblock_append(tb, "\n");
 }
 
+/**
+ * Place a full monster recall description (with title) into a textblock, with
+ * or without spoilers.
+ *
+ * Recalls for the player are remembered and reused while nothing they show
+ * has changed; spoilers are written once per race and always made afresh.
+ *
+ * \param tb is the textblock we are placing the description into.
+ * \param race is the monster race we are describing.
+ * \param original_lore is the known information about the monster race.
+ * \param spoilers indicates what information is used; `true` will display full
+ *        information without subjective information and monster flavor,
+ *        while `false` only shows what the player knows.
+ */
+void lore_description(textblock *tb, const struct monster_race *race,
+					  const struct monster_lore *original_lore, bool spoilers)
+{
+	struct lore_cache_entry *entry;
+	uint64_t key;
+
+	assert(tb && race && original_lore);
+
+	if (spoilers) {
+		lore_description_calc(tb, race, original_lore, true);
+		return;
+	}
+
+	key = lore_description_key(race, original_lore);
+	entry = &lore_cache[race->ridx % LORE_CACHE_SIZE];
+	if (entry->tb && entry->race == race && entry->key == key) {
+		lore_cache_hits++;
+	} else {
+		lore_cache_misses++;
+		if (entry->tb) textblock_free(entry->tb);
+		entry->race = race;
+		entry->key = key;
+		entry->tb = textblock_new();
+		lore_description_calc(entry->tb, race, original_lore, false);
+	}
+	textblock_append_textblock(tb, entry->tb);
+}
+
 /**
  * Display monster recall modally and wait for a keypress.
  *
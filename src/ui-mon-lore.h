@@ -19,6 +19,8 @@
 #ifndef UI_MONSTER_LORE_H
 #define UI_MONSTER_LORE_H
 
+void lore_description_cache_counts(uint32_t *hits, uint32_t *misses);
+void lore_description_cache_free(void);
 void lore_title(textblock *tb, const struct monster_race *race);
 void lore_description(textblock *tb, const struct monster_race *race,
 					  const struct monster_lore *original_lore, bool spoilers);
@@ -741,6 +741,64 @@ void Term_queue_chars(int x, int y, int n, int a, const wchar_t *s)
  * ------------------------------------------------------------------------ */
 
 
+/**
+ * Cells compared at a time when skipping unchanged parts of a row
+ */
+#define TERM_SPAN_BLOCK 16
+
+/**
+ * Check whether cells x to x + n - 1 of row y are the same in the displayed
+ * and requested screen images. The terrain layer is only looked at if
+ * "terrain" is true.
+ */
+static bool Term_cells_same(int y, int x, int n, bool terrain)
+{
+	const term_win *old = Term->old;
+	const term_win *scr = Term->scr;
+
+	if (memcmp(&old->a[y][x], &scr->a[y][x], n * sizeof(int))) return false;
+	if (memcmp(&old->c[y][x], &scr->c[y][x], n * sizeof(wchar_t)))
+		return false;
+	if (!terrain) return true;
+	if (memcmp(&old->ta[y][x], &scr->ta[y][x], n * sizeof(int)))
+		return false;
+	return !memcmp(&old->tc[y][x], &scr->tc[y][x], n * sizeof(wchar_t));
+}
+
+/**
+ * Shrink the modified columns of a row (see "Term_fresh") to the span that
+ * really differs from what is displayed.
+ *
+ * The queue functions only widen the modified columns, so they often cover
+ * long runs that were changed back or never changed at all. Whole blocks are
+ * skipped with memcmp(), which the C library already vectorises where the
+ * hardware allows, before looking at single cells.
+ *
+ * \return false if nothing in the row differs.
+ */
+static bool Term_fresh_row_span(int y, int *x1, int *x2, bool terrain)
+{
+	int lo = *x1, hi = *x2;
+
+	/* Skip unchanged cells at the start */
+	while (hi - lo + 1 >= TERM_SPAN_BLOCK
+			&& Term_cells_same(y, lo, TERM_SPAN_BLOCK, terrain))
+		lo += TERM_SPAN_BLOCK;
+	while (lo <= hi && Term_cells_same(y, lo, 1, terrain)) lo++;
+	if (lo > hi) return false;
+
+	/* Skip unchanged cells at the end */
+	while (hi - lo + 1 > TERM_SPAN_BLOCK
+			&& Term_cells_same(y, hi - TERM_SPAN_BLOCK + 1,
+				TERM_SPAN_BLOCK, terrain))
+		hi -= TERM_SPAN_BLOCK;
+	while (Term_cells_same(y, hi, 1, terrain)) hi--;
+
+	*x1 = lo;
+	*x2 = hi;
+	return true;
+}
+
 /**
  * Flush a row of the current window (see "Term_fresh")
  *
@@ -1837,6 +1895,15 @@ errr Term_fresh(void)
 		int **pr_drw;
 		int ipr;
 
+		/*
+		 * Rows can be cut down to the span that really changed, unless
+		 * unchanged cells may still need drawing for double-height
+		 * tiles or the padding of big tiles.
+		 */
+		bool trim = !Term->dblh_hook && (Term->always_pict
+			|| !Term->higher_pict
+			|| (tile_width == 1 && tile_height == 1));
+
 		if (Term->dblh_hook && (Term->always_pict ||
 				Term->higher_pict)) {
 			/*
@@ -1882,6 +1949,11 @@ errr Term_fresh(void)
 				Term->x1[y] = w;
 				Term->x2[y] = 0;
 
+				/* Skip rows whose changes were all undone */
+				if (trim && !Term_fresh_row_span(y, &x1, &x2,
+						Term->always_pict || Term->higher_pict))
+					continue;
+
 				/* Use "Term_pict()" - always, sometimes or never */
 				if (Term->always_pict) {
 					/* Flush the row */
@@ -42,6 +42,9 @@
 #include "ui-command.h"
 #include "wizard.h"
 #include <math.h>
+#ifdef UNIX
+#include <sys/wait.h>
+#endif
 
 /**
  * The stats programs here will provide information on the dungeon, the monsters
@@ -69,6 +72,204 @@
 
 #ifdef USE_STATS
 
+/*** Workers ***/
+
+/**
+ * The simulations are independent of each other, so they can be split across
+ * worker processes.  Each worker is forked from the running game, so it
+ * starts with a copy of the game state (level generation leans on globals,
+ * which rules out threads), runs its share into its own accumulator, and
+ * writes that back through a pipe.  The parent then merges the accumulators
+ * in worker order and writes the results out as before.
+ *
+ * With one worker, or where fork() is not available, everything is run in
+ * process.
+ */
+static int stats_workers = 1;
+
+/* Set in a worker process; workers must not touch the display */
+static bool stats_in_worker = false;
+
+/**
+ * One end of the pipe between a worker and the parent.
+ */
+struct stats_pipe {
+	int fd;
+	bool reading;
+	bool ok;
+};
+
+/**
+ * How to run and combine one kind of statistics.
+ */
+struct stats_collector {
+	/* Run simulations first to first + count - 1; worker is the worker
+	 * index or -1 if not running in a worker */
+	void (*run)(void *acc, int worker, int first, int count);
+	/* Make an empty accumulator, shaped like acc, to receive a worker's
+	 * results */
+	void *(*new_acc)(const void *acc);
+	void (*free_acc)(void *acc);
+	/* Send or receive the accumulator's contents */
+	void (*transfer)(void *acc, struct stats_pipe *p);
+	/* Add from into acc */
+	void (*merge)(void *acc, const void *from);
+};
+
+/**
+ * Set the number of worker processes used by the collectors here.
+ */
+void stats_set_workers(int n)
+{
+	stats_workers = MAX(1, n);
+}
+
+/**
+ * Send or receive len bytes at data.
+ */
+static void stats_transfer(struct stats_pipe *p, void *data, size_t len)
+{
+#ifdef UNIX
+	char *b = data;
+
+	while (p->ok && len > 0) {
+		ssize_t n = p->reading ? read(p->fd, b, len) :
+			write(p->fd, b, len);
+
+		if (n < 0 && errno == EINTR) continue;
+		if (n <= 0) {
+			p->ok = false;
+			break;
+		}
+		b += n;
+		len -= n;
+	}
+#else
+	p->ok = false;
+#endif
+}
+
+/**
+ * The level generation events, whose handlers a worker keeps.
+ */
+static const game_event_type stats_gen_events[] = {
+	EVENT_GEN_LEVEL_START,
+	EVENT_GEN_LEVEL_END,
+	EVENT_GEN_ROOM_START,
+	EVENT_GEN_ROOM_CHOOSE_SIZE,
+	EVENT_GEN_ROOM_CHOOSE_SUBTYPE,
+	EVENT_GEN_ROOM_END,
+	EVENT_GEN_TUNNEL_FINISHED,
+	EVENT_GEN_LEVEL_ATTEMPT
+};
+
+/**
+ * Drop every event handler apart from the level generation ones, so a worker
+ * does not draw on the parent's display.
+ */
+static void stats_detach_display(void)
+{
+	int i;
+
+	for (i = 0; i < N_GAME_EVENTS; i++) {
+		size_t j;
+
+		for (j = 0; j < N_ELEMENTS(stats_gen_events); j++) {
+			if (stats_gen_events[j] == (game_event_type) i) break;
+		}
+		if (j < N_ELEMENTS(stats_gen_events)) continue;
+		event_remove_handler_type(i);
+	}
+}
+
+/**
+ * Run nsim simulations, split across the workers, into acc.
+ */
+static void stats_run(const struct stats_collector *sc, void *acc, int nsim)
+{
+#ifdef UNIX
+	int nworker = MIN(stats_workers, nsim);
+	pid_t *pids;
+	int *fds, *firsts;
+	int w;
+
+	if (nworker <= 1) {
+		sc->run(acc, -1, 0, nsim);
+		return;
+	}
+
+	pids = mem_zalloc(nworker * sizeof(*pids));
+	fds = mem_alloc(nworker * sizeof(*fds));
+	firsts = mem_alloc((nworker + 1) * sizeof(*firsts));
+	firsts[0] = 0;
+	for (w = 0; w < nworker; w++) {
+		firsts[w + 1] = firsts[w] + nsim / nworker
+			+ ((w < nsim % nworker) ? 1 : 0);
+	}
+
+	fflush(NULL);
+	for (w = 0; w < nworker; w++) {
+		/* Give each worker its own random sequence */
+		uint32_t seed = Rand_div(0x10000000);
+		int pfd[2];
+
+		if (pipe(pfd) != 0) continue;
+		pids[w] = fork();
+		if (pids[w] == 0) {
+			struct stats_pipe p = { pfd[1], false, true };
+
+			close(pfd[0]);
+			stats_in_worker = true;
+			stats_detach_display();
+			Rand_state_init(seed);
+			sc->run(acc, w, firsts[w], firsts[w + 1] - firsts[w]);
+			sc->transfer(acc, &p);
+			close(pfd[1]);
+			_exit(p.ok ? 0 : 1);
+		}
+		close(pfd[1]);
+		if (pids[w] > 0) {
+			fds[w] = pfd[0];
+		} else {
+			close(pfd[0]);
+			pids[w] = 0;
+		}
+	}
+
+	/* Do the share of any worker that could not be started here, once
+	 * nothing else will be forked from this accumulator */
+	for (w = 0; w < nworker; w++) {
+		if (!pids[w]) {
+			sc->run(acc, -1, firsts[w], firsts[w + 1] - firsts[w]);
+		}
+	}
+
+	for (w = 0; w < nworker; w++) {
+		struct stats_pipe p = { fds[w], true, true };
+		void *part;
+		int status = 0;
+
+		if (!pids[w]) continue;
+		part = sc->new_acc(acc);
+		sc->transfer(part, &p);
+		close(fds[w]);
+		while (waitpid(pids[w], &status, 0) < 0 && errno == EINTR) ;
+		if (p.ok && WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+			sc->merge(acc, part);
+		} else {
+			msg("Statistics worker %d failed; its results are lost.",
+				w);
+		}
+		sc->free_acc(part);
+	}
+	mem_free(firsts);
+	mem_free(fds);
+	mem_free(pids);
+#else
+	sc->run(acc, -1, 0, nsim);
+#endif
+}
+
 /*** Statsgen ***/
 
 /* Logfile to store results in */
@@ -92,13 +293,6 @@ bool clearing = false;
 /* flag for regenning randart */
 bool regen = false;
 
-/*** These are items to track for each iteration ***/
-/* total number of artifacts found */
-static int art_it[TRIES_SIZE];
-
-/*** handle gold separately ***/
-/* gold */
-static double gold_total[MAX_LVL], gold_floor[MAX_LVL], gold_mon[MAX_LVL];
 
 
 typedef enum stat_code
@@ -324,7 +518,6 @@ static const struct stat_data stat_message[] =
 	{ST_9TH_BOOKS, " Book 9      "},	
 };	
 
-double stat_all[ST_END][3][MAX_LVL];
 	
 /* Values for things we want to find the level where it's
  * most likely to be first found */
@@ -379,44 +572,49 @@ static const struct stat_ff_data stat_ff_message[] =
 	{ST_FF_BOOK9,	ST_9TH_BOOKS,	"Book9  \t"},
 };
 
-int stat_ff_all[ST_FF_END][TRIES_SIZE];
-
+/**
+ * Everything stats_collect() accumulates.  Each worker fills in its own copy
+ * for its share of the iterations; the copies are summed at the end, so
+ * everything here has to be additive.
+ */
+struct item_stats {
+	double stat_all[ST_END][3][MAX_LVL];
 
+	/* Values for things we want to find the level where it's
+	 * most likely to be first found */
+	int stat_ff_all[ST_FF_END][TRIES_SIZE];
 
-/* basic artifact info */
-static double art_total[MAX_LVL], art_spec[MAX_LVL], art_norm[MAX_LVL];
+	/*** These are items to track for each iteration ***/
+	/* total number of artifacts found */
+	int art_it[TRIES_SIZE];
 
-/* artifact level info */
-static double art_shal[MAX_LVL], art_ave[MAX_LVL], art_ood[MAX_LVL];
+	/*** handle gold separately ***/
+	/* gold */
+	double gold_total[MAX_LVL], gold_floor[MAX_LVL], gold_mon[MAX_LVL];
 
-/* where normal artifacts come from */
-static double art_mon[MAX_LVL], art_uniq[MAX_LVL], art_floor[MAX_LVL], art_vault[MAX_LVL], art_mon_vault[MAX_LVL];
+	/* basic artifact info */
+	double art_total[MAX_LVL], art_spec[MAX_LVL], art_norm[MAX_LVL];
 
+	/* artifact level info */
+	double art_shal[MAX_LVL], art_ave[MAX_LVL], art_ood[MAX_LVL];
 
+	/* where normal artifacts come from */
+	double art_mon[MAX_LVL], art_uniq[MAX_LVL], art_floor[MAX_LVL],
+		art_vault[MAX_LVL], art_mon_vault[MAX_LVL];
 
-/* monster info */
-static double mon_total[MAX_LVL], mon_ood[MAX_LVL], mon_deadly[MAX_LVL];
+	/* monster info */
+	double mon_total[MAX_LVL], mon_ood[MAX_LVL], mon_deadly[MAX_LVL];
 
-/* unique info */
-static double uniq_total[MAX_LVL], uniq_ood[MAX_LVL], uniq_deadly[MAX_LVL];
+	/* unique info */
+	double uniq_total[MAX_LVL], uniq_ood[MAX_LVL], uniq_deadly[MAX_LVL];
+};
 
+static struct item_stats istats;
 
 /* set everything to 0.0 to begin */
 static void init_stat_vals(void)
 {
-	int i,j,k;
-
-	for (i = 0; i < ST_END;i++)
-		for (j = 0; j < 3; k = j++)
-			for (k = 0; k < MAX_LVL; k++)
-				stat_all[i][j][k] = 0.0;
-				
-	for (i = 1; i < TRIES_SIZE; i++)
-		art_it[i] = 0;
-	
-	for (i = 0; i < ST_FF_END; i++)
-		for (j = 0; j < TRIES_SIZE; j++)
-			stat_ff_all[i][j] = 0.0;
+	memset(&istats, 0, sizeof(istats));
 }
 
 /*
@@ -428,10 +626,10 @@ static bool first_find(stat_first_find st)
 	if (iter >= TRIES_SIZE) return false;
 
 	/* make sure we haven't found it earlier on this iteration */
-	if (stat_ff_all[st][iter] > 0) return false;
+	if (istats.stat_ff_all[st][iter] > 0) return false;
 
 	/* assign the depth to this value */
-	stat_ff_all[st][iter] = player->depth;
+	istats.stat_ff_all[st][iter] = player->depth;
 
 	/* success */
 	return true;
@@ -451,13 +649,13 @@ static void add_stats(stat_code st, bool vault, bool mon, int number)
 	if ((lvl > MAX_LVL) || (lvl < 0)) return;
 	
 	/* add to the total */
-	stat_all[st][0][lvl] += addval * number;
+	istats.stat_all[st][0][lvl] += addval * number;
 	
 	/* add to the total from vaults */
-	if ((!mon) && (vault)) stat_all[st][2][lvl] += addval * number;
+	if ((!mon) && (vault)) istats.stat_all[st][2][lvl] += addval * number;
 	
 	/* add to the total from monsters */
-	if (mon) stat_all[st][1][lvl] += addval * number;
+	if (mon) istats.stat_all[st][1][lvl] += addval * number;
 
 }	
 	
@@ -1018,10 +1216,10 @@ static void get_obj_data(const struct object *obj, int y, int x, bool mon,
 	if (obj->artifact){
 
 		/* add to artifact level total */
-		art_total[lvl] += addval;
+		istats.art_total[lvl] += addval;
 
 		/* add to the artifact iteration total */
-		if (iter < TRIES_SIZE) art_it[iter]++;
+		if (iter < TRIES_SIZE) istats.art_it[iter]++;
 
 		/* Obtain the artifact info */
 		art = obj->artifact;
@@ -1030,40 +1228,40 @@ static void get_obj_data(const struct object *obj, int y, int x, bool mon,
 		//msg_format("Found artifact %s",art->name);
 
 		/* artifact is shallow */
-		if (art->alloc_min < (player->depth - 20)) art_shal[lvl] += addval;
+		if (art->alloc_min < (player->depth - 20)) istats.art_shal[lvl] += addval;
 
 		/* artifact is close to the player depth */
 		if ((art->alloc_min >= player->depth - 20) &&
-			(art->alloc_min <= player->depth )) art_ave[lvl] += addval;
+			(art->alloc_min <= player->depth )) istats.art_ave[lvl] += addval;
 
 		/* artifact is out of depth */
-		if (art->alloc_min > (player->depth)) art_ood[lvl] += addval;
+		if (art->alloc_min > (player->depth)) istats.art_ood[lvl] += addval;
 
 		/* check to see if it's a special artifact */
 		if ((obj->tval == TV_LIGHT) || (obj->tval == TV_AMULET)
 			|| (obj->tval == TV_RING)){
 
 			/* increment special artifact counter */
-			art_spec[lvl] += addval;
+			istats.art_spec[lvl] += addval;
 		} else {
 			/* increment normal artifacts */
-			art_norm[lvl] += addval;
+			istats.art_norm[lvl] += addval;
 
 			/* did it come from a monster? */
-			if (mon) art_mon[lvl] += addval;
+			if (mon) istats.art_mon[lvl] += addval;
 
 			/* did it come from a unique? */
-			if (uniq) art_uniq[lvl] += addval;
+			if (uniq) istats.art_uniq[lvl] += addval;
 
 			/* was it in a vault? */
 			if (vault){
 
 				/* did a monster drop it ?*/
-				if ((mon) || (uniq)) art_mon_vault[lvl] += addval;
-				else art_vault[lvl] += addval;
+				if ((mon) || (uniq)) istats.art_mon_vault[lvl] += addval;
+				else istats.art_vault[lvl] += addval;
 			} else {
 				/* was it just lyin' on the floor? */
-				if ((!uniq) && (!mon)) art_floor[lvl] += addval;
+				if ((!uniq) && (!mon)) istats.art_floor[lvl] += addval;
 			}
 		}
 		/* preserve the artifact */
@@ -1075,11 +1273,11 @@ static void get_obj_data(const struct object *obj, int y, int x, bool mon,
 
 		int temp = obj->pval;
 		gold_temp = temp;
-	    gold_total[lvl] += (gold_temp / tries);
+	    istats.gold_total[lvl] += (gold_temp / tries);
 
 		/*From a monster? */
-		if ((mon) || (uniq)) gold_mon[lvl] += (gold_temp / tries);
-		else gold_floor[lvl] += (gold_temp / tries);
+		if ((mon) || (uniq)) istats.gold_mon[lvl] += (gold_temp / tries);
+		else istats.gold_floor[lvl] += (gold_temp / tries);
 	}
 
 }
@@ -1146,13 +1344,13 @@ static bool stats_monster(struct monster *mon, int i)
 
 
 	/* Increment monster count */
-	mon_total[lvl] += addval;
+	istats.mon_total[lvl] += addval;
 
 	/* Increment unique count if appropriate */
 	if (monster_is_unique(mon)) {
 
 		/* add to total */
-		uniq_total[lvl] += addval;
+		istats.uniq_total[lvl] += addval;
 
 		/* kill the unique if we're in clearing mode */
 		if (clearing) mon->race->max_num = 0;
@@ -1165,20 +1363,20 @@ static bool stats_monster(struct monster *mon, int i)
 	if ((mon->race->level > player->depth) && 
 		(mon->race->level <= player->depth + 10)) {
 
-			mon_ood[lvl] += addval;
+			istats.mon_ood[lvl] += addval;
 
 			if (monster_is_unique(mon))
-				uniq_ood[lvl] += addval;
+				istats.uniq_ood[lvl] += addval;
 	}
 
 
 	/* Is it deadly? */
 	if (mon->race->level > player->depth + 10){
 
-		mon_deadly[lvl] += addval;
+		istats.mon_deadly[lvl] += addval;
 
 		if (monster_is_unique(mon))
-			uniq_deadly[lvl] += addval;
+			istats.uniq_deadly[lvl] += addval;
 	}
 
 	/* Generate treasure */
@@ -1239,16 +1437,16 @@ static void print_stats(int lvl)
 
 	/* print gold info */
 	file_putf(stats_log," GOLD INFO \n");
-	file_putf(stats_log," Gold total: %f\n", gold_total[lvl]);
-	file_putf(stats_log," Gold monster: %f\n", gold_mon[lvl]);
-	file_putf(stats_log," Gold floor: %f\n", gold_floor[lvl]);
+	file_putf(stats_log," Gold total: %f\n", istats.gold_total[lvl]);
+	file_putf(stats_log," Gold monster: %f\n", istats.gold_mon[lvl]);
+	file_putf(stats_log," Gold floor: %f\n", istats.gold_floor[lvl]);
 
 	/* print monster heading */
 	file_putf(stats_log," MONSTER INFO \n");
 	file_putf(stats_log," Total monsters: %f OOD: %f Deadly: %f \n",
-				mon_total[lvl], mon_ood[lvl], mon_deadly[lvl]);
+				istats.mon_total[lvl], istats.mon_ood[lvl], istats.mon_deadly[lvl]);
 	file_putf(stats_log," Unique monsters: %f OOD: %f Deadly: %f \n",
-				uniq_total[lvl], uniq_ood[lvl], uniq_deadly[lvl]);
+				istats.uniq_total[lvl], istats.uniq_ood[lvl], istats.uniq_deadly[lvl]);
 	/* print artifact heading */
 
 	
@@ -1257,21 +1455,21 @@ static void print_stats(int lvl)
 
 	/* basic artifact info */
 	file_putf(stats_log,"Total artifacts: %f  Special artifacts: %f  Weapons/armor: %f \n",
-		art_total[lvl], art_spec[lvl], art_norm[lvl]);
+		istats.art_total[lvl], istats.art_spec[lvl], istats.art_norm[lvl]);
 
 	/* artifact depth info */
 	file_putf(stats_log,"Shallow: %f  Average: %f  Ood: %f \n",
-		art_shal[lvl],art_ave[lvl],art_ood[lvl]);
+		istats.art_shal[lvl],istats.art_ave[lvl],istats.art_ood[lvl]);
 		
 	/* more advanced info */
 	file_putf(stats_log,"From vaults: %f  From floor (no vault): %f \n",
-		art_vault[lvl],art_floor[lvl]);
+		istats.art_vault[lvl],istats.art_floor[lvl]);
 	file_putf(stats_log,"Uniques: %f  Monsters: %f  Vault denizens: %f \n",
-		art_uniq[lvl], art_mon[lvl], art_mon_vault[lvl]);
+		istats.art_uniq[lvl], istats.art_mon[lvl], istats.art_mon_vault[lvl]);
 
 		
 	for (i=ST_BEGIN; i<ST_END; i++){	
-		file_putf(stats_log, "%s%f From Monsters: %f In Vaults: %f \n",	stat_message[i].name, stat_all[i][0][lvl], stat_all[i][1][lvl], stat_all[i][2][lvl]);
+		file_putf(stats_log, "%s%f From Monsters: %f In Vaults: %f \n",	stat_message[i].name, istats.stat_all[i][0][lvl], istats.stat_all[i][1][lvl], istats.stat_all[i][2][lvl]);
 	}	
 
 
@@ -1374,19 +1572,19 @@ static void post_process_stats(void)
 	
 	for (i = 1; i < ST_FF_END; i++) {
 			file_putf(stats_log, "%s", stat_ff_message[i].name);
-			prob_of_find(stat_all[stat_ff_message[i].st][0]);
-			mean_and_stdv(stat_ff_all[i]);
+			prob_of_find(istats.stat_all[stat_ff_message[i].st][0]);
+			mean_and_stdv(istats.stat_ff_all[i]);
 	}
 
 	/* Print artifact total */
 	arttot = 0;
 
 	for (k = 0; k < MAX_LVL; k++)
-		arttot += art_total[k];
+		arttot += istats.art_total[k];
 
 	file_putf(stats_log,"\n");
 	file_putf(stats_log,"Total number of artifacts found %f \n",arttot);
-	mean_and_stdv(art_it);
+	mean_and_stdv(istats.art_it);
 
 	/* Temporary stuff goes here */
 	/* Dungeon book totals for Eddie
@@ -1490,10 +1688,10 @@ static void revive_uniques(void)
 }
 
 /**
- * This function loops through the level and does N iterations of
- * the stat calling function, assuming diving style.
+ * This function loops through the level and does iterations first to
+ * first + count - 1 of the stat calling function, assuming diving style.
  */ 
-static void diving_stats(void)
+static void diving_stats(int first, int count)
 {
 	int depth;
 
@@ -1503,27 +1701,21 @@ static void diving_stats(void)
 		if (player->depth == 0) player->depth = 1;
 
 		/* Do many iterations of each level */
-		for (iter = 0; iter < tries; iter++)
+		for (iter = first; iter < first + count; iter++)
 		     stats_collect_level();
-
-		/* Print the output to the file */
-		print_stats(depth);
-
-		/* Show the level to check on status */
-		do_cmd_redraw();
 	}
 }
 
 /**
- * This function loops through the level and does N iterations of
- * the stat calling function, assuming clearing style.
+ * This function loops through the level and does iterations first to
+ * first + count - 1 of the stat calling function, assuming clearing style.
  */ 
-static void clearing_stats(void)
+static void clearing_stats(int first, int count)
 {
 	int depth;
 
 	/* Do many iterations of the game */
-	for (iter = 0; iter < tries; iter++) {
+	for (iter = first; iter < first + count; iter++) {
 		/* Move all artifacts to uncreated */
 		uncreate_all_artifacts();
 
@@ -1559,32 +1751,100 @@ static void clearing_stats(void)
 			msg_format("Finished level %d,depth"); */
 		}
 
-		msg("Iteration %d complete",iter);
+		if (!stats_in_worker) msg("Iteration %d complete",iter);
 	}
+}
 
-	/* Restore original artifacts */
-	if (regen) {
-		cleanup_parser(&randart_parser);
-		if (OPT(player, birth_randarts)) {
-			activate_randart_file();
-			run_parser(&randart_parser);
-			deactivate_randart_file();
-		} else {
-			run_parser(&artifact_parser);
-		}
+/**
+ * The item statistics live in istats, which the collection code fills in
+ * directly; acc is always &istats there.
+ */
+static void item_stats_run(void *acc, int worker, int first, int count)
+{
+	assert(acc == &istats);
+	if (clearing) {
+		clearing_stats(first, count);
+	} else {
+		diving_stats(first, count);
 	}
+}
 
-	/* Print to file */
-	for (depth = 0 ;depth < MAX_LVL; depth++)
-		print_stats(depth);
+static void *item_stats_new(const void *acc)
+{
+	return mem_zalloc(sizeof(struct item_stats));
+}
 
-	/* Post processing */
-	post_process_stats();
+static void item_stats_free(void *acc)
+{
+	mem_free(acc);
+}
 
-	/* Display the current level */
-	do_cmd_redraw(); 
+static void item_stats_transfer(void *acc, struct stats_pipe *p)
+{
+	stats_transfer(p, acc, sizeof(struct item_stats));
+}
+
+static void add_double_array(double *to, const double *from, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++) to[i] += from[i];
+}
+
+static void add_int_array(int *to, const int *from, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++) to[i] += from[i];
+}
+
+static void item_stats_merge(void *acc, const void *from)
+{
+	struct item_stats *to = acc;
+	const struct item_stats *f = from;
+	int i;
+
+	for (i = 0; i < ST_END; i++) {
+		add_double_array(to->stat_all[i][0], f->stat_all[i][0], MAX_LVL);
+		add_double_array(to->stat_all[i][1], f->stat_all[i][1], MAX_LVL);
+		add_double_array(to->stat_all[i][2], f->stat_all[i][2], MAX_LVL);
+	}
+	/* Workers have disjoint iterations, so these just fill in */
+	for (i = 0; i < ST_FF_END; i++) {
+		add_int_array(to->stat_ff_all[i], f->stat_ff_all[i], TRIES_SIZE);
+	}
+	add_int_array(to->art_it, f->art_it, TRIES_SIZE);
+
+	add_double_array(to->gold_total, f->gold_total, MAX_LVL);
+	add_double_array(to->gold_floor, f->gold_floor, MAX_LVL);
+	add_double_array(to->gold_mon, f->gold_mon, MAX_LVL);
+	add_double_array(to->art_total, f->art_total, MAX_LVL);
+	add_double_array(to->art_spec, f->art_spec, MAX_LVL);
+	add_double_array(to->art_norm, f->art_norm, MAX_LVL);
+	add_double_array(to->art_shal, f->art_shal, MAX_LVL);
+	add_double_array(to->art_ave, f->art_ave, MAX_LVL);
+	add_double_array(to->art_ood, f->art_ood, MAX_LVL);
+	add_double_array(to->art_mon, f->art_mon, MAX_LVL);
+	add_double_array(to->art_uniq, f->art_uniq, MAX_LVL);
+	add_double_array(to->art_floor, f->art_floor, MAX_LVL);
+	add_double_array(to->art_vault, f->art_vault, MAX_LVL);
+	add_double_array(to->art_mon_vault, f->art_mon_vault, MAX_LVL);
+	add_double_array(to->mon_total, f->mon_total, MAX_LVL);
+	add_double_array(to->mon_ood, f->mon_ood, MAX_LVL);
+	add_double_array(to->mon_deadly, f->mon_deadly, MAX_LVL);
+	add_double_array(to->uniq_total, f->uniq_total, MAX_LVL);
+	add_double_array(to->uniq_ood, f->uniq_ood, MAX_LVL);
+	add_double_array(to->uniq_deadly, f->uniq_deadly, MAX_LVL);
 }
 
+static const struct stats_collector item_stats_collector = {
+	item_stats_run,
+	item_stats_new,
+	item_stats_free,
+	item_stats_transfer,
+	item_stats_merge
+};
+
 /**
  * Check whether statistic collection is enabled.  Prints a message if it is
  * not.
@@ -1657,11 +1917,40 @@ void stats_collect(int nsim, int simtype)
 	/* Make sure all stats are 0 */
 	init_stat_vals();
 
-	/* Select diving option */
-	if (!clearing) diving_stats();
+	/* Run the simulations */
+	stats_run(&item_stats_collector, &istats, tries);
 
-	/* Select clearing option */
-	if (clearing) clearing_stats();
+	if (clearing) {
+		int depth;
+
+		/* Restore original artifacts */
+		if (regen) {
+			cleanup_parser(&randart_parser);
+			if (OPT(player, birth_randarts)) {
+				activate_randart_file();
+				run_parser(&randart_parser);
+				deactivate_randart_file();
+			} else {
+				run_parser(&artifact_parser);
+			}
+		}
+
+		/* Print to file */
+		for (depth = 0 ;depth < MAX_LVL; depth++)
+			print_stats(depth);
+
+		/* Post processing */
+		post_process_stats();
+	} else {
+		int depth;
+
+		/* Print the output to the file */
+		for (depth = 0; depth < MAX_LVL; depth += 5)
+			print_stats(depth);
+	}
+
+	/* Display the current level */
+	do_cmd_redraw();
 
 	/* Turn auto-more back off */
 	if (auto_flag) option_set(option_name(OPT_auto_more), false);
@@ -1774,6 +2063,101 @@ static void calc_cave_distances(int **cave_dist)
 	mem_free(ogrids);
 }
 
+/**
+ * What pit_stats() accumulates:  hist[(depth - depth_min) * pit_max + i] is
+ * the number of times the ith pit profile was chosen at that depth.
+ */
+struct pit_acc {
+	unsigned long *hist;
+	int pittype, depth_min, depth_max;
+};
+
+static void pit_run(void *acc, int worker, int first, int count)
+{
+	struct pit_acc *pa = acc;
+	int depth;
+
+	for (depth = pa->depth_min; depth <= pa->depth_max; ++depth) {
+		unsigned long *hist = pa->hist
+			+ (depth - pa->depth_min) * z_info->pit_max;
+		int j;
+
+		for (j = 0; j < count; j++) {
+			int i;
+			int pit_idx = 0;
+			int pit_dist = 999;
+
+			for (i = 0; i < z_info->pit_max; i++) {
+				int offset, dist;
+				const struct pit_profile *pit = &pit_info[i];
+
+				if (!pit->name || pit->room_type != pa->pittype) {
+					continue;
+				}
+
+				offset = Rand_normal(pit->ave, 10);
+				dist = ABS(offset - depth);
+
+				if (dist < pit_dist && one_in_(pit->rarity)) {
+					pit_idx = i;
+					pit_dist = dist;
+				}
+			}
+
+			hist[pit_idx]++;
+		}
+	}
+}
+
+static size_t pit_hist_size(const struct pit_acc *pa)
+{
+	return (pa->depth_max - pa->depth_min + 1) * z_info->pit_max
+		* sizeof(*pa->hist);
+}
+
+static void *pit_new(const void *acc)
+{
+	struct pit_acc *pa = mem_zalloc(sizeof(*pa));
+
+	*pa = *(const struct pit_acc*) acc;
+	pa->hist = mem_zalloc(pit_hist_size(pa));
+	return pa;
+}
+
+static void pit_free(void *acc)
+{
+	struct pit_acc *pa = acc;
+
+	mem_free(pa->hist);
+	mem_free(pa);
+}
+
+static void pit_transfer(void *acc, struct stats_pipe *p)
+{
+	struct pit_acc *pa = acc;
+
+	stats_transfer(p, pa->hist, pit_hist_size(pa));
+}
+
+static void pit_merge(void *acc, const void *from)
+{
+	struct pit_acc *pa = acc;
+	const struct pit_acc *f = from;
+	size_t i, n = pit_hist_size(pa) / sizeof(*pa->hist);
+
+	for (i = 0; i < n; i++) {
+		pa->hist[i] += f->hist[i];
+	}
+}
+
+static const struct stats_collector pit_collector = {
+	pit_run,
+	pit_new,
+	pit_free,
+	pit_transfer,
+	pit_merge
+};
+
 /**
  * Generate several pits and collect statistics about the type of inhabitants.
  *
@@ -1787,15 +2171,20 @@ static void calc_cave_distances(int **cave_dist)
  */
 void pit_stats(int nsim, int pittype, int depth_min, int depth_max)
 {
-	unsigned long *hist;
+	struct pit_acc pa;
 	unsigned long *sum_hist;
 	const char *file_part;
 	char path[1024];
 	ang_file *pitfile;
 	int depth, p;
 
+	if (depth_max < depth_min) return;
+
 	/* Initialize hist */
-	hist = mem_alloc(z_info->pit_max * sizeof(*hist));
+	pa.pittype = pittype;
+	pa.depth_min = depth_min;
+	pa.depth_max = depth_max;
+	pa.hist = mem_zalloc(pit_hist_size(&pa));
 	if (depth_min < depth_max) {
 		sum_hist = mem_zalloc(z_info->pit_max * sizeof(*sum_hist));
 	} else {
@@ -1858,37 +2247,11 @@ void pit_stats(int nsim, int pittype, int depth_min, int depth_max)
 		pitfile = NULL;
 	}
 
-	for (depth = depth_min; depth <= depth_max; ++depth) {
-		int j;
-
-		for (p = 0; p < z_info->pit_max; ++p) {
-			hist[p] = 0;
-		}
-
-		for (j = 0; j < nsim; j++) {
-			int i;
-			int pit_idx = 0;
-			int pit_dist = 999;
-
-			for (i = 0; i < z_info->pit_max; i++) {
-				int offset, dist;
-				const struct pit_profile *pit = &pit_info[i];
-
-				if (!pit->name || pit->room_type != pittype) {
-					continue;
-				}
+	stats_run(&pit_collector, &pa, nsim);
 
-				offset = Rand_normal(pit->ave, 10);
-				dist = ABS(offset - depth);
-
-				if (dist < pit_dist && one_in_(pit->rarity)) {
-					pit_idx = i;
-					pit_dist = dist;
-				}
-			}
-
-			hist[pit_idx]++;
-		}
+	for (depth = depth_min; depth <= depth_max; ++depth) {
+		const unsigned long *hist = pa.hist
+			+ (depth - depth_min) * z_info->pit_max;
 
 		if (pitfile) {
 			(void)file_putf(pitfile, "%d", depth);
@@ -1915,7 +2278,7 @@ void pit_stats(int nsim, int pittype, int depth_min, int depth_max)
 
 		if (pit->name) {
 			msg("Type %s: %lu.", pit->name, (sum_hist) ?
-				sum_hist[p] : hist[p]);
+				sum_hist[p] : pa.hist[p]);
 		}
 	}
 
@@ -1940,7 +2303,7 @@ void pit_stats(int nsim, int pittype, int depth_min, int depth_max)
 	if (sum_hist) {
 		mem_free(sum_hist);
 	}
-	mem_free(hist);
+	mem_free(pa.hist);
 
 	return;
 }
@@ -2068,6 +2431,27 @@ static void dump_covar_var(const struct covar_n *cv, ang_file* fo)
 	}
 }
 
+static void merge_covar(struct covar_n *cv, const struct covar_n *from)
+{
+	int i;
+
+	assert(cv->n == from->n);
+	for (i = 0; i < cv->n; ++i) {
+		cv->s[i] += from->s[i];
+	}
+	for (i = 0; i < (cv->n * (cv->n + 1)) / 2; ++i) {
+		cv->c[i] += from->c[i];
+	}
+	cv->count += from->count;
+}
+
+static void transfer_covar(struct covar_n *cv, struct stats_pipe *p)
+{
+	stats_transfer(p, cv->s, cv->n * sizeof(*cv->s));
+	stats_transfer(p, cv->c, ((cv->n * (cv->n + 1)) / 2) * sizeof(*cv->c));
+	stats_transfer(p, &cv->count, sizeof(cv->count));
+}
+
 /* Assumes the count of terms in the sum is maintained elsewhere. */
 struct i_sum_sum2 {
 	uint32_t sum, sum2_lo, sum2_hi;
@@ -2094,6 +2478,16 @@ static double stddev_i_sum_sum2(struct i_sum_sum2 s, int count)
 	return (var > 0.0) ? sqrt(var / (count - 1)) : 0.0;
 }
 
+static void merge_i_sum_sum2(struct i_sum_sum2 *s, const struct i_sum_sum2 *from)
+{
+	s->sum += from->sum;
+	if (from->sum2_lo > 4294967295UL - s->sum2_lo) {
+		++s->sum2_hi;
+	}
+	s->sum2_lo += from->sum2_lo;
+	s->sum2_hi += from->sum2_hi;
+}
+
 /* Assumes the count of terms in the sum is maintained elsewhere. */
 struct d_sum_sum2 {
 	double sum, sum2;
@@ -2120,6 +2514,12 @@ static double stddev_d_sum_sum2(struct d_sum_sum2 s, int count)
 	return (var > 0.0) ? sqrt(var / (count - 1)) : 0.0;
 }
 
+static void merge_d_sum_sum2(struct d_sum_sum2 *s, const struct d_sum_sum2 *from)
+{
+	s->sum += from->sum;
+	s->sum2 += from->sum2;
+}
+
 struct tunnel_aggregate {
 	/*
 	 * Hold the sums for the normalized number of steps, number of
@@ -2217,6 +2617,30 @@ static void add_to_tunnel_aggregate(struct tunnel_aggregate *ta,
 	}
 }
 
+static void merge_tunnel_aggregate(struct tunnel_aggregate *ta,
+		const struct tunnel_aggregate *from)
+{
+	merge_covar(&ta->cv_all, &from->cv_all);
+	merge_covar(&ta->cv_early, &from->cv_early);
+	merge_covar(&ta->cv_noearly, &from->cv_noearly);
+	merge_covar(&ta->cv_fail, &from->cv_fail);
+	merge_covar(&ta->cv_success, &from->cv_success);
+	merge_d_sum_sum2(&ta->early_frac, &from->early_frac);
+	merge_d_sum_sum2(&ta->success_frac, &from->success_frac);
+}
+
+static void transfer_tunnel_aggregate(struct tunnel_aggregate *ta,
+		struct stats_pipe *p)
+{
+	transfer_covar(&ta->cv_all, p);
+	transfer_covar(&ta->cv_early, p);
+	transfer_covar(&ta->cv_noearly, p);
+	transfer_covar(&ta->cv_fail, p);
+	transfer_covar(&ta->cv_success, p);
+	stats_transfer(p, &ta->early_frac, sizeof(ta->early_frac));
+	stats_transfer(p, &ta->success_frac, sizeof(ta->success_frac));
+}
+
 struct grid_count_aggregate {
 	/*
 	 * For everything but the stairs, accumulate the counts normalized by
@@ -2304,6 +2728,42 @@ static void add_to_grid_count_aggregate(struct grid_count_aggregate *ga,
 	}
 }
 
+static void merge_grid_count_aggregate(struct grid_count_aggregate *ga,
+		const struct grid_count_aggregate *from)
+{
+	int i;
+
+	merge_d_sum_sum2(&ga->floor, &from->floor);
+	merge_i_sum_sum2(&ga->upstair, &from->upstair);
+	merge_i_sum_sum2(&ga->downstair, &from->downstair);
+	merge_d_sum_sum2(&ga->trap, &from->trap);
+	merge_d_sum_sum2(&ga->lava, &from->lava);
+	merge_d_sum_sum2(&ga->impass_rubble, &from->impass_rubble);
+	merge_d_sum_sum2(&ga->pass_rubble, &from->pass_rubble);
+	merge_d_sum_sum2(&ga->magma_treasure, &from->magma_treasure);
+	merge_d_sum_sum2(&ga->quartz_treasure, &from->quartz_treasure);
+	merge_d_sum_sum2(&ga->open_door, &from->open_door);
+	merge_d_sum_sum2(&ga->closed_door, &from->closed_door);
+	merge_d_sum_sum2(&ga->broken_door, &from->broken_door);
+	merge_d_sum_sum2(&ga->secret_door, &from->secret_door);
+	for (i = 0; i < 9; ++i) {
+		merge_d_sum_sum2(&ga->traversable_neighbor_histogram[i],
+			&from->traversable_neighbor_histogram[i]);
+	}
+}
+
+/*
+ * A distinct reason for failed attempts at one type of level, with the
+ * number of attempts that failed for it; fixed size so the list can be
+ * passed between workers as is.
+ */
+#define CGEN_REASON_MAX 32
+struct cgen_reason {
+	char text[80];
+	int level_type;
+	uint32_t count;
+};
+
 struct cgen_stats {
 	/*
 	 * This is effectively a 2 x z_info->profile_max array where
@@ -2363,6 +2823,23 @@ struct cgen_stats {
 	 * player is disconnected from all down staircases.
 	 */
 	uint32_t *disdstair_counts;
+	/*
+	 * attempt_counts[0][i] is the number of successful attempts reported
+	 * for the ith level type; attempt_counts[1][i] is the number of
+	 * failed ones.
+	 */
+	uint32_t *attempt_counts[2];
+	/*
+	 * attempt_usec[0][i] and attempt_grids[0][i] are the total processor
+	 * time, in microseconds, and the total grids allocated for successful
+	 * attempts at the ith level type; attempt_usec[1][i] and
+	 * attempt_grids[1][i] are the same for failed attempts.
+	 */
+	double *attempt_usec[2];
+	double *attempt_grids[2];
+	/* Are the reasons for failed attempts, n_reasons of them. */
+	struct cgen_reason reasons[CGEN_REASON_MAX];
+	int n_reasons;
 	/* Is the number of successfully generated levels. */
 	int nsuccess;
 	/* Is the number of failed levels. */
@@ -2500,6 +2977,48 @@ static void cgenstat_handle_tunnel(game_event_type et, game_event_data *ed,
 	++gs->n_curr_tunn;
 }
 
+/**
+ * Count a failure reason for a level type, ignoring it if the list is full.
+ */
+static void add_cgen_reason(struct cgen_stats *gs, const char *text,
+		int level_type, uint32_t count)
+{
+	int i;
+
+	for (i = 0; i < gs->n_reasons; ++i) {
+		if (gs->reasons[i].level_type == level_type
+				&& streq(gs->reasons[i].text, text)) {
+			gs->reasons[i].count += count;
+			return;
+		}
+	}
+	if (gs->n_reasons < CGEN_REASON_MAX) {
+		struct cgen_reason *r = &gs->reasons[gs->n_reasons++];
+
+		my_strcpy(r->text, text, sizeof(r->text));
+		r->level_type = level_type;
+		r->count = count;
+	}
+}
+
+static void cgenstat_handle_attempt(game_event_type et, game_event_data *ed,
+		void *ud)
+{
+	struct cgen_stats *gs;
+	int failed;
+
+	assert(et == EVENT_GEN_LEVEL_ATTEMPT && ud);
+	gs = (struct cgen_stats*) ud;
+	assert(gs->level_type >= 0 && gs->level_type < z_info->profile_max);
+	failed = (ed->attempt.reason) ? 1 : 0;
+	gs->attempt_counts[failed][gs->level_type]++;
+	gs->attempt_usec[failed][gs->level_type] += ed->attempt.usec;
+	gs->attempt_grids[failed][gs->level_type] += ed->attempt.grids;
+	if (failed) {
+		add_cgen_reason(gs, ed->attempt.reason, gs->level_type, 1);
+	}
+}
+
 static void initialize_generation_stats(struct cgen_stats *gs)
 {
 	int i;
@@ -2557,17 +3076,32 @@ static void initialize_generation_stats(struct cgen_stats *gs)
 	gs->disdstair_counts = mem_zalloc(z_info->profile_max *
 		sizeof(*gs->disdstair_counts));
 
+	for (i = 0; i < 2; ++i) {
+		gs->attempt_counts[i] = mem_zalloc(z_info->profile_max *
+			sizeof(*gs->attempt_counts[i]));
+		gs->attempt_usec[i] = mem_zalloc(z_info->profile_max *
+			sizeof(*gs->attempt_usec[i]));
+		gs->attempt_grids[i] = mem_zalloc(z_info->profile_max *
+			sizeof(*gs->attempt_grids[i]));
+	}
+	gs->n_reasons = 0;
+}
+
+/**
+ * Have gs collect the results from level generation.
+ */
+static void watch_generation_stats(struct cgen_stats *gs)
+{
 	event_add_handler(EVENT_GEN_LEVEL_START, cgenstat_handle_new_level, gs);
 	event_add_handler(EVENT_GEN_LEVEL_END, cgenstat_handle_level_end, gs);
 	event_add_handler(EVENT_GEN_ROOM_START, cgenstat_handle_new_room, gs);
 	event_add_handler(EVENT_GEN_ROOM_END, cgenstat_handle_room_end, gs);
 	event_add_handler(EVENT_GEN_TUNNEL_FINISHED, cgenstat_handle_tunnel, gs);
+	event_add_handler(EVENT_GEN_LEVEL_ATTEMPT, cgenstat_handle_attempt, gs);
 }
 
-static void cleanup_generation_stats(struct cgen_stats *gs)
+static void unwatch_generation_stats(struct cgen_stats *gs)
 {
-	int i;
-
 	event_remove_handler(EVENT_GEN_LEVEL_START,
 		cgenstat_handle_new_level, gs);
 	event_remove_handler(EVENT_GEN_LEVEL_END,
@@ -2578,6 +3112,19 @@ static void cleanup_generation_stats(struct cgen_stats *gs)
 		cgenstat_handle_room_end, gs);
 	event_remove_handler(EVENT_GEN_TUNNEL_FINISHED,
 		cgenstat_handle_tunnel, gs);
+	event_remove_handler(EVENT_GEN_LEVEL_ATTEMPT,
+		cgenstat_handle_attempt, gs);
+}
+
+static void cleanup_generation_stats(struct cgen_stats *gs)
+{
+	int i;
+
+	for (i = 0; i < 2; ++i) {
+		mem_free(gs->attempt_grids[i]);
+		mem_free(gs->attempt_usec[i]);
+		mem_free(gs->attempt_counts[i]);
+	}
 
 	mem_free(gs->disdstair_counts);
 	mem_free(gs->disarea_counts);
@@ -2611,6 +3158,100 @@ static void cleanup_generation_stats(struct cgen_stats *gs)
 	mem_free(gs->level_counts[0]);
 }
 
+/**
+ * Add the totals in from to gs; the scratch space for the current level
+ * is left alone.
+ */
+static void merge_generation_stats(struct cgen_stats *gs,
+		const struct cgen_stats *from)
+{
+	int i, j;
+
+	assert(gs->room_type_count == from->room_type_count);
+	for (i = 0; i < z_info->profile_max; ++i) {
+		gs->level_counts[0][i] += from->level_counts[0][i];
+		gs->level_counts[1][i] += from->level_counts[1][i];
+		merge_i_sum_sum2(&gs->total_rooms[i], &from->total_rooms[i]);
+		for (j = 0; j < gs->room_type_count; ++j) {
+			merge_i_sum_sum2(&gs->room_counts[i][0][j],
+				&from->room_counts[i][0][j]);
+			merge_i_sum_sum2(&gs->room_counts[i][1][j],
+				&from->room_counts[i][1][j]);
+		}
+		merge_tunnel_aggregate(&gs->ta[i], &from->ta[i]);
+		for (j = 0; j < 3; ++j) {
+			merge_grid_count_aggregate(&gs->ga[i][j],
+				&from->ga[i][j]);
+		}
+		gs->badst_counts[i] += from->badst_counts[i];
+		gs->disarea_counts[i] += from->disarea_counts[i];
+		gs->disdstair_counts[i] += from->disdstair_counts[i];
+		for (j = 0; j < 2; ++j) {
+			gs->attempt_counts[j][i] += from->attempt_counts[j][i];
+			gs->attempt_usec[j][i] += from->attempt_usec[j][i];
+			gs->attempt_grids[j][i] += from->attempt_grids[j][i];
+		}
+	}
+	for (i = 0; i < from->n_reasons; ++i) {
+		add_cgen_reason(gs, from->reasons[i].text,
+			from->reasons[i].level_type, from->reasons[i].count);
+	}
+	gs->nsuccess += from->nsuccess;
+	gs->nfail += from->nfail;
+}
+
+static void transfer_generation_stats(struct cgen_stats *gs,
+		struct stats_pipe *p)
+{
+	size_t n = z_info->profile_max;
+	int i;
+
+	stats_transfer(p, gs->level_counts[0], n * sizeof(*gs->level_counts[0]));
+	stats_transfer(p, gs->level_counts[1], n * sizeof(*gs->level_counts[1]));
+	stats_transfer(p, gs->total_rooms, n * sizeof(*gs->total_rooms));
+	for (i = 0; i < z_info->profile_max; ++i) {
+		stats_transfer(p, gs->room_counts[i][0], gs->room_type_count
+			* sizeof(*gs->room_counts[i][0]));
+		stats_transfer(p, gs->room_counts[i][1], gs->room_type_count
+			* sizeof(*gs->room_counts[i][1]));
+		transfer_tunnel_aggregate(&gs->ta[i], p);
+		stats_transfer(p, gs->ga[i], 3 * sizeof(*gs->ga[i]));
+	}
+	stats_transfer(p, gs->badst_counts, n * sizeof(*gs->badst_counts));
+	stats_transfer(p, gs->disarea_counts, n * sizeof(*gs->disarea_counts));
+	stats_transfer(p, gs->disdstair_counts,
+		n * sizeof(*gs->disdstair_counts));
+	for (i = 0; i < 2; ++i) {
+		stats_transfer(p, gs->attempt_counts[i],
+			n * sizeof(*gs->attempt_counts[i]));
+		stats_transfer(p, gs->attempt_usec[i],
+			n * sizeof(*gs->attempt_usec[i]));
+		stats_transfer(p, gs->attempt_grids[i],
+			n * sizeof(*gs->attempt_grids[i]));
+	}
+	stats_transfer(p, gs->reasons, sizeof(gs->reasons));
+	stats_transfer(p, &gs->n_reasons, sizeof(gs->n_reasons));
+	stats_transfer(p, &gs->nsuccess, sizeof(gs->nsuccess));
+	stats_transfer(p, &gs->nfail, sizeof(gs->nfail));
+}
+
+/**
+ * Check that every level that was built or given up on sent one attempt
+ * report, which would not hold if a worker lost its attempt handler.
+ */
+static bool generation_attempts_agree(const struct cgen_stats *gs)
+{
+	unsigned long nok = 0, nbad = 0, nfailed = 0;
+	int i;
+
+	for (i = 0; i < z_info->profile_max; ++i) {
+		nok += gs->attempt_counts[0][i];
+		nbad += gs->attempt_counts[1][i];
+		nfailed += gs->level_counts[1][i];
+	}
+	return nok == (unsigned long) gs->nsuccess && nbad == nfailed;
+}
+
 static void dump_generation_stats(ang_file *fo, const struct cgen_stats *gs)
 {
 	int i;
@@ -2628,6 +3269,34 @@ static void dump_generation_stats(ang_file *fo, const struct cgen_stats *gs)
 	}
 	file_put(fo, "\n");
 
+	file_put(fo, "Level Builder Attempts (successful count, average processor time in microseconds and grids allocated; failed count, average time and grids)::\n");
+	for (i = 0; i < z_info->profile_max; ++i) {
+		uint32_t nok = gs->attempt_counts[0][i];
+		uint32_t nbad = gs->attempt_counts[1][i];
+
+		file_putf(fo, "\"%s\"\t%lu\t%.1f\t%.1f\t%lu\t%.1f\t%.1f\n",
+			get_level_profile_name_from_index(i),
+			(unsigned long) nok,
+			(nok) ? gs->attempt_usec[0][i] / nok : 0.0,
+			(nok) ? gs->attempt_grids[0][i] / nok : 0.0,
+			(unsigned long) nbad,
+			(nbad) ? gs->attempt_usec[1][i] / nbad : 0.0,
+			(nbad) ? gs->attempt_grids[1][i] / nbad : 0.0);
+	}
+	if (!generation_attempts_agree(gs)) {
+		file_put(fo, "Warning: the attempt reports do not match the levels built and failed.\n");
+	}
+	file_put(fo, "\n");
+
+	file_put(fo, "Reasons for Failed Attempts by Level Type::\n");
+	for (i = 0; i < gs->n_reasons; ++i) {
+		file_putf(fo, "\"%s\"\t\"%s\"\t%lu\n",
+			get_level_profile_name_from_index(
+			gs->reasons[i].level_type), gs->reasons[i].text,
+			(unsigned long) gs->reasons[i].count);
+	}
+	file_put(fo, "\n");
+
 	file_put(fo, "Average and Std. Deviation of Room Counts by Level Type::\n");
 	for (i = 0; i < z_info->profile_max; ++i) {
 		file_putf(fo, "\"%s\"\t%.4f\t%.4f\n",
@@ -2881,193 +3550,322 @@ static void dump_generation_stats(ang_file *fo, const struct cgen_stats *gs)
 }
 
 /**
- * Gather whether the dungeon has disconnects in it and whether the player
- * is disconnected from the stairs
+ * What disconnect_stats() accumulates.
  */
-void disconnect_stats(int nsim, bool stop_on_disconnect)
-{
-	int i, y, x;
-	int **cave_dist;
-	long bad_starts = 0, dsc_area = 0, dsc_from_stairs = 0;
-	char path[1024];
-	ang_file *disfile;
+struct disconnect_acc {
 	struct cgen_stats gs;
-	ang_file *gstfile;
+	long bad_starts, dsc_area, dsc_from_stairs;
+	/* Where to dump the problem levels; not part of the results */
+	ang_file *disfile;
+	bool stop_on_disconnect;
+};
 
-	path_build(path, sizeof(path), ANGBAND_DIR_USER, "disconnect.html");
-	disfile = file_open(path, MODE_WRITE, FTYPE_TEXT);
-	if (disfile) {
-		dump_level_header(disfile, "Disconnected Levels");
-	}
+static void disconnect_part_path(char *buf, size_t len, int worker)
+{
+	char part[32];
 
-	path_build(path, sizeof(path), ANGBAND_DIR_USER,
-		"disconnect_gstat.txt");
-	gstfile = file_open(path, MODE_WRITE, FTYPE_TEXT);
+	strnfmt(part, sizeof(part), "disconnect-%d.part", worker);
+	path_build(buf, len, ANGBAND_DIR_USER, part);
+}
+
+/**
+ * Generate one level and check it for disconnects.  Return true if it had
+ * a problem.
+ */
+static bool disconnect_level(struct disconnect_acc *da)
+{
+	struct cgen_stats *gs = &da->gs;
+	int y, x;
+	int **cave_dist;
+	/* Assume no disconnected areas */
+	bool has_dsc = false;
+	/* Assume you can't get to the down staircase */
+	bool has_dsc_from_stairs = true;
+	bool has_bad_start, use_stairs;
 
 	/*
-	 * Set up to collect some statistics about level types, room types,
-	 * and tunneling as well.
+	 * 50% of the time act as if came in via a down staircase;
+	 * otherwise come in as if by word of recall/trap door/teleport
+	 * level.
 	 */
-	initialize_generation_stats(&gs);
+	if (one_in_(2)) {
+		player->upkeep->create_up_stair = true;
+		player->upkeep->create_down_stair = false;
+		use_stairs = OPT(player, birth_connect_stairs);
+	} else {
+		use_stairs = false;
+	}
 
-	for (i = 1; i <= nsim; i++) {
-		/* Assume no disconnected areas */
-		bool has_dsc = false;
-		/* Assume you can't get to the down staircase */
-		bool has_dsc_from_stairs = true;
-		bool has_bad_start, use_stairs;
+	/* Make a new cave */
+	prepare_next_level(player);
 
-		/*
-		 * 50% of the time act as if came in via a down staircase;
-		 * otherwise come in as if by word of recall/trap door/teleport
-		 * level.
-		 */
-		if (one_in_(2)) {
-			player->upkeep->create_up_stair = true;
-			player->upkeep->create_down_stair = false;
-			use_stairs = OPT(player, birth_connect_stairs);
-		} else {
-			use_stairs = false;
-		}
+	/* Allocate the distance array */
+	cave_dist = mem_zalloc(cave->height * sizeof(int*));
+	for (y = 0; y < cave->height; y++)
+		cave_dist[y] = mem_zalloc(cave->width * sizeof(int));
 
-		/* Make a new cave */
-		prepare_next_level(player);
+	/* Set all cave spots to inaccessible */
+	for (y = 0; y < cave->height; y++)
+		for (x = 1; x < cave->width; x++)
+			cave_dist[y][x] = -1;
 
-		/* Allocate the distance array */
-		cave_dist = mem_zalloc(cave->height * sizeof(int*));
-		for (y = 0; y < cave->height; y++)
-			cave_dist[y] = mem_zalloc(cave->width * sizeof(int));
+	/* Fill the distance array with the correct distances */
+	calc_cave_distances(cave_dist);
 
-		/* Set all cave spots to inaccessible */
-		for (y = 0; y < cave->height; y++)
-			for (x = 1; x < cave->width; x++)
-				cave_dist[y][x] = -1;
+	/* Cycle through the dungeon */
+	for (y = 1; y < cave->height - 1; y++) {
+		for (x = 1; x < cave->width - 1; x++) {
+			struct loc grid = loc(x, y);
 
-		/* Fill the distance array with the correct distances */
-		calc_cave_distances(cave_dist);
+			/*
+			 * Don't care about impassable terrain that's
+			 * not a closed or secret door or impassable
+			 * rubble.
+			 */
+			if (!square_ispassable(cave, grid) &&
+				!square_isdoor(cave, grid) &&
+				!square_isrubble(cave, grid)) continue;
 
-		/* Cycle through the dungeon */
-		for (y = 1; y < cave->height - 1; y++) {
-			for (x = 1; x < cave->width - 1; x++) {
-				struct loc grid = loc(x, y);
+			/* Can we get there? */
+			if (cave_dist[y][x] >= 0) {
 
-				/*
-				 * Don't care about impassable terrain that's
-				 * not a closed or secret door or impassable
-				 * rubble.
-				 */
-				if (!square_ispassable(cave, grid) &&
-					!square_isdoor(cave, grid) &&
-					!square_isrubble(cave, grid)) continue;
+				/* Is it a  down stairs? */
+				if (square_isdownstairs(cave, grid)) {
 
-				/* Can we get there? */
-				if (cave_dist[y][x] >= 0) {
+					has_dsc_from_stairs = false;
 
-					/* Is it a  down stairs? */
-					if (square_isdownstairs(cave, grid)) {
+					/* debug
+					msg("dist to stairs: %d",cave_dist[y][x]); */
+				}
+				continue;
+			}
 
-						has_dsc_from_stairs = false;
+			/* Ignore vaults as they are often disconnected */
+			if (square_isvault(cave, grid)) continue;
 
-						/* debug
-						msg("dist to stairs: %d",cave_dist[y][x]); */
-					}
-					continue;
-				}
+			/* We have a disconnected area */
+			has_dsc = true;
+		}
+	}
 
-				/* Ignore vaults as they are often disconnected */
-				if (square_isvault(cave, grid)) continue;
+	if ((use_stairs && !square_isupstairs(cave, player->grid))
+			|| (!use_stairs
+			&& !square_ispassable(cave, player->grid))) {
+		has_bad_start = true;
+		da->bad_starts++;
+		if (gs->level_type >= 0) {
+			++gs->badst_counts[gs->level_type];
+		}
+	} else {
+		has_bad_start = false;
+	}
 
-				/* We have a disconnected area */
-				has_dsc = true;
-			}
+	if (has_dsc_from_stairs) {
+		da->dsc_from_stairs++;
+		if (gs->level_type >= 0) {
+			++gs->disdstair_counts[gs->level_type];
 		}
+	}
 
-		if ((use_stairs && !square_isupstairs(cave, player->grid))
-				|| (!use_stairs
-				&& !square_ispassable(cave, player->grid))) {
-			has_bad_start = true;
-			bad_starts++;
-			if (gs.level_type >= 0) {
-				++gs.badst_counts[gs.level_type];
-			}
-		} else {
-			has_bad_start = false;
+	if (has_dsc) {
+		da->dsc_area++;
+		if (gs->level_type >= 0) {
+			++gs->disarea_counts[gs->level_type];
 		}
+	}
 
-		if (has_dsc_from_stairs) {
-			dsc_from_stairs++;
-			if (gs.level_type >= 0) {
-				++gs.disdstair_counts[gs.level_type];
+	if ((has_bad_start || has_dsc || has_dsc_from_stairs) && da->disfile) {
+		char label[100] = "Level with";
+
+		if (has_bad_start) {
+			(void) my_strcat(label,
+				" Bad Player Start",
+				sizeof(label));
+			if (has_dsc || has_dsc_from_stairs) {
+				my_strcat(label,
+					(has_dsc && has_dsc_from_stairs) ?
+					"," : " and",
+					sizeof(label));
 			}
 		}
-
 		if (has_dsc) {
-			dsc_area++;
-			if (gs.level_type >= 0) {
-				++gs.disarea_counts[gs.level_type];
+			(void) my_strcat(label,
+				" Disconnected Non-Vault",
+				sizeof(label));
+			if (has_dsc_from_stairs) {
+				my_strcat(label,
+					(has_bad_start) ?
+					", and" : " and",
+					sizeof(label));
 			}
 		}
+		if (has_dsc_from_stairs) {
+			(void) my_strcat(label,
+				" All Downstairs Inaccessible",
+				sizeof(label));
+		}
+		dump_level_body(da->disfile, label, cave,
+			cave_dist);
+	}
 
-		if (has_bad_start || has_dsc || has_dsc_from_stairs) {
-			if (disfile) {
-				char label[100] = "Level with";
+	/* Free arrays */
+	for (y = 0; y < cave->height; y++)
+		mem_free(cave_dist[y]);
+	mem_free(cave_dist);
 
-				if (has_bad_start) {
-					(void) my_strcat(label,
-						" Bad Player Start",
-						sizeof(label));
-					if (has_dsc || has_dsc_from_stairs) {
-						my_strcat(label,
-							(has_dsc && has_dsc_from_stairs) ?
-							"," : " and",
-							sizeof(label));
-					}
-				}
-				if (has_dsc) {
-					(void) my_strcat(label,
-						" Disconnected Non-Vault",
-						sizeof(label));
-					if (has_dsc_from_stairs) {
-						my_strcat(label,
-							(has_bad_start) ?
-							", and" : " and",
-							sizeof(label));
-					}
-				}
-				if (has_dsc_from_stairs) {
-					(void) my_strcat(label,
-						" All Downstairs Inaccessible",
-						sizeof(label));
-				}
-				dump_level_body(disfile, label, cave,
-					cave_dist);
+	return has_bad_start || has_dsc || has_dsc_from_stairs;
+}
+
+static void disconnect_run(void *acc, int worker, int first, int count)
+{
+	struct disconnect_acc *da = acc;
+	int i;
+
+	/* Workers dump their levels to a part file for the parent to
+	 * collect */
+	if (worker >= 0 && da->disfile) {
+		char path[1024];
+
+		disconnect_part_path(path, sizeof(path), worker);
+		da->disfile = file_open(path, MODE_WRITE, FTYPE_TEXT);
+	}
+
+	for (i = 0; i < count; i++) {
+		if (disconnect_level(da) && da->stop_on_disconnect) break;
+	}
+
+	if (worker >= 0 && da->disfile) {
+		(void) file_close(da->disfile);
+		da->disfile = NULL;
+	}
+}
+
+static void *disconnect_new(const void *acc)
+{
+	struct disconnect_acc *da = mem_zalloc(sizeof(*da));
+
+	initialize_generation_stats(&da->gs);
+	return da;
+}
+
+static void disconnect_free(void *acc)
+{
+	struct disconnect_acc *da = acc;
+
+	cleanup_generation_stats(&da->gs);
+	mem_free(da);
+}
+
+static void disconnect_transfer(void *acc, struct stats_pipe *p)
+{
+	struct disconnect_acc *da = acc;
+
+	transfer_generation_stats(&da->gs, p);
+	stats_transfer(p, &da->bad_starts, sizeof(da->bad_starts));
+	stats_transfer(p, &da->dsc_area, sizeof(da->dsc_area));
+	stats_transfer(p, &da->dsc_from_stairs, sizeof(da->dsc_from_stairs));
+}
+
+static void disconnect_merge(void *acc, const void *from)
+{
+	struct disconnect_acc *da = acc;
+	const struct disconnect_acc *f = from;
+
+	merge_generation_stats(&da->gs, &f->gs);
+	da->bad_starts += f->bad_starts;
+	da->dsc_area += f->dsc_area;
+	da->dsc_from_stairs += f->dsc_from_stairs;
+}
+
+static const struct stats_collector disconnect_collector = {
+	disconnect_run,
+	disconnect_new,
+	disconnect_free,
+	disconnect_transfer,
+	disconnect_merge
+};
+
+/**
+ * Append the level dumps written by the workers, in worker order.
+ */
+static void collect_disconnect_parts(ang_file *disfile)
+{
+	int w;
+
+	for (w = 0; w < stats_workers; w++) {
+		char path[1024];
+		char buf[1024];
+		ang_file *part;
+
+		disconnect_part_path(path, sizeof(path), w);
+		if (!file_exists(path)) continue;
+		part = file_open(path, MODE_READ, FTYPE_TEXT);
+		if (part) {
+			int n;
+
+			while ((n = file_read(part, buf, sizeof(buf))) > 0) {
+				file_write(disfile, buf, n);
 			}
-			if (stop_on_disconnect) i = nsim;
+			(void) file_close(part);
 		}
+		file_delete(path);
+	}
+}
+
+/**
+ * Gather whether the dungeon has disconnects in it and whether the player
+ * is disconnected from the stairs
+ */
+void disconnect_stats(int nsim, bool stop_on_disconnect)
+{
+	char path[1024];
+	struct disconnect_acc da;
+	ang_file *gstfile;
+
+	memset(&da, 0, sizeof(da));
+	da.stop_on_disconnect = stop_on_disconnect;
 
-		/* Free arrays */
-		for (y = 0; y < cave->height; y++)
-			mem_free(cave_dist[y]);
-		mem_free(cave_dist);
+	path_build(path, sizeof(path), ANGBAND_DIR_USER, "disconnect.html");
+	da.disfile = file_open(path, MODE_WRITE, FTYPE_TEXT);
+	if (da.disfile) {
+		dump_level_header(da.disfile, "Disconnected Levels");
 	}
 
-	msg("Total levels with bad starts: %ld", bad_starts);
-	msg("Total levels with disconnected areas: %ld",dsc_area);
-	msg("Total levels isolated from stairs: %ld",dsc_from_stairs);
-	if (disfile) {
-		dump_level_footer(disfile);
-		if (file_close(disfile)) {
+	path_build(path, sizeof(path), ANGBAND_DIR_USER,
+		"disconnect_gstat.txt");
+	gstfile = file_open(path, MODE_WRITE, FTYPE_TEXT);
+
+	/*
+	 * Set up to collect some statistics about level types, room types,
+	 * and tunneling as well.
+	 */
+	initialize_generation_stats(&da.gs);
+	watch_generation_stats(&da.gs);
+
+	stats_run(&disconnect_collector, &da, nsim);
+
+	msg("Total levels with bad starts: %ld", da.bad_starts);
+	msg("Total levels with disconnected areas: %ld", da.dsc_area);
+	msg("Total levels isolated from stairs: %ld", da.dsc_from_stairs);
+	if (!generation_attempts_agree(&da.gs)) {
+		msg("Level attempt reports do not match the levels built!");
+	}
+	if (da.disfile) {
+		collect_disconnect_parts(da.disfile);
+		dump_level_footer(da.disfile);
+		if (file_close(da.disfile)) {
 			msg("Map is in disconnect.html.");
 		}
 	}
 	if (gstfile) {
-		dump_generation_stats(gstfile, &gs);
+		dump_generation_stats(gstfile, &da.gs);
 		if (file_close(gstfile)) {
 			msg("Level generation statistics are in disconnect_gstat.txt");
 		}
 	}
 
-	cleanup_generation_stats(&gs);
+	unwatch_generation_stats(&da.gs);
+	cleanup_generation_stats(&da.gs);
 
 	/* Redraw the level */
 	do_cmd_redraw();
@@ -3082,6 +3880,10 @@ bool stats_are_enabled(void)
 	return false;
 }
 
+void stats_set_workers(int n)
+{
+}
+
 void stats_collect(int nsim, int simtype)
 {
 }
@@ -69,6 +69,7 @@ void wiz_cheat_death(void);
 
 /* wiz-stats.c */
 bool stats_are_enabled(void);
+void stats_set_workers(int n);
 void stats_collect(int nsim, int simtype);
 void disconnect_stats(int nsim, bool stop_on_disconnect);
 void pit_stats(int nsim, int pittype, int depth_min, int depth_max);
@@ -278,11 +278,15 @@ int dice_bind_expression(dice_t *dice, const char *name,
 			continue;
 
 		if (my_stricmp(name, dice->expressions[i].name) == 0) {
-			dice->expressions[i].expression = expression_copy(expression);
+			expression_t *copy = expression_copy(expression);
 
-			if (dice->expressions[i].expression == NULL)
+			if (copy == NULL)
 				return -1;
 
+			/* Bound expressions are only ever evaluated from now on */
+			expression_compile(copy);
+			dice->expressions[i].expression = copy;
+
 			return i;
 		}
 	}
@@ -25,11 +25,27 @@ struct expression_operation_s {
 	int16_t operand;
 };
 
+/**
+ * One step of a compiled expression.  Operands are wider than in the parsed
+ * form since compiling combines them.
+ */
+typedef struct expression_step_s {
+	uint8_t operator;
+	int32_t operand;
+} expression_step_t;
+
 struct expression_s {
 	expression_base_value_f base_value;
 	size_t operation_count;
 	size_t operations_size;
 	expression_operation_t *operations;
+
+	/* Compiled form of the operations; see expression_compile() */
+	bool compiled;
+	bool constant;
+	int32_t value;
+	size_t step_count;
+	expression_step_t *steps;
 };
 
 /**
@@ -171,6 +187,7 @@ void expression_free(expression_t *expression)
 		expression->operations = NULL;
 	}
 
+	mem_free(expression->steps);
 	mem_free(expression);
 }
 
@@ -217,6 +234,128 @@ void expression_set_base_value(expression_t *expression,
 							   expression_base_value_f function)
 {
 	expression->base_value = function;
+	expression->compiled = false;
+}
+
+/**
+ * Return true if a compiled step leaves the value unchanged.
+ */
+static bool expression_step_is_identity(const expression_step_t *step)
+{
+	switch (step->operator) {
+		case OPERATOR_ADD:
+			return step->operand == 0;
+		case OPERATOR_MUL:
+		case OPERATOR_DIV:
+			return step->operand == 1;
+		default:
+			return false;
+	}
+}
+
+/**
+ * Run compiled steps on a value.
+ */
+static int32_t expression_run_steps(const expression_t *expression,
+									int32_t value)
+{
+	size_t i;
+
+	for (i = 0; i < expression->step_count; i++) {
+		const expression_step_t *step = &expression->steps[i];
+
+		switch (step->operator) {
+			case OPERATOR_ADD:
+				value += step->operand;
+				break;
+			case OPERATOR_MUL:
+				value *= step->operand;
+				break;
+			case OPERATOR_DIV:
+				value /= step->operand;
+				break;
+			default:
+				break;
+		}
+	}
+
+	return value;
+}
+
+/**
+ * Compile the operations of an expression into a shorter list of steps
+ * which give the same result.
+ *
+ * Subtraction becomes addition and negation becomes multiplication by -1,
+ * then runs of additions and of multiplications are each folded into one
+ * step, as are runs of divisions by positive numbers.  Steps which do
+ * nothing are dropped.  An expression with no base value function is
+ * evaluated once here and is a constant from then on.  Adding operations or
+ * changing the base value function undoes the compilation.
+ */
+void expression_compile(expression_t *expression)
+{
+	size_t i, n = 0;
+
+	mem_free(expression->steps);
+	expression->steps = mem_zalloc(MAX(expression->operation_count, 1) *
+								   sizeof(expression_step_t));
+
+	for (i = 0; i < expression->operation_count; i++) {
+		expression_step_t step, *last = n ? &expression->steps[n - 1] : NULL;
+
+		step.operator = expression->operations[i].operator;
+		step.operand = expression->operations[i].operand;
+		switch (step.operator) {
+			case OPERATOR_SUB:
+				step.operator = OPERATOR_ADD;
+				step.operand = -step.operand;
+				break;
+			case OPERATOR_NEG:
+				step.operator = OPERATOR_MUL;
+				step.operand = -1;
+				break;
+			case OPERATOR_ADD:
+			case OPERATOR_MUL:
+			case OPERATOR_DIV:
+				break;
+			default:
+				continue;
+		}
+
+		if (last && last->operator == step.operator) {
+			bool folded = true;
+
+			if (step.operator == OPERATOR_ADD) {
+				last->operand += step.operand;
+			} else if (step.operator == OPERATOR_MUL) {
+				/* Wraps exactly as the separate multiplications would */
+				last->operand = (int32_t)((uint32_t)last->operand *
+										  (uint32_t)step.operand);
+			} else if (last->operand > 0 && step.operand > 0 &&
+					   last->operand <= INT32_MAX / step.operand) {
+				/* (v / a) / b == v / (a * b) for positive a and b */
+				last->operand *= step.operand;
+			} else {
+				folded = false;
+			}
+
+			if (folded) {
+				if (expression_step_is_identity(last))
+					n--;
+				continue;
+			}
+		}
+
+		if (!expression_step_is_identity(&step))
+			expression->steps[n++] = step;
+	}
+
+	expression->step_count = n;
+	expression->constant = (expression->base_value == NULL);
+	expression->value = expression->constant ?
+		expression_run_steps(expression, 0) : 0;
+	expression->compiled = true;
 }
 
 /**
@@ -228,6 +367,12 @@ int32_t expression_evaluate(expression_t const * const expression)
 	size_t i;
 	int32_t value = 0;
 
+	if (expression->compiled) {
+		if (expression->constant)
+			return expression->value;
+		return expression_run_steps(expression, expression->base_value());
+	}
+
 	if (expression->base_value != NULL)
 		value = expression->base_value();
 
@@ -269,6 +414,7 @@ static void expression_add_operation(expression_t *expression,
 
 	expression->operations[expression->operation_count] = operation;
 	expression->operation_count++;
+	expression->compiled = false;
 }
 
 /**
@@ -39,6 +39,7 @@ void expression_free(expression_t *expression);
 expression_t *expression_copy(const expression_t *source);
 void expression_set_base_value(expression_t *expression,
 							   expression_base_value_f function);
+void expression_compile(expression_t *expression);
 int32_t expression_evaluate(expression_t const * const expression);
 int16_t expression_add_operations_string(expression_t *expression,
 									  const char *string);
@@ -18,6 +18,12 @@
 #include "z-virt.h"
 #include "z-util.h"
 
+/**
+ * Called with the requested size on every mem_alloc() and mem_realloc();
+ * the unit test benchmarks use it to count allocations.
+ */
+void (*mem_alloc_hook)(size_t len) = NULL;
+
 /**
  * Allocate `len` bytes of memory.
  *
@@ -35,6 +41,9 @@ void *mem_alloc(size_t len)
 	if (!len)
 		return NULL;
 
+	if (mem_alloc_hook)
+		mem_alloc_hook(len);
+
 	void *p = malloc(len);
 	if (!p)
 		quit("Out of memory!");
@@ -61,6 +70,9 @@ void *mem_realloc(void *p, size_t len)
 	if (!len)
 		return NULL;
 
+	if (mem_alloc_hook)
+		mem_alloc_hook(len);
+
 	p = realloc(p, len);
 	if (!p)
 		quit("Out of Memory!");
@@ -22,6 +22,7 @@ void *mem_alloc(size_t len);
 void *mem_zalloc(size_t len);
 void mem_free(void *p);
 void *mem_realloc(void *p, size_t len);
+extern void (*mem_alloc_hook)(size_t len);
 
 /**
  * On NDS, we might need to allocate some data into external memory